@@ -91,11 +91,13 @@ namespace BRQ {
             m_CameraController.Reset();
         }
 
+        OnClientUpdate(dt);
+
         if (!m_Minimized) {
 
             m_Renderer->BeginScene(m_CameraController.GetCamera());
 
-            // draw here
+            OnClientRender();
 
             m_Renderer->EndScene();
 
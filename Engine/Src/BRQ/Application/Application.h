@@ -38,6 +38,11 @@ namespace BRQ {
 
         Application* GetApplication() { return s_Application; }
 
+    protected:
+        // Called once per frame before rendering, and between BeginScene and EndScene.
+        virtual void OnClientUpdate(F32 dt) { }
+        virtual void OnClientRender() { }
+
     private:
         bool OnWindowResize(WindowResizeEvent& event);
     };
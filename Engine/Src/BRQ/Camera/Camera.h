@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Math/Math.h"
+#include "Math/Frustum.h"
 #include "Utilities/Types.h"
 
 namespace BRQ {
@@ -37,6 +38,11 @@ namespace BRQ {
         const glm::mat4& GetViewMatrix() const { return m_ViewMatrix; }
         const glm::mat4& GetProjectionMatrix() const { return m_ProjectionMatrix; }
 
+        Frustum GetFrustum() const { return Frustum(m_ProjectionMatrix * m_ViewMatrix); }
+
+        const glm::vec3& GetPosition() const { return m_Position; }
+        const glm::vec3& GetFront() const { return m_Front; }
+
     private:
         void CalculateVectors();
     };
@@ -43,18 +43,26 @@ namespace BRQ {
 
         if (input->IsKeyPressed(Key::KEY_LSHIFT))
             velocity = m_Camera.m_Speed * dt * 6.0f;
+
+        glm::vec3 displacement(0.0f);
+
         if (input->IsKeyPressed(Key::KEY_W))
-            m_Camera.m_Position += m_Camera.m_Front * velocity;
+            displacement += m_Camera.m_Front * velocity;
         if (input->IsKeyPressed(Key::KEY_S))
-            m_Camera.m_Position -= m_Camera.m_Front * velocity;
+            displacement -= m_Camera.m_Front * velocity;
         if (input->IsKeyPressed(Key::KEY_A))
-            m_Camera.m_Position -= m_Camera.m_Right * velocity;
+            displacement -= m_Camera.m_Right * velocity;
         if (input->IsKeyPressed(Key::KEY_D))
-            m_Camera.m_Position += m_Camera.m_Right * velocity;
+            displacement += m_Camera.m_Right * velocity;
         if (input->IsKeyPressed(Key::KEY_SPACE))
-            m_Camera.m_Position += m_Camera.m_Up * velocity;
+            displacement += m_Camera.m_Up * velocity;
         if (input->IsKeyPressed(Key::KEY_LCONTROL))
-            m_Camera.m_Position -= m_Camera.m_Up * velocity;
+            displacement -= m_Camera.m_Up * velocity;
+
+        if (m_MovementResolver)
+            m_Camera.m_Position = m_MovementResolver(m_Camera.m_Position, displacement);
+        else
+            m_Camera.m_Position += displacement;
 
         if (m_CaptureCamera) {
 
@@ -7,6 +7,10 @@ namespace BRQ {
 
     class CameraController {
 
+    public:
+        // Takes the camera position and the displacement input asks for, returns where the camera ends up.
+        using MovementResolverFunction = std::function<glm::vec3(const glm::vec3& position, const glm::vec3& displacement)>;
+
     private:
         F32    m_Fov;
         F32    m_AspectRatio;
@@ -17,6 +21,8 @@ namespace BRQ {
         Camera m_Camera;
         bool   m_CaptureCamera;
 
+        MovementResolverFunction m_MovementResolver;
+
     public:
         CameraController() = default;
         CameraController(U32 width, U32 height, F32 fov, bool captureCamera = true);
@@ -27,6 +33,9 @@ namespace BRQ {
 
         void CaptureCamera(bool capture);
 
+        // Lets the client restrict camera movement, e.g. to collide with the world. Without one the camera flies freely.
+        void SetMovementResolver(const MovementResolverFunction& resolver) { m_MovementResolver = resolver; }
+
         void Reset();
 
         const Camera& GetCamera() const { return m_Camera; }
@@ -21,10 +21,79 @@ namespace BRQ {
         case ElementType::Vec2:   return VK_FORMAT_R32G32_SFLOAT;
         case ElementType::Vec3:   return VK_FORMAT_R32G32B32_SFLOAT;
         case ElementType::Vec4:   return VK_FORMAT_R32G32B32A32_SFLOAT;
+
+        case ElementType::IVec2:  return VK_FORMAT_R32G32_SINT;
+        case ElementType::IVec3:  return VK_FORMAT_R32G32B32_SINT;
+        case ElementType::IVec4:  return VK_FORMAT_R32G32B32A32_SINT;
+        case ElementType::UVec2:  return VK_FORMAT_R32G32_UINT;
+        case ElementType::UVec3:  return VK_FORMAT_R32G32B32_UINT;
+        case ElementType::UVec4:  return VK_FORMAT_R32G32B32A32_UINT;
+
+        case ElementType::Byte4:              return VK_FORMAT_R8G8B8A8_SINT;
+        case ElementType::UByte4:             return VK_FORMAT_R8G8B8A8_UINT;
+        case ElementType::Short2:             return VK_FORMAT_R16G16_SINT;
+        case ElementType::UShort2:            return VK_FORMAT_R16G16_UINT;
+        case ElementType::Short4:             return VK_FORMAT_R16G16B16A16_SINT;
+        case ElementType::UShort4:            return VK_FORMAT_R16G16B16A16_UINT;
+        case ElementType::UInt2_10_10_10:     return VK_FORMAT_A2B10G10R10_UINT_PACK32;
+
+        case ElementType::Byte4Norm:          return VK_FORMAT_R8G8B8A8_SNORM;
+        case ElementType::UByte4Norm:         return VK_FORMAT_R8G8B8A8_UNORM;
+        case ElementType::Short2Norm:         return VK_FORMAT_R16G16_SNORM;
+        case ElementType::UShort2Norm:        return VK_FORMAT_R16G16_UNORM;
+        case ElementType::Short4Norm:         return VK_FORMAT_R16G16B16A16_SNORM;
+        case ElementType::UShort4Norm:        return VK_FORMAT_R16G16B16A16_UNORM;
+        case ElementType::Int2_10_10_10Norm:  return VK_FORMAT_A2B10G10R10_SNORM_PACK32;
+        case ElementType::UInt2_10_10_10Norm: return VK_FORMAT_A2B10G10R10_UNORM_PACK32;
         }
         return VK_FORMAT_UNDEFINED;
     }
 
+    U32 GetElementTypeSize(ElementType type) {
+
+        switch (type) {
+
+        case ElementType::Byte:   return 1;
+        case ElementType::UByte:  return 1;
+        case ElementType::Short:  return 2;
+        case ElementType::UShort: return 2;
+        case ElementType::Int:    return 4;
+        case ElementType::UInt:   return 4;
+        case ElementType::Long:   return 8;
+        case ElementType::ULong:  return 8;
+        case ElementType::Float:  return 4;
+        case ElementType::Double: return 8;
+        case ElementType::Vec2:   return 8;
+        case ElementType::Vec3:   return 12;
+        case ElementType::Vec4:   return 16;
+
+        case ElementType::IVec2:  return 8;
+        case ElementType::IVec3:  return 12;
+        case ElementType::IVec4:  return 16;
+        case ElementType::UVec2:  return 8;
+        case ElementType::UVec3:  return 12;
+        case ElementType::UVec4:  return 16;
+
+        case ElementType::Byte4:              return 4;
+        case ElementType::UByte4:             return 4;
+        case ElementType::Short2:             return 4;
+        case ElementType::UShort2:            return 4;
+        case ElementType::Short4:             return 8;
+        case ElementType::UShort4:            return 8;
+        case ElementType::UInt2_10_10_10:     return 4;
+
+        case ElementType::Byte4Norm:          return 4;
+        case ElementType::UByte4Norm:         return 4;
+        case ElementType::Short2Norm:         return 4;
+        case ElementType::UShort2Norm:        return 4;
+        case ElementType::Short4Norm:         return 8;
+        case ElementType::UShort4Norm:        return 8;
+        case ElementType::Int2_10_10_10Norm:  return 4;
+        case ElementType::UInt2_10_10_10Norm: return 4;
+        }
+        return 0;
+    }
+
     BufferLayout::BufferLayout() {
 
         m_Stride = 0;
@@ -21,9 +21,36 @@ namespace BRQ {
         Vec2,
         Vec3,
         Vec4,
+
+        IVec2,
+        IVec3,
+        IVec4,
+        UVec2,
+        UVec3,
+        UVec4,
+
+        // Packed integer formats, read as ivec4/uvec4 in the shader.
+        Byte4,
+        UByte4,
+        Short2,
+        UShort2,
+        Short4,
+        UShort4,
+        UInt2_10_10_10,
+
+        // Normalized formats, read as vec4/vec2 in the shader.
+        Byte4Norm,
+        UByte4Norm,
+        Short2Norm,
+        UShort2Norm,
+        Short4Norm,
+        UShort4Norm,
+        Int2_10_10_10Norm,
+        UInt2_10_10_10Norm,
     };
 
     VkFormat ToVulkanFormat(ElementType type);
+    U32 GetElementTypeSize(ElementType type);
 
     struct BufferElement {
 
@@ -43,6 +70,7 @@ namespace BRQ {
         ~BufferLayout() = default;
 
         void PushElement(ElementType type, U32 size);
+        void PushElement(ElementType type) { PushElement(type, GetElementTypeSize(type)); }
 
         const std::vector<BufferElement>& GetElements() const { return m_Elements; };
         U64 GetStride() const { return m_Stride; }
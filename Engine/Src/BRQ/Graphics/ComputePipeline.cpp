@@ -0,0 +1,191 @@
+#include <BRQ.h>
+
+#include "ComputePipeline.h"
+#include <spirv_reflect.h>
+
+#include "Platform/Vulkan/RenderContext.h"
+
+namespace BRQ {
+
+    ComputePipeline::ComputePipeline() {
+
+        m_Layout = VK_NULL_HANDLE;
+        m_Pipeline = VK_NULL_HANDLE;
+    }
+
+    void ComputePipeline::Init(const ComputePipelineCreateInfo& info) {
+
+        using namespace Utilities;
+
+        RenderContext* context = RenderContext::GetInstance();
+
+        const std::string& filename = info.Shader.ShaderFilename;
+
+        if (filename.find(".spv") == std::string::npos) {
+
+            BRQ_CORE_ERROR("Invalid shader file extension(Only SPIRV shaders are valid)! File: {}", filename.data());
+            return;
+        }
+
+        std::vector<BYTE> code = FileSystem::GetInstance()->ReadFile(filename, FileSystem::InputMode::ReadBinary);
+
+        if (code.empty()) {
+
+            BRQ_CORE_ERROR("Empty Shader Code (Reason: Can't Read File) File: {}", filename.data());
+            return;
+        }
+
+        std::vector<VkPushConstantRange> ranges;
+
+        if (!Reflect(code, ranges))
+            return;
+
+        VK::PipelineLayoutCreateInfo layoutInfo = {};
+        layoutInfo.SetLayouts = m_DescriptorSetLayouts;
+        layoutInfo.PushConstantRanges = ranges;
+
+        m_Layout = VK::CreatePipelineLayout(context->GetDevice(), layoutInfo);
+
+        VkPipelineShaderStageCreateInfo stageInfo = {};
+        stageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        stageInfo.module = CreateShader(code);
+        stageInfo.pName = "main";
+
+        VK::ComputePipelineCreateInfo pipelineInfo = {};
+        pipelineInfo.Stage = stageInfo;
+        pipelineInfo.Layout = m_Layout;
+
+        m_Pipeline = VK::CreateComputePipeline(context->GetDevice(), pipelineInfo);
+
+        DestroyShader(stageInfo.module);
+    }
+
+    void ComputePipeline::Destroy() {
+
+        RenderContext* context = RenderContext::GetInstance();
+
+        for (U64 i = 0; i < m_DescriptorSetLayouts.size(); i++) {
+
+            VK::DestoryDescriptorSetLayout(context->GetDevice(), m_DescriptorSetLayouts[i]);
+        }
+
+        m_DescriptorSetLayouts.clear();
+
+        VK::DestroyPipelineLayout(context->GetDevice(), m_Layout);
+        VK::DestroyComputePipeline(context->GetDevice(), m_Pipeline);
+    }
+
+    void ComputePipeline::Bind(const VkCommandBuffer& commandBuffer) {
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_Pipeline);
+    }
+
+    void ComputePipeline::BindDescriptorSets(const VkCommandBuffer& commandBuffer, const VkDescriptorSet* sets, U32 size) {
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_Layout, 0, size, sets, 0, nullptr);
+    }
+
+    void ComputePipeline::PushConstantData(const VkCommandBuffer& commandBuffer, const void* data, U32 size, U32 offset) {
+
+        vkCmdPushConstants(commandBuffer, m_Layout, VK_SHADER_STAGE_COMPUTE_BIT, offset, size, data);
+    }
+
+    bool ComputePipeline::Reflect(const std::vector<BYTE>& code, std::vector<VkPushConstantRange>& ranges) {
+
+        RenderContext* context = RenderContext::GetInstance();
+
+        SpvReflectShaderModule reflectModule;
+        SpvReflectResult result = spvReflectCreateShaderModule(code.size(), code.data(), &reflectModule);
+
+        if (result != SPV_REFLECT_RESULT_SUCCESS) {
+
+            BRQ_CORE_FATAL("Failed to create reflection for shader");
+            return false;
+        }
+
+        U32 setCount = 0;
+        spvReflectEnumerateDescriptorSets(&reflectModule, &setCount, nullptr);
+
+        std::vector<SpvReflectDescriptorSet*> sets(setCount);
+        result = spvReflectEnumerateDescriptorSets(&reflectModule, &setCount, sets.data());
+
+        if (result != SPV_REFLECT_RESULT_SUCCESS) {
+
+            BRQ_CORE_FATAL("Failed to Enumerate DescriptorSets for shader");
+            spvReflectDestroyShaderModule(&reflectModule);
+            return false;
+        }
+
+        // Sets come sorted by set number, the layouts line up with the sets bound from 0.
+        for (const SpvReflectDescriptorSet* set : sets) {
+
+            std::vector<VkDescriptorSetLayoutBinding> bindings(set->binding_count);
+
+            for (U32 i = 0; i < set->binding_count; i++) {
+
+                const SpvReflectDescriptorBinding& refBinding = *set->bindings[i];
+
+                bindings[i].binding = refBinding.binding;
+                bindings[i].descriptorType = (VkDescriptorType)refBinding.descriptor_type;
+                bindings[i].descriptorCount = 1;
+                bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+                for (U32 j = 0; j < refBinding.array.dims_count; j++)
+                    bindings[i].descriptorCount *= refBinding.array.dims[j];
+            }
+
+            VK::DescriptorSetLayoutCreateInfo layoutInfo = {};
+            layoutInfo.BindingCount = (U32)bindings.size();
+            layoutInfo.Bindings = bindings.data();
+
+            m_DescriptorSetLayouts.push_back(VK::CreateDescriptorSetLayout(context->GetDevice(), layoutInfo));
+        }
+
+        U32 blockCount = 0;
+        spvReflectEnumeratePushConstantBlocks(&reflectModule, &blockCount, nullptr);
+
+        std::vector<SpvReflectBlockVariable*> blocks(blockCount);
+        result = spvReflectEnumeratePushConstantBlocks(&reflectModule, &blockCount, blocks.data());
+
+        if (result != SPV_REFLECT_RESULT_SUCCESS) {
+
+            BRQ_CORE_FATAL("Failed to Enumerate Push Constants for shader");
+            spvReflectDestroyShaderModule(&reflectModule);
+            return false;
+        }
+
+        for (const SpvReflectBlockVariable* block : blocks)
+            ranges.push_back({ VK_SHADER_STAGE_COMPUTE_BIT, block->offset, block->size });
+
+        spvReflectDestroyShaderModule(&reflectModule);
+
+        return true;
+    }
+
+    VkShaderModule ComputePipeline::CreateShader(const std::vector<BYTE>& code) {
+
+        RenderContext* context = RenderContext::GetInstance();
+
+        VkShaderModule shader = VK_NULL_HANDLE;
+
+        VkShaderModuleCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        info.codeSize = code.size();
+        info.pCode = (U32*)code.data();
+        VK_CHECK(vkCreateShaderModule(context->GetDevice(), &info, nullptr, &shader));
+
+        return shader;
+    }
+
+    void ComputePipeline::DestroyShader(VkShaderModule& shader) {
+
+        RenderContext* context = RenderContext::GetInstance();
+
+        if (shader != VK_NULL_HANDLE) {
+
+            vkDestroyShaderModule(context->GetDevice(), shader, nullptr);
+            shader = VK_NULL_HANDLE;
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Platform/Vulkan/VulkanHelpers.h"
+#include "GraphicsPipeline.h"
+
+namespace BRQ {
+
+    struct ComputePipelineCreateInfo {
+
+        ShaderStage Shader;
+    };
+
+    // A single compute shader with descriptor set layouts and push constant ranges reflected from its SPIR-V,
+    // the same way GraphicsPipeline builds them.
+    class ComputePipeline {
+
+    private:
+        VkPipelineLayout                   m_Layout;
+        VkPipeline                         m_Pipeline;
+        std::vector<VkDescriptorSetLayout> m_DescriptorSetLayouts;
+
+    public:
+        ComputePipeline();
+        ~ComputePipeline() = default;
+
+        void Init(const ComputePipelineCreateInfo& info);
+        void Destroy();
+
+        void Bind(const VkCommandBuffer& commandBuffer);
+        void BindDescriptorSets(const VkCommandBuffer& commandBuffer, const VkDescriptorSet* sets, U32 size);
+        const std::vector<VkDescriptorSetLayout>& GetDescriptorSetLayouts() const { return m_DescriptorSetLayouts; }
+        void PushConstantData(const VkCommandBuffer& commandBuffer, const void* data, U32 size, U32 offset);
+
+    private:
+        bool Reflect(const std::vector<BYTE>& code, std::vector<VkPushConstantRange>& ranges);
+
+        VkShaderModule CreateShader(const std::vector<BYTE>& code);
+        void DestroyShader(VkShaderModule& shader);
+    };
+}
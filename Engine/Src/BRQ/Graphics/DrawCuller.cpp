@@ -0,0 +1,256 @@
+#include <BRQ.h>
+
+#include "DrawCuller.h"
+
+#include "Platform/Vulkan/RenderContext.h"
+#include "Platform/Vulkan/VulkanCommands.h"
+
+namespace BRQ {
+
+    // Matches local_size_x of cull.comp.
+    static const U32 s_GroupSize = 64;
+
+    DrawCuller::DrawCuller()
+        : m_Frames(), m_Compact(false) { }
+
+    void DrawCuller::Init(bool compact) {
+
+        m_Compact = compact;
+
+        ComputePipelineCreateInfo pipelineInfo = {};
+        pipelineInfo.Shader = { "Resources/Shaders/cull.comp.spv" };
+
+        m_Pipeline.Init(pipelineInfo);
+
+        RenderContext* context = RenderContext::GetInstance();
+        VkDevice device = context->GetDevice();
+
+        VkDescriptorPoolSize size = {};
+        size.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        size.descriptorCount = 3;
+
+        VK::DescriptorPoolCreateInfo poolInfo = {};
+        poolInfo.MaxSets = 1;
+        poolInfo.PoolSizeCount = 1;
+        poolInfo.PoolSizes = &size;
+
+        for (Frame& frame : m_Frames) {
+
+            frame.DescriptorPool = VK::CreateDescriptorPool(device, poolInfo);
+
+            VK::DescriptorSetAllocateInfo setInfo = {};
+            setInfo.DescriptorPool = frame.DescriptorPool;
+            setInfo.DescriptorSetCount = 1;
+            setInfo.SetLayouts = m_Pipeline.GetDescriptorSetLayouts().data();
+
+            frame.DescriptorSet = VK::AllocateDescriptorSets(device, setInfo)[0];
+
+            // Recorded on the compute family, which is the graphics family when the device has no other.
+            VK::CommandPoolCreateInfo commandPoolInfo = {};
+            commandPoolInfo.Flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            commandPoolInfo.QueueFamilyIndex = context->GetComputeQueueIndex();
+
+            frame.CommandPool = VK::CreateCommandPool(device, commandPoolInfo);
+
+            VK::CommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.CommandPool = frame.CommandPool;
+            allocateInfo.Level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.CommandBufferCount = 1;
+
+            frame.CommandBuffer = VK::AllocateCommandBuffers(device, allocateInfo)[0];
+            frame.FinishedSemaphore = VK::CreateSemaphore(device);
+
+            VK::BufferCreateInfo readbackInfo = {};
+            readbackInfo.Size = sizeof(U32);
+            readbackInfo.Flags = 0;
+            readbackInfo.Usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            readbackInfo.SharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            readbackInfo.MemoryFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+            readbackInfo.MemoryUsage = VMA_MEMORY_USAGE_GPU_TO_CPU;
+
+            frame.Readback = VK::CreateBuffer(readbackInfo);
+            frame.MappedReadback = (U32*)VulkanMemoryAllocator::GetInstance()->GetAllocationInfo(frame.Readback).pMappedData;
+            *frame.MappedReadback = 0;
+
+            // Grows on demand like the draw buffers.
+            CreateBuffers(frame, 4096);
+        }
+    }
+
+    void DrawCuller::Destroy() {
+
+        VkDevice device = RenderContext::GetInstance()->GetDevice();
+
+        for (Frame& frame : m_Frames) {
+
+            DestroyBuffers(frame);
+
+            VK::DestoryBuffer(frame.Readback);
+            VK::DestroySemaphore(device, frame.FinishedSemaphore);
+
+#if defined(BRQ_DEBUG)
+            VK::FreeCommandBuffer(device, frame.CommandPool, frame.CommandBuffer);
+#endif
+            VK::DestroyCommandPool(device, frame.CommandPool);
+            VK::DestoryDescriptorPool(device, frame.DescriptorPool);
+        }
+
+        m_Pipeline.Destroy();
+    }
+
+    void DrawCuller::Cull(U32 frameIndex, const IndirectDrawBuffer& draws, const DrawBounds* bounds, const Frustum& frustum) {
+
+        Frame& frame = m_Frames[frameIndex];
+        U32 drawCount = draws.GetCount();
+
+        if (drawCount > frame.Capacity) {
+
+            U32 capacity = frame.Capacity;
+
+            while (capacity < drawCount)
+                capacity *= 2;
+
+            DestroyBuffers(frame);
+            CreateBuffers(frame, capacity);
+        }
+
+        memcpy(frame.MappedBounds, bounds, drawCount * sizeof(DrawBounds));
+        VulkanMemoryAllocator::GetInstance()->FlushMemory(frame.Bounds, 0, drawCount * sizeof(DrawBounds));
+
+        // The draw buffers may have grown since the last cull, the set is rewritten every time.
+        UpdateDescriptorSet(frame, draws);
+        RecordCommands(frame, drawCount, frustum);
+
+        RenderContext* context = RenderContext::GetInstance();
+
+        VK::QueueSubmitInfo submitInfo = {};
+        submitInfo.CommandBufferCount = 1;
+        submitInfo.CommandBuffers = &frame.CommandBuffer;
+        submitInfo.SignalSemaphoreCount = 1;
+        submitInfo.SignalSemaphores = &frame.FinishedSemaphore;
+        submitInfo.Queue = context->GetComputeQueue();
+
+        VK::QueueSubmit(submitInfo);
+    }
+
+    U32 DrawCuller::GetVisibleCount(U32 frameIndex) const {
+
+        const Frame& frame = m_Frames[frameIndex];
+
+        VulkanMemoryAllocator::GetInstance()->InvalidateMemory(frame.Readback, 0, sizeof(U32));
+
+        return *frame.MappedReadback;
+    }
+
+    void DrawCuller::CreateBuffers(Frame& frame, U32 capacity) {
+
+        frame.Capacity = std::max(capacity, 1u);
+
+        VK::BufferCreateInfo boundsInfo = {};
+        boundsInfo.Size = frame.Capacity * sizeof(DrawBounds);
+        boundsInfo.Flags = 0;
+        boundsInfo.Usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        boundsInfo.SharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        boundsInfo.MemoryFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        boundsInfo.MemoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+
+        frame.Bounds = VK::CreateBuffer(boundsInfo);
+        frame.MappedBounds = (BYTE*)VulkanMemoryAllocator::GetInstance()->GetAllocationInfo(frame.Bounds).pMappedData;
+
+        // Written on the compute queue, read as indirect draws on the graphics queue.
+        std::vector<U32> families = RenderContext::GetInstance()->GetGraphicsAndComputeQueueIndices();
+
+        VK::BufferCreateInfo outputInfo = {};
+        outputInfo.Size = IndirectDrawBuffer::GetCommandsOffset() + frame.Capacity * sizeof(VkDrawIndexedIndirectCommand);
+        outputInfo.Flags = 0;
+        outputInfo.Usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        outputInfo.SharingMode = families.size() > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+        outputInfo.QueueFamilyIndices = families;
+        outputInfo.MemoryUsage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+        frame.Output = VK::CreateBuffer(outputInfo);
+    }
+
+    void DrawCuller::DestroyBuffers(Frame& frame) {
+
+        if (frame.Bounds.Buffer)
+            VK::DestoryBuffer(frame.Bounds);
+
+        if (frame.Output.Buffer)
+            VK::DestoryBuffer(frame.Output);
+
+        frame.MappedBounds = nullptr;
+        frame.Capacity = 0;
+    }
+
+    void DrawCuller::UpdateDescriptorSet(Frame& frame, const IndirectDrawBuffer& draws) {
+
+        VkDescriptorBufferInfo bufferInfos[3] = {};
+        bufferInfos[0].buffer = draws.GetCommandBuffer().Buffer;
+        bufferInfos[0].range = draws.GetCommandBufferSize();
+        bufferInfos[1].buffer = frame.Bounds.Buffer;
+        bufferInfos[1].range = VK_WHOLE_SIZE;
+        bufferInfos[2].buffer = frame.Output.Buffer;
+        bufferInfos[2].range = VK_WHOLE_SIZE;
+
+        VkWriteDescriptorSet descriptorWrites[3] = {};
+
+        for (U32 i = 0; i < 3; i++) {
+
+            descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[i].dstSet = frame.DescriptorSet;
+            descriptorWrites[i].dstBinding = i;
+            descriptorWrites[i].dstArrayElement = 0;
+            descriptorWrites[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            descriptorWrites[i].descriptorCount = 1;
+            descriptorWrites[i].pBufferInfo = &bufferInfos[i];
+        }
+
+        vkUpdateDescriptorSets(RenderContext::GetInstance()->GetDevice(), 3, descriptorWrites, 0, nullptr);
+    }
+
+    void DrawCuller::RecordCommands(Frame& frame, U32 drawCount, const Frustum& frustum) {
+
+        VK::ResetCommandPool(RenderContext::GetInstance()->GetDevice(), frame.CommandPool);
+
+        VK::CommandBufferBeginInfo beginInfo = {};
+        beginInfo.CommandBuffer = frame.CommandBuffer;
+        beginInfo.Flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        VK::CommandBufferBegin(beginInfo);
+
+        VkCommandBuffer buffer = frame.CommandBuffer;
+
+        vkCmdFillBuffer(buffer, frame.Output.Buffer, IndirectDrawBuffer::GetCountOffset(), sizeof(U32), 0);
+
+        VK::CommandPipelineBarrier(buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+        PushConstants constants = {};
+        memcpy(constants.Planes, frustum.GetPlanes(), sizeof(constants.Planes));
+        constants.DrawCount = drawCount;
+        constants.Compact = m_Compact;
+
+        m_Pipeline.Bind(buffer);
+        m_Pipeline.BindDescriptorSets(buffer, &frame.DescriptorSet, 1);
+        m_Pipeline.PushConstantData(buffer, &constants, sizeof(PushConstants), 0);
+
+        vkCmdDispatch(buffer, (drawCount + s_GroupSize - 1) / s_GroupSize, 1, 1);
+
+        VK::CommandPipelineBarrier(buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+        VkBufferCopy region = {};
+        region.srcOffset = IndirectDrawBuffer::GetCountOffset();
+        region.dstOffset = 0;
+        region.size = sizeof(U32);
+
+        vkCmdCopyBuffer(buffer, frame.Output.Buffer, frame.Readback.Buffer, 1, &region);
+
+        VK::CommandPipelineBarrier(buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_HOST_BIT, VK_ACCESS_HOST_READ_BIT);
+
+        // Reaching the indirect draws is up to the semaphore the graphics submit waits on.
+        VK::CommandBufferEnd(buffer);
+    }
+}
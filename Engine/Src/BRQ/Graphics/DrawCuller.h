@@ -0,0 +1,83 @@
+#pragma once
+
+#include <BRQ.h>
+
+#include "Platform/Vulkan/VulkanHelpers.h"
+#include "Platform/Vulkan/VulkanDevice.h"
+#include "Math/Frustum.h"
+#include "ComputePipeline.h"
+#include "IndirectDrawBuffer.h"
+
+namespace BRQ {
+
+    // World space bounds of a draw, the layout of DrawBounds in cull.comp.
+    struct DrawBounds {
+
+        glm::vec4 Min;
+        glm::vec4 Max;
+    };
+
+    // Frustum culls the draws of an IndirectDrawBuffer with cull.comp on the compute queue. The result has the
+    // IndirectDrawBuffer layout: compacted behind an atomic draw count for vkCmdDrawIndexedIndirectCount, or with
+    // every draw in its slot and culled ones drawing no instances when the count can't be used. The graphics submit
+    // drawing the result has to wait on the frame's finished semaphore.
+    class DrawCuller {
+
+    private:
+        struct Frame {
+
+            VK::Buffer       Bounds;
+            BYTE*            MappedBounds;
+            VK::Buffer       Output;
+            U32              Capacity;
+
+            // The visible count copied back for the host.
+            VK::Buffer       Readback;
+            U32*             MappedReadback;
+
+            VkDescriptorPool DescriptorPool;
+            VkDescriptorSet  DescriptorSet;
+            VkCommandPool    CommandPool;
+            VkCommandBuffer  CommandBuffer;
+            VkSemaphore      FinishedSemaphore;
+        };
+
+        struct PushConstants {
+
+            glm::vec4 Planes[6];
+            U32       DrawCount;
+            U32       Compact;
+        };
+
+        ComputePipeline m_Pipeline;
+        Frame           m_Frames[FRAME_LAG];
+        bool            m_Compact;
+
+    public:
+        DrawCuller();
+        ~DrawCuller() = default;
+
+        // Compact needs drawIndirectCount to draw the result, in place results need multiDrawIndirect.
+        void Init(bool compact);
+        void Destroy();
+
+        // Submits the culling of the draws against frustum, bounds holds one element per draw. The frame's previous
+        // submits must have finished, which the fence BeginScene waits on guarantees.
+        void Cull(U32 frame, const IndirectDrawBuffer& draws, const DrawBounds* bounds, const Frustum& frustum);
+
+        bool IsCompact() const { return m_Compact; }
+
+        const VK::Buffer& GetOutputBuffer(U32 frame) const { return m_Frames[frame].Output; }
+        const VkSemaphore& GetFinishedSemaphore(U32 frame) const { return m_Frames[frame].FinishedSemaphore; }
+
+        // Draws the last Cull of frame found visible, valid once the frame's submits finished.
+        U32 GetVisibleCount(U32 frame) const;
+
+    private:
+        void CreateBuffers(Frame& frame, U32 capacity);
+        void DestroyBuffers(Frame& frame);
+
+        void UpdateDescriptorSet(Frame& frame, const IndirectDrawBuffer& draws);
+        void RecordCommands(Frame& frame, U32 drawCount, const Frustum& frustum);
+    };
+}
@@ -3,6 +3,8 @@
 #include "GraphicsPipeline.h"
 #include <spirv_reflect.h>
 
+#include <map>
+
 #include "Platform/Vulkan/RenderContext.h"
 
 namespace BRQ {
@@ -20,6 +22,9 @@ namespace BRQ {
         std::vector<VkPipelineShaderStageCreateInfo> pipelineStages(m_Stages.size());
         std::vector<VkPushConstantRange> ranges;
 
+        // Stages share descriptor sets, the bindings every stage uses in a set end up in one layout per set number.
+        std::map<U32, std::vector<VkDescriptorSetLayoutBinding>> sets;
+
         RenderContext* context = RenderContext::GetInstance();
 
         for (U64 i = 0; i < m_Stages.size(); i++) {
@@ -59,10 +64,30 @@ namespace BRQ {
 
             for (U64 j = 0; j < reflection.DescriptorSetLayoutData.size(); j++) {
 
-                CreateDescriptorSetLayout(reflection.DescriptorSetLayoutData[j].CreateInfo);
+                std::vector<VkDescriptorSetLayoutBinding>& bindings = sets[reflection.DescriptorSetLayoutData[j].SetNumber];
+
+                for (const VkDescriptorSetLayoutBinding& binding : reflection.DescriptorSetLayoutData[j].Bindings) {
+
+                    auto shared = std::find_if(bindings.begin(), bindings.end(), [&binding](const VkDescriptorSetLayoutBinding& other) { return other.binding == binding.binding; });
+
+                    if (shared != bindings.end())
+                        shared->stageFlags |= binding.stageFlags;
+                    else
+                        bindings.push_back(binding);
+                }
             }
         }
 
+        for (const auto& [set, bindings] : sets) {
+
+            VkDescriptorSetLayoutCreateInfo createInfo = {};
+            createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            createInfo.bindingCount = (U32)bindings.size();
+            createInfo.pBindings = bindings.data();
+
+            CreateDescriptorSetLayout(createInfo);
+        }
+
         CreatePipelineLayout(ranges);
         CreatePipeline(info, pipelineStages);
 
@@ -0,0 +1,105 @@
+#include <BRQ.h>
+
+#include "IndirectDrawBuffer.h"
+
+#include "Platform/Vulkan/RenderContext.h"
+
+namespace BRQ {
+
+    IndirectDrawBuffer::IndirectDrawBuffer()
+        : m_MappedCommands(nullptr), m_MappedDrawData(nullptr), m_DrawDataStride(0), m_Capacity(0), m_Count(0) { }
+
+    void IndirectDrawBuffer::Init(U64 drawDataStride, U32 capacity) {
+
+        m_DrawDataStride = drawDataStride;
+        m_Count = 0;
+
+        CreateBuffers(capacity);
+    }
+
+    void IndirectDrawBuffer::Destroy() {
+
+        DestroyBuffers();
+    }
+
+    bool IndirectDrawBuffer::Upload(const VkDrawIndexedIndirectCommand* commands, const void* drawData, U32 count) {
+
+        bool grown = false;
+
+        if (count > m_Capacity) {
+
+            U32 capacity = m_Capacity;
+
+            while (capacity < count)
+                capacity *= 2;
+
+            DestroyBuffers();
+            CreateBuffers(capacity);
+
+            grown = true;
+        }
+
+        m_Count = count;
+
+        VkDeviceSize commandsSize = count * sizeof(VkDrawIndexedIndirectCommand);
+        VkDeviceSize drawDataSize = count * m_DrawDataStride;
+
+        memcpy(m_MappedCommands + GetCountOffset(), &count, sizeof(U32));
+        memcpy(m_MappedCommands + GetCommandsOffset(), commands, commandsSize);
+        memcpy(m_MappedDrawData, drawData, drawDataSize);
+
+        auto vma = VulkanMemoryAllocator::GetInstance();
+
+        vma->FlushMemory(m_Commands, 0, GetCommandsOffset() + commandsSize);
+        vma->FlushMemory(m_DrawData, 0, drawDataSize);
+
+        return grown;
+    }
+
+    void IndirectDrawBuffer::CreateBuffers(U32 capacity) {
+
+        m_Capacity = std::max(capacity, 1u);
+
+        // DrawCuller reads the commands on the compute queue.
+        std::vector<U32> families = RenderContext::GetInstance()->GetGraphicsAndComputeQueueIndices();
+
+        VK::BufferCreateInfo commandsCreateInfo = {};
+        commandsCreateInfo.Size = GetCommandsOffset() + m_Capacity * sizeof(VkDrawIndexedIndirectCommand);
+        commandsCreateInfo.Flags = 0;
+        commandsCreateInfo.Usage = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        commandsCreateInfo.SharingMode = families.size() > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+        commandsCreateInfo.QueueFamilyIndices = families;
+        commandsCreateInfo.MemoryFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        commandsCreateInfo.MemoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+
+        m_Commands = VK::CreateBuffer(commandsCreateInfo);
+
+        VK::BufferCreateInfo drawDataCreateInfo = {};
+        drawDataCreateInfo.Size = m_Capacity * m_DrawDataStride;
+        drawDataCreateInfo.Flags = 0;
+        drawDataCreateInfo.Usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        drawDataCreateInfo.SharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        drawDataCreateInfo.MemoryFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        drawDataCreateInfo.MemoryUsage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+
+        m_DrawData = VK::CreateBuffer(drawDataCreateInfo);
+
+        auto vma = VulkanMemoryAllocator::GetInstance();
+
+        m_MappedCommands = (BYTE*)vma->GetAllocationInfo(m_Commands).pMappedData;
+        m_MappedDrawData = (BYTE*)vma->GetAllocationInfo(m_DrawData).pMappedData;
+    }
+
+    void IndirectDrawBuffer::DestroyBuffers() {
+
+        if (m_Commands.Buffer)
+            VK::DestoryBuffer(m_Commands);
+
+        if (m_DrawData.Buffer)
+            VK::DestoryBuffer(m_DrawData);
+
+        m_MappedCommands = nullptr;
+        m_MappedDrawData = nullptr;
+        m_Capacity = 0;
+    }
+}
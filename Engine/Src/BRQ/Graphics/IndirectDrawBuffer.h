@@ -0,0 +1,50 @@
+#pragma once
+
+#include <BRQ.h>
+
+#include "Platform/Vulkan/VulkanHelpers.h"
+
+namespace BRQ {
+
+    // Persistently mapped indexed indirect draws: a draw count, the draw commands, and a storage buffer with data
+    // per draw that shaders index with the draw's first instance. The CPU rewrites it every frame, so every frame
+    // in flight needs one of its own.
+    class IndirectDrawBuffer {
+
+    private:
+        // Draw count at offset 0 followed by the commands.
+        VK::Buffer m_Commands;
+        VK::Buffer m_DrawData;
+        BYTE*      m_MappedCommands;
+        BYTE*      m_MappedDrawData;
+        U64        m_DrawDataStride;
+        U32        m_Capacity;
+        U32        m_Count;
+
+    public:
+        IndirectDrawBuffer();
+        ~IndirectDrawBuffer() = default;
+
+        void Init(U64 drawDataStride, U32 capacity);
+        void Destroy();
+
+        // Replaces the contents with count draws, drawData holds count elements of the stride given to Init.
+        // Returns true when the buffers had to grow, descriptors referring to the old ones need updating.
+        bool Upload(const VkDrawIndexedIndirectCommand* commands, const void* drawData, U32 count);
+
+        U32 GetCount() const { return m_Count; }
+
+        const VK::Buffer& GetCommandBuffer() const { return m_Commands; }
+        VkDeviceSize GetCommandBufferSize() const { return GetCommandsOffset() + m_Capacity * sizeof(VkDrawIndexedIndirectCommand); }
+        const VK::Buffer& GetDrawDataBuffer() const { return m_DrawData; }
+        VkDeviceSize GetDrawDataSize() const { return m_Capacity * m_DrawDataStride; }
+
+        static VkDeviceSize GetCountOffset() { return 0; }
+        static VkDeviceSize GetCommandsOffset() { return 16; }
+        static U32 GetCommandStride() { return sizeof(VkDrawIndexedIndirectCommand); }
+
+    private:
+        void CreateBuffers(U32 capacity);
+        void DestroyBuffers();
+    };
+}
@@ -2,10 +2,14 @@
 
 #include "Mesh.h"
 
+#include <limits>
+
 #define FAST_OBJ_IMPLEMENTATION
 #include <fast_obj.h>
 #include <meshoptimizer.h>
 
+#include "MeshArena.h"
+
 #include "Platform/Vulkan/RenderContext.h"
 
 namespace BRQ {
@@ -79,15 +83,59 @@ namespace BRQ {
 
     void Mesh::LoadMesh(const MeshData& meshData) {
 
-        VkDevice device = RenderContext::GetInstance()->GetDevice();
-        U32 queueIndex = RenderContext::GetInstance()->GetGraphicsQueueIndex();
-        VkQueue queue = RenderContext::GetInstance()->GetGraphicsQueue();
+        VertexCount = meshData.Verticies.size();
+        IndexCount = meshData.Indicies.size();
+        ArenaRange = 0;
+
+        BoundsMin = glm::vec3(std::numeric_limits<F32>::max());
+        BoundsMax = glm::vec3(std::numeric_limits<F32>::lowest());
+
+        const U64 stride = sizeof(Vertex) / sizeof(F32);
+
+        for (U64 i = 0; i + 3 <= VertexCount; i += stride) {
+
+            glm::vec3 position(meshData.Verticies[i], meshData.Verticies[i + 1], meshData.Verticies[i + 2]);
+
+            BoundsMin = glm::min(BoundsMin, position);
+            BoundsMax = glm::max(BoundsMax, position);
+        }
+
+        UploadMesh(meshData.Verticies.data(), VertexCount * sizeof(meshData.Verticies[0]), meshData.Indicies);
+    }
+
+    void Mesh::LoadMesh(const VoxelMeshData& meshData) {
 
         VertexCount = meshData.Verticies.size();
         IndexCount = meshData.Indicies.size();
 
+        U32 min[3] = { 63, 63, 63 };
+        U32 max[3] = { 0, 0, 0 };
+
+        for (const VoxelVertex& vertex : meshData.Verticies) {
+
+            for (U32 axis = 0; axis < 3; axis++) {
+
+                U32 position = (vertex.PositionAndFace >> (axis * 6)) & 63;
+
+                min[axis] = std::min(min[axis], position);
+                max[axis] = std::max(max[axis], position);
+            }
+        }
+
+        BoundsMin = glm::vec3((F32)min[0], (F32)min[1], (F32)min[2]) - 0.5f;
+        BoundsMax = glm::vec3((F32)max[0], (F32)max[1], (F32)max[2]) - 0.5f;
+
+        ArenaRange = MeshArena::GetInstance()->Upload(ArenaRange, meshData.Verticies.data(), VertexCount, meshData.Indicies.data(), IndexCount);
+    }
+
+    void Mesh::UploadMesh(const void* vertices, U64 verticesSize, const std::vector<U32>& indices) {
+
+        VkDevice device = RenderContext::GetInstance()->GetDevice();
+        U32 queueIndex = RenderContext::GetInstance()->GetGraphicsQueueIndex();
+        VkQueue queue = RenderContext::GetInstance()->GetGraphicsQueue();
+
         VK::BufferCreateInfo vertexCreateInfo = {};
-        vertexCreateInfo.Size = VertexCount * sizeof(meshData.Verticies[0]);
+        vertexCreateInfo.Size = verticesSize;
         vertexCreateInfo.Flags = 0;
         vertexCreateInfo.Usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
         vertexCreateInfo.SharingMode = VK_SHARING_MODE_EXCLUSIVE;
@@ -119,8 +167,8 @@ namespace BRQ {
 
         VK::UploadBufferInfo vertexUpload = {};
         vertexUpload.DestinationBuffer = &VertexBuffer;
-        vertexUpload.Data = meshData.Verticies.data();
-        vertexUpload.Size = VertexCount * sizeof(meshData.Verticies[0]);
+        vertexUpload.Data = vertices;
+        vertexUpload.Size = verticesSize;
         vertexUpload.Queue = queue;
         vertexUpload.QueueFamilyIndex = queueIndex;
         vertexUpload.CommandBuffer = cmds[0];
@@ -129,7 +177,7 @@ namespace BRQ {
 
         VK::UploadBufferInfo indexUpload = {};
         indexUpload.DestinationBuffer = &IndexBuffer;
-        indexUpload.Data = meshData.Indicies.data();
+        indexUpload.Data = indices.data();
         indexUpload.Size = IndexCount * sizeof(U32);
         indexUpload.Queue = queue;
         indexUpload.QueueFamilyIndex = queueIndex;
@@ -148,6 +196,13 @@ namespace BRQ {
 
     void Mesh::DestroyMesh() {
 
+        if (ArenaRange) {
+
+            MeshArena::GetInstance()->Free(ArenaRange);
+            ArenaRange = 0;
+            return;
+        }
+
         VK::DestoryBuffer(VertexBuffer);
         VK::DestoryBuffer(IndexBuffer);
     }
@@ -19,15 +19,42 @@ namespace BRQ {
         std::vector<U32> Indicies;
     };
 
+    // 8 byte vertex for voxel geometry, decoded in voxel.vert.
+    // PositionAndFace: x(6) y(6) z(6) face(3) ao(2)
+    // Material:        texture layer(16) sky light(4) block light(4)
+    struct VoxelVertex {
+
+        U32 PositionAndFace;
+        U32 Material;
+
+        bool operator==(const VoxelVertex& other) const { return PositionAndFace == other.PositionAndFace && Material == other.Material; }
+    };
+
+    struct VoxelMeshData {
+
+        std::vector<VoxelVertex> Verticies;
+        std::vector<U32>         Indicies;
+    };
+
     struct Mesh {
 
         VK::Buffer VertexBuffer;
         VK::Buffer IndexBuffer;
         U64        VertexCount;
         U64        IndexCount;
+        // Handle of the MeshArena range holding a voxel mesh, 0 for meshes with buffers of their own.
+        U32        ArenaRange;
+        // Local space bounds of the vertices, voxel meshes include the half block offset voxel.vert applies.
+        glm::vec3  BoundsMin;
+        glm::vec3  BoundsMax;
 
         void LoadMesh(const std::string_view& filename);
         void LoadMesh(const MeshData& meshData);
+        // Voxel meshes go to the MeshArena, loading into a mesh that is already there replaces it in place when it fits.
+        void LoadMesh(const VoxelMeshData& meshData);
         void DestroyMesh();
+
+    private:
+        void UploadMesh(const void* vertices, U64 verticesSize, const std::vector<U32>& indices);
     };
 }
\ No newline at end of file
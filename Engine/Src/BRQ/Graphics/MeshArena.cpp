@@ -0,0 +1,413 @@
+#include <BRQ.h>
+
+#include "MeshArena.h"
+
+#include "Platform/Vulkan/RenderContext.h"
+#include "Platform/Vulkan/VulkanCommands.h"
+
+namespace BRQ {
+
+    // Ranges are rounded up so a remesh that grows by a few faces still fits in place.
+    static const U64 s_VertexGranularity = 64;
+    static const U64 s_IndexGranularity = 96;
+    static const U64 s_MinStagingSize = 1 << 20;
+
+    static U64 RoundUp(U64 count, U64 granularity) {
+
+        return (count + granularity - 1) / granularity * granularity;
+    }
+
+    MeshArena* MeshArena::s_Instance = nullptr;
+
+    MeshArena::MeshArena()
+        : m_VertexStride(0), m_Frames(), m_FrameIndex(0), m_InPlaceUploads(0), m_Defragmentations(0) { }
+
+    void MeshArena::Init(const MeshArenaCreateInfo& info) {
+
+        s_Instance = new MeshArena();
+        s_Instance->InitInternal(info);
+    }
+
+    void MeshArena::Shutdown() {
+
+        if (s_Instance) {
+
+            s_Instance->DestroyInternal();
+            delete s_Instance;
+            s_Instance = nullptr;
+        }
+    }
+
+    void MeshArena::InitInternal(const MeshArenaCreateInfo& info) {
+
+        m_VertexStride = info.VertexStride;
+
+        CreateBuffers(info.VertexCapacity, info.IndexCapacity, m_VertexBuffer, m_IndexBuffer);
+
+        m_Vertices.Reset(info.VertexCapacity);
+        m_Indices.Reset(info.IndexCapacity);
+
+        VkDevice device = RenderContext::GetInstance()->GetDevice();
+
+        for (Frame& frame : m_Frames) {
+
+            VK::CommandPoolCreateInfo poolInfo = {};
+            poolInfo.Flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            poolInfo.QueueFamilyIndex = RenderContext::GetInstance()->GetGraphicsQueueIndex();
+
+            frame.CommandPool = VK::CreateCommandPool(device, poolInfo);
+
+            VK::CommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.CommandPool = frame.CommandPool;
+            allocateInfo.Level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.CommandBufferCount = 1;
+
+            frame.CommandBuffer = VK::AllocateCommandBuffers(device, allocateInfo)[0];
+
+            // Signaled, the first recording of the frame has nothing to wait for.
+            frame.SubmittedFence = VK::CreateFence(device);
+        }
+    }
+
+    void MeshArena::DestroyInternal() {
+
+        VkDevice device = RenderContext::GetInstance()->GetDevice();
+
+        // Copies recorded after the last Submit are dropped with their command buffers.
+        for (Frame& frame : m_Frames) {
+
+            VK::WaitForFence(device, frame.SubmittedFence);
+            VK::DestroyFence(device, frame.SubmittedFence);
+
+            VK::FreeCommandBuffer(device, frame.CommandPool, frame.CommandBuffer);
+            VK::DestroyCommandPool(device, frame.CommandPool);
+
+            if (frame.StagingBuffer.Buffer)
+                VK::DestoryBuffer(frame.StagingBuffer);
+
+            for (VK::Buffer& buffer : frame.RetiredBuffers)
+                VK::DestoryBuffer(buffer);
+
+            frame = {};
+        }
+
+        VK::DestoryBuffer(m_VertexBuffer);
+        VK::DestoryBuffer(m_IndexBuffer);
+
+        m_Ranges.clear();
+        m_FreeHandles.clear();
+    }
+
+    void MeshArena::CreateBuffers(U64 vertexCapacity, U64 indexCapacity, VK::Buffer& vertexBuffer, VK::Buffer& indexBuffer) const {
+
+        VK::BufferCreateInfo vertexCreateInfo = {};
+        vertexCreateInfo.Size = vertexCapacity * m_VertexStride;
+        vertexCreateInfo.Flags = 0;
+        vertexCreateInfo.Usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        vertexCreateInfo.SharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        vertexCreateInfo.MemoryUsage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+        vertexBuffer = VK::CreateBuffer(vertexCreateInfo);
+
+        VK::BufferCreateInfo indexCreateInfo = {};
+        indexCreateInfo.Size = indexCapacity * sizeof(U32);
+        indexCreateInfo.Flags = 0;
+        indexCreateInfo.Usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        indexCreateInfo.SharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        indexCreateInfo.MemoryUsage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+        indexBuffer = VK::CreateBuffer(indexCreateInfo);
+    }
+
+    U64 MeshArena::AllocateStaging(U64 size) {
+
+        Frame& frame = m_Frames[m_FrameIndex];
+
+        if (frame.StagingUsed + size > frame.StagingSize) {
+
+            // Copies recorded this frame still read the old buffer, it goes away with the frame's other retired buffers.
+            if (frame.StagingBuffer.Buffer)
+                frame.RetiredBuffers.push_back(frame.StagingBuffer);
+
+            frame.StagingSize = std::max(s_MinStagingSize, frame.StagingSize * 2);
+
+            while (frame.StagingSize < size)
+                frame.StagingSize *= 2;
+
+            VK::BufferCreateInfo createInfo = {};
+            createInfo.Size = frame.StagingSize;
+            createInfo.Flags = 0;
+            createInfo.Usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+            createInfo.SharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            createInfo.MemoryFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+            createInfo.MemoryUsage = VMA_MEMORY_USAGE_CPU_ONLY;
+
+            frame.StagingBuffer = VK::CreateBuffer(createInfo);
+            frame.StagingData = (BYTE*)VulkanMemoryAllocator::GetInstance()->GetAllocationInfo(frame.StagingBuffer).pMappedData;
+            frame.StagingUsed = 0;
+        }
+
+        U64 offset = frame.StagingUsed;
+        frame.StagingUsed += size;
+
+        return offset;
+    }
+
+    U32 MeshArena::Upload(U32 handle, const void* vertices, U64 vertexCount, const U32* indices, U64 indexCount) {
+
+        if (vertexCount == 0 || indexCount == 0) {
+
+            Free(handle);
+            return 0;
+        }
+
+        if (!handle) {
+
+            if (m_FreeHandles.empty()) {
+
+                m_Ranges.push_back({});
+                handle = (U32)m_Ranges.size();
+            }
+            else {
+
+                handle = m_FreeHandles.back();
+                m_FreeHandles.pop_back();
+            }
+        }
+
+        MeshArenaRange& range = m_Ranges[handle - 1];
+
+        if (vertexCount <= range.VertexCapacity && indexCount <= range.IndexCapacity) {
+
+            m_InPlaceUploads++;
+        }
+        else {
+
+            Release(range);
+
+            if (!Allocate(range, vertexCount, indexCount)) {
+
+                // With enough free space in total closing the gaps is enough, otherwise the arena grows too.
+                U64 vertexCapacity = m_Vertices.GetCapacity();
+                U64 indexCapacity = m_Indices.GetCapacity();
+
+                U64 vertexSize = RoundUp(vertexCount, s_VertexGranularity);
+                U64 indexSize = RoundUp(indexCount, s_IndexGranularity);
+
+                if (m_Vertices.GetFree() < vertexSize)
+                    vertexCapacity = std::max(vertexCapacity * 2, m_Vertices.GetUsed() + vertexSize);
+
+                if (m_Indices.GetFree() < indexSize)
+                    indexCapacity = std::max(indexCapacity * 2, m_Indices.GetUsed() + indexSize);
+
+                Defragment(vertexCapacity, indexCapacity);
+
+                bool allocated = Allocate(range, vertexCount, indexCount);
+                BRQ_CORE_ASSERT(allocated);
+            }
+        }
+
+        U64 verticesSize = vertexCount * m_VertexStride;
+        U64 indicesSize = indexCount * sizeof(U32);
+
+        Frame& frame = BeginCommands();
+
+        U64 stagingOffset = AllocateStaging(verticesSize + indicesSize);
+
+        memcpy(frame.StagingData + stagingOffset, vertices, verticesSize);
+        memcpy(frame.StagingData + stagingOffset + verticesSize, indices, indicesSize);
+
+        // A range uploaded twice in one frame must end up with the later mesh.
+        VK::CommandPipelineBarrier(frame.CommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+
+        VkBufferCopy vertexCopy = {};
+        vertexCopy.srcOffset = stagingOffset;
+        vertexCopy.dstOffset = range.VertexOffset * m_VertexStride;
+        vertexCopy.size = verticesSize;
+
+        VkBufferCopy indexCopy = {};
+        indexCopy.srcOffset = stagingOffset + verticesSize;
+        indexCopy.dstOffset = range.IndexOffset * sizeof(U32);
+        indexCopy.size = indicesSize;
+
+        vkCmdCopyBuffer(frame.CommandBuffer, frame.StagingBuffer.Buffer, m_VertexBuffer.Buffer, 1, &vertexCopy);
+        vkCmdCopyBuffer(frame.CommandBuffer, frame.StagingBuffer.Buffer, m_IndexBuffer.Buffer, 1, &indexCopy);
+
+        return handle;
+    }
+
+    void MeshArena::Free(U32 handle) {
+
+        if (!handle)
+            return;
+
+        Release(m_Ranges[handle - 1]);
+        m_FreeHandles.push_back(handle);
+    }
+
+    bool MeshArena::Allocate(MeshArenaRange& range, U64 vertexCount, U64 indexCount) {
+
+        U64 vertexSize = RoundUp(vertexCount, s_VertexGranularity);
+        U64 indexSize = RoundUp(indexCount, s_IndexGranularity);
+
+        U64 vertexOffset = 0;
+        U64 indexOffset = 0;
+
+        if (!m_Vertices.Allocate(vertexSize, vertexOffset))
+            return false;
+
+        if (!m_Indices.Allocate(indexSize, indexOffset)) {
+
+            m_Vertices.Free(vertexOffset, vertexSize);
+            return false;
+        }
+
+        range.VertexOffset = (U32)vertexOffset;
+        range.VertexCapacity = (U32)vertexSize;
+        range.IndexOffset = (U32)indexOffset;
+        range.IndexCapacity = (U32)indexSize;
+
+        return true;
+    }
+
+    void MeshArena::Release(MeshArenaRange& range) {
+
+        m_Vertices.Free(range.VertexOffset, range.VertexCapacity);
+        m_Indices.Free(range.IndexOffset, range.IndexCapacity);
+
+        range = {};
+    }
+
+    void MeshArena::Defragment(U64 vertexCapacity, U64 indexCapacity) {
+
+        VK::Buffer vertexBuffer;
+        VK::Buffer indexBuffer;
+
+        CreateBuffers(vertexCapacity, indexCapacity, vertexBuffer, indexBuffer);
+
+        m_Vertices.Reset(vertexCapacity);
+        m_Indices.Reset(indexCapacity);
+
+        std::vector<VkBufferCopy> vertexCopies;
+        std::vector<VkBufferCopy> indexCopies;
+
+        // A fresh allocator hands out ranges back to back, so every live range keeps its capacity and the gaps disappear.
+        for (MeshArenaRange& range : m_Ranges) {
+
+            if (!range.VertexCapacity)
+                continue;
+
+            U64 vertexOffset = 0;
+            U64 indexOffset = 0;
+
+            m_Vertices.Allocate(range.VertexCapacity, vertexOffset);
+            m_Indices.Allocate(range.IndexCapacity, indexOffset);
+
+            vertexCopies.push_back({ range.VertexOffset * m_VertexStride, vertexOffset * m_VertexStride, range.VertexCapacity * m_VertexStride });
+            indexCopies.push_back({ range.IndexOffset * sizeof(U32), indexOffset * sizeof(U32), range.IndexCapacity * sizeof(U32) });
+
+            range.VertexOffset = (U32)vertexOffset;
+            range.IndexOffset = (U32)indexOffset;
+        }
+
+        Frame& frame = BeginCommands();
+
+        if (!vertexCopies.empty()) {
+
+            // Uploads recorded earlier this frame have to land before their ranges are moved.
+            VK::CommandPipelineBarrier(frame.CommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+            vkCmdCopyBuffer(frame.CommandBuffer, m_VertexBuffer.Buffer, vertexBuffer.Buffer, (U32)vertexCopies.size(), vertexCopies.data());
+            vkCmdCopyBuffer(frame.CommandBuffer, m_IndexBuffer.Buffer, indexBuffer.Buffer, (U32)indexCopies.size(), indexCopies.data());
+        }
+
+        // Frames in flight still draw from the old buffers and this frame's copies read them.
+        frame.RetiredBuffers.push_back(m_VertexBuffer);
+        frame.RetiredBuffers.push_back(m_IndexBuffer);
+
+        m_VertexBuffer = vertexBuffer;
+        m_IndexBuffer = indexBuffer;
+
+        m_Defragmentations++;
+
+        BRQ_CORE_INFO("Mesh arena defragmented: {} of {} vertices, {} of {} indices used", m_Vertices.GetUsed(), vertexCapacity, m_Indices.GetUsed(), indexCapacity);
+    }
+
+    void MeshArena::Submit() {
+
+        Frame& frame = m_Frames[m_FrameIndex];
+
+        if (!frame.Recording)
+            return;
+
+        VK::CommandPipelineBarrier(frame.CommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT);
+
+        VK::CommandBufferEnd(frame.CommandBuffer);
+
+        // The barriers order the copies against the draws submitted before and after on this queue, no semaphore needed.
+        VK::QueueSubmitInfo submitInfo = {};
+        submitInfo.CommandBufferCount = 1;
+        submitInfo.CommandBuffers = &frame.CommandBuffer;
+        submitInfo.Queue = RenderContext::GetInstance()->GetGraphicsQueue();
+        submitInfo.CommandBufferExecutedFence = frame.SubmittedFence;
+
+        VK::QueueSubmit(submitInfo);
+
+        frame.Recording = false;
+        m_FrameIndex = (m_FrameIndex + 1) % FRAME_LAG;
+    }
+
+    MeshArena::Frame& MeshArena::BeginCommands() {
+
+        Frame& frame = m_Frames[m_FrameIndex];
+
+        if (frame.Recording)
+            return frame;
+
+        VkDevice device = RenderContext::GetInstance()->GetDevice();
+
+        // Submitted FRAME_LAG frames ago, normally long finished. A fence also covers everything submitted before it,
+        // so no frame can still draw from the retired buffers either.
+        VK::WaitForFence(device, frame.SubmittedFence);
+        VK::ResetFence(device, frame.SubmittedFence);
+
+        for (VK::Buffer& buffer : frame.RetiredBuffers)
+            VK::DestoryBuffer(buffer);
+
+        frame.RetiredBuffers.clear();
+        frame.StagingUsed = 0;
+
+        VK::ResetCommandPool(device, frame.CommandPool);
+
+        VK::CommandBufferBeginInfo beginInfo = {};
+        beginInfo.CommandBuffer = frame.CommandBuffer;
+        beginInfo.Flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        VK::CommandBufferBegin(beginInfo);
+
+        // The first scope covers every frame submitted before, their draws have to finish reading the ranges about to be overwritten.
+        VK::CommandPipelineBarrier(frame.CommandBuffer, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+
+        frame.Recording = true;
+
+        return frame;
+    }
+
+    MeshArenaStatistics MeshArena::GetStatistics() const {
+
+        MeshArenaStatistics statistics = {};
+        statistics.VertexCapacity = m_Vertices.GetCapacity();
+        statistics.UsedVertices = m_Vertices.GetUsed();
+        statistics.IndexCapacity = m_Indices.GetCapacity();
+        statistics.UsedIndices = m_Indices.GetUsed();
+        statistics.RangeCount = (U32)(m_Ranges.size() - m_FreeHandles.size());
+        statistics.InPlaceUploads = m_InPlaceUploads;
+        statistics.Defragmentations = m_Defragmentations;
+
+        return statistics;
+    }
+}
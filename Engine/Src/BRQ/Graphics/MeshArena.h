@@ -0,0 +1,125 @@
+#pragma once
+
+#include <BRQ.h>
+
+#include "Platform/Vulkan/VulkanHelpers.h"
+#include "Utilities/RangeAllocator.h"
+
+namespace BRQ {
+
+    struct MeshArenaCreateInfo {
+
+        U64 VertexStride   = 0;
+        U64 VertexCapacity = 0;
+        U64 IndexCapacity  = 0;
+    };
+
+    // Offsets and capacities in vertices and indices. Indices stay relative to the range's first vertex,
+    // draws pass VertexOffset as the vertex offset and IndexOffset as the first index.
+    struct MeshArenaRange {
+
+        U32 VertexOffset;
+        U32 VertexCapacity;
+        U32 IndexOffset;
+        U32 IndexCapacity;
+    };
+
+    struct MeshArenaStatistics {
+
+        U64 VertexCapacity;
+        U64 UsedVertices;
+        U64 IndexCapacity;
+        U64 UsedIndices;
+        U32 RangeCount;
+        U32 InPlaceUploads;
+        U32 Defragmentations;
+    };
+
+    // One vertex and one index buffer shared by many meshes, so they need no allocation of their own and draw
+    // without rebinding. Meshes refer to their range through a handle, which stays valid when defragmenting moves
+    // the range. The copies of a frame are recorded into one command buffer that Submit hands to the graphics queue
+    // ahead of the frame's draws. Barriers order them after the draws of earlier frames and before the draws of this
+    // one, so a range can be replaced or reused as soon as it is freed.
+    class MeshArena {
+
+    private:
+        // Staging memory and replaced buffers of a submit stay alive until its fence signals, FRAME_LAG submits later.
+        struct Frame {
+
+            VK::Buffer              StagingBuffer;
+            BYTE*                   StagingData;
+            U64                     StagingSize;
+            U64                     StagingUsed;
+
+            VkCommandPool           CommandPool;
+            VkCommandBuffer         CommandBuffer;
+            VkFence                 SubmittedFence;
+            bool                    Recording;
+
+            std::vector<VK::Buffer> RetiredBuffers;
+        };
+
+        static MeshArena*           s_Instance;
+
+        U64                         m_VertexStride;
+        VK::Buffer                  m_VertexBuffer;
+        VK::Buffer                  m_IndexBuffer;
+        Utilities::RangeAllocator   m_Vertices;
+        Utilities::RangeAllocator   m_Indices;
+
+        // Indexed by handle - 1, ranges without capacity are unused.
+        std::vector<MeshArenaRange> m_Ranges;
+        std::vector<U32>            m_FreeHandles;
+
+        Frame                       m_Frames[FRAME_LAG];
+        U32                         m_FrameIndex;
+
+        U32                         m_InPlaceUploads;
+        U32                         m_Defragmentations;
+
+    protected:
+        MeshArena();
+        MeshArena(const MeshArena& arena) = delete;
+
+    public:
+        ~MeshArena() = default;
+
+        static void Init(const MeshArenaCreateInfo& info = {});
+        static void Shutdown();
+
+        static MeshArena* GetInstance() { return s_Instance; }
+
+        // Uploads a mesh into the range of handle, in place when it fits and into a new range otherwise.
+        // Handle 0 allocates a new range. Returns the handle now holding the mesh, 0 for an empty mesh.
+        U32 Upload(U32 handle, const void* vertices, U64 vertexCount, const U32* indices, U64 indexCount);
+        void Free(U32 handle);
+
+        // Submits the copies recorded since the last call with a single submit. Call once per frame before the
+        // graphics submit that draws from the arena. Does nothing when there was nothing to copy.
+        void Submit();
+
+        const MeshArenaRange& GetRange(U32 handle) const { return m_Ranges[handle - 1]; }
+
+        const VK::Buffer& GetVertexBuffer() const { return m_VertexBuffer; }
+        const VK::Buffer& GetIndexBuffer() const { return m_IndexBuffer; }
+
+        MeshArenaStatistics GetStatistics() const;
+
+    private:
+        void InitInternal(const MeshArenaCreateInfo& info);
+        void DestroyInternal();
+
+        void CreateBuffers(U64 vertexCapacity, U64 indexCapacity, VK::Buffer& vertexBuffer, VK::Buffer& indexBuffer) const;
+        // Returns the offset of size free bytes in the current frame's staging buffer, replacing it with a larger one when full.
+        U64 AllocateStaging(U64 size);
+
+        bool Allocate(MeshArenaRange& range, U64 vertexCount, U64 indexCount);
+        void Release(MeshArenaRange& range);
+
+        // Moves every live range to the front of new buffers with the given capacities, closing all gaps.
+        void Defragment(U64 vertexCapacity, U64 indexCapacity);
+
+        // Starts recording the current frame's copies unless it already is, waiting for the frame's previous submit first.
+        Frame& BeginCommands();
+    };
+}
@@ -6,6 +6,7 @@
 #include "Utilities/VulkanMemoryAllocator.h"
 
 #include "Graphics/Mesh.h"
+#include "Graphics/MeshArena.h"
 
 #include "Platform/Vulkan/RenderContext.h"
 #include "Platform/Vulkan/VulkanCommands.h"
@@ -22,8 +23,28 @@ namespace BRQ {
 
     Renderer* Renderer::s_Renderer = nullptr;
 
+    void VoxelDrawList::Clear() {
+
+        m_Meshes.clear();
+        m_Origins.clear();
+        m_Lods.clear();
+        m_Bounds.Clear();
+    }
+
+    void VoxelDrawList::Add(const Mesh& mesh, const glm::vec3& origin, U32 lod) {
+
+        if (mesh.IndexCount == 0)
+            return;
+
+        m_Meshes.push_back(&mesh);
+        m_Origins.push_back(origin);
+        m_Lods.push_back(lod);
+        m_Bounds.Add(origin + mesh.BoundsMin, origin + mesh.BoundsMax);
+    }
+
     Renderer::Renderer()
-        : m_RenderContext(nullptr), m_Window(nullptr) { }
+        : m_RenderContext(nullptr), m_Window(nullptr), m_Texture2D(nullptr), m_TextureCube(nullptr), m_VoxelTextures(nullptr), m_ViewProjection(1.0f), m_GpuCullingSupported(false), m_GpuCulling(false),
+          m_GpuVisibleVoxelMeshes(0), m_PerFrameData() { }
 
     void Renderer::Init(const Window* window) {
 
@@ -47,6 +68,8 @@ namespace BRQ {
         VK::WaitForFence(m_RenderContext->GetDevice(), perframe.CommandBufferExecutedFence);
         VK::ResetFence(m_RenderContext->GetDevice(), perframe.CommandBufferExecutedFence);
 
+        m_GpuVisibleVoxelMeshes = perframe.VoxelDrawsCulled ? m_VoxelCuller.GetVisibleCount(index) : 0;
+
         VK::ResetCommandPool(m_RenderContext->GetDevice(), perframe.CommandPool);
 
         VkCommandBuffer buffer = perframe.CommandBuffer;
@@ -99,18 +122,29 @@ namespace BRQ {
         vkCmdSetViewport(buffer, 0, 1, &viewport);
         vkCmdSetScissor(buffer, 0, 1, &scissor);
 
-        m_Pipeline.Bind(buffer);
+        glm::mat4 pv = camera.GetProjectionMatrix() * camera.GetViewMatrix();
+
+        m_ViewProjection = pv;
+        m_Frustum = Frustum(pv);
+
+        m_VoxelCommands.clear();
+        m_VoxelDrawData.clear();
+        m_VoxelBounds.clear();
 
         VkDeviceSize offset = 0;
-        vkCmdBindVertexBuffers(buffer, 0, 1, &mesh.VertexBuffer.Buffer, &offset);
-        vkCmdBindIndexBuffer(buffer, mesh.IndexBuffer.Buffer, 0, VK_INDEX_TYPE_UINT32);
 
-        glm::mat4 pv = camera.GetProjectionMatrix() * camera.GetViewMatrix();
+        if (m_Frustum.Intersects(mesh.BoundsMin, mesh.BoundsMax)) {
 
-        m_Pipeline.PushConstantData(buffer, PipelineStage::Vertex, &pv[0], sizeof(glm::mat4), 0);
-        m_Pipeline.BindDescriptorSets(buffer, m_PerFrameData[index].DescriptorSets.data(), (U32)m_PerFrameData[index].DescriptorSets.size());
+            m_Pipeline.Bind(buffer);
 
-        vkCmdDrawIndexed(buffer, (U32)mesh.IndexCount, 1, 0, 0, 0);
+            vkCmdBindVertexBuffers(buffer, 0, 1, &mesh.VertexBuffer.Buffer, &offset);
+            vkCmdBindIndexBuffer(buffer, mesh.IndexBuffer.Buffer, 0, VK_INDEX_TYPE_UINT32);
+
+            m_Pipeline.PushConstantData(buffer, PipelineStage::Vertex, &pv[0], sizeof(glm::mat4), 0);
+            m_Pipeline.BindDescriptorSets(buffer, m_PerFrameData[index].DescriptorSets.data(), (U32)m_PerFrameData[index].DescriptorSets.size());
+
+            vkCmdDrawIndexed(buffer, (U32)mesh.IndexCount, 1, 0, 0, 0);
+        }
 
         // ------------------------------------------------------
 
@@ -131,6 +165,123 @@ namespace BRQ {
         vkCmdDrawIndexed(buffer, skybox.GetIndexCount(), 1, 0, 0, 0);
     }
 
+    void Renderer::SubmitVoxelMesh(const Mesh& mesh, const glm::vec3& origin, U32 lod) {
+
+        if (mesh.IndexCount == 0)
+            return;
+
+        if (!m_GpuCulling && !m_Frustum.Intersects(origin + mesh.BoundsMin, origin + mesh.BoundsMax))
+            return;
+
+        AddVoxelDraw(mesh, origin, lod);
+    }
+
+    void Renderer::SubmitVoxelMeshes(const VoxelDrawList& drawList) {
+
+        if (m_GpuCulling) {
+
+            for (U32 i = 0; i < drawList.GetCount(); i++)
+                AddVoxelDraw(drawList.GetMesh(i), drawList.GetOrigin(i), drawList.GetLod(i));
+
+            return;
+        }
+
+        m_VisibleMeshes.resize(drawList.GetCount());
+
+        U32 visibleCount = m_Frustum.Cull(drawList.GetBounds(), m_VisibleMeshes.data());
+
+        for (U32 i = 0; i < visibleCount; i++) {
+
+            U32 visible = m_VisibleMeshes[i];
+
+            AddVoxelDraw(drawList.GetMesh(visible), drawList.GetOrigin(visible), drawList.GetLod(visible));
+        }
+    }
+
+    void Renderer::AddVoxelDraw(const Mesh& mesh, const glm::vec3& origin, U32 lod) {
+
+        const MeshArenaRange& range = MeshArena::GetInstance()->GetRange(mesh.ArenaRange);
+
+        // The first instance is the draw's index, voxel.vert finds its draw data through gl_InstanceIndex.
+        VkDrawIndexedIndirectCommand command = {};
+        command.indexCount = (U32)mesh.IndexCount;
+        command.instanceCount = 1;
+        command.firstIndex = range.IndexOffset;
+        command.vertexOffset = (I32)range.VertexOffset;
+        command.firstInstance = (U32)m_VoxelCommands.size();
+
+        m_VoxelCommands.push_back(command);
+        m_VoxelDrawData.push_back({ origin, lod });
+        m_VoxelBounds.push_back({ glm::vec4(origin + mesh.BoundsMin, 0.0f), glm::vec4(origin + mesh.BoundsMax, 0.0f) });
+    }
+
+    void Renderer::DrawVoxelMeshes() {
+
+        U32 index = m_RenderContext->GetCurrentIndex();
+
+        PerFrame& perframe = m_PerFrameData[index];
+        perframe.VoxelDrawsCulled = false;
+
+        if (m_VoxelCommands.empty())
+            return;
+
+        VkCommandBuffer buffer = perframe.CommandBuffer;
+
+        U32 drawCount = (U32)m_VoxelCommands.size();
+
+        // Frames in flight use their own buffers, the fence waited on in BeginScene makes this frame's free to rewrite.
+        if (perframe.VoxelDraws.Upload(m_VoxelCommands.data(), m_VoxelDrawData.data(), drawCount))
+            UpdateVoxelDrawDescriptors(index);
+
+        m_VoxelPipeline.Bind(buffer);
+        m_VoxelPipeline.PushConstantData(buffer, PipelineStage::Vertex, &m_ViewProjection[0], sizeof(glm::mat4), 0);
+        m_VoxelPipeline.BindDescriptorSets(buffer, perframe.VoxelDescriptorSets.data(), (U32)perframe.VoxelDescriptorSets.size());
+
+        // Every voxel mesh lives in the arena, one binding serves all draws.
+        const MeshArena* arena = MeshArena::GetInstance();
+
+        VkDeviceSize offset = 0;
+        vkCmdBindVertexBuffers(buffer, 0, 1, &arena->GetVertexBuffer().Buffer, &offset);
+        vkCmdBindIndexBuffer(buffer, arena->GetIndexBuffer().Buffer, 0, VK_INDEX_TYPE_UINT32);
+
+        const VkBuffer commands = perframe.VoxelDraws.GetCommandBuffer().Buffer;
+        const VkDeviceSize commandsOffset = IndirectDrawBuffer::GetCommandsOffset();
+        const U32 stride = IndirectDrawBuffer::GetCommandStride();
+
+        if (m_GpuCulling) {
+
+            // Submitted to the compute queue ahead of this frame's graphics submit, which waits for it in EndScene.
+            m_VoxelCuller.Cull(index, perframe.VoxelDraws, m_VoxelBounds.data(), m_Frustum);
+            perframe.VoxelDrawsCulled = true;
+
+            const VkBuffer culled = m_VoxelCuller.GetOutputBuffer(index).Buffer;
+
+            if (m_VoxelCuller.IsCompact())
+                vkCmdDrawIndexedIndirectCount(buffer, culled, commandsOffset, culled, IndirectDrawBuffer::GetCountOffset(), drawCount, stride);
+            else
+                vkCmdDrawIndexedIndirect(buffer, culled, commandsOffset, drawCount, stride);
+        }
+        else if (!m_RenderContext->IsDrawIndirectFirstInstanceEnabled()) {
+
+            // Indirect draws cannot pass the draw index through firstInstance here, direct draws always can.
+            for (const VkDrawIndexedIndirectCommand& command : m_VoxelCommands)
+                vkCmdDrawIndexed(buffer, command.indexCount, 1, command.firstIndex, command.vertexOffset, command.firstInstance);
+        }
+        else if (m_RenderContext->IsDrawIndirectCountEnabled()) {
+
+            vkCmdDrawIndexedIndirectCount(buffer, commands, commandsOffset, commands, IndirectDrawBuffer::GetCountOffset(), drawCount, stride);
+        }
+        else if (m_RenderContext->IsMultiDrawIndirectEnabled()) {
+
+            vkCmdDrawIndexedIndirect(buffer, commands, commandsOffset, drawCount, stride);
+        }
+        else {
+
+            for (U32 i = 0; i < drawCount; i++)
+                vkCmdDrawIndexedIndirect(buffer, commands, commandsOffset + (VkDeviceSize)i * stride, 1, stride);
+        }
+    }
+
     void Renderer::EndScene() {
 
         U32 index = m_RenderContext->GetCurrentIndex();
@@ -139,14 +290,22 @@ namespace BRQ {
 
         VkCommandBuffer buffer = perframe.CommandBuffer;
 
+        DrawVoxelMeshes();
+
         VK::CommandEndRenderPass(buffer);
 
+        // The frame's mesh uploads go to the same queue right before the draws that read them.
+        MeshArena::GetInstance()->Submit();
+
         VK::CommandBufferEnd(buffer);
 
+        VkSemaphore waitSemaphores[2] = { perframe.ImageAvailableSemaphore, m_VoxelCuller.GetFinishedSemaphore(index) };
+        VkPipelineStageFlags waitStages[2] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT };
+
         VK::QueueSubmitInfo submitInfo = {};
-        submitInfo.WaitSemaphoreCount = 1;
-        submitInfo.WaitSemaphores = &perframe.ImageAvailableSemaphore;
-        submitInfo.WaitDstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        submitInfo.WaitSemaphoreCount = perframe.VoxelDrawsCulled ? 2 : 1;
+        submitInfo.WaitSemaphores = waitSemaphores;
+        submitInfo.WaitDstStageMasks = waitStages;
         submitInfo.CommandBufferCount = 1;
         submitInfo.CommandBuffers = &buffer;
         submitInfo.SignalSemaphoreCount = 1;
@@ -183,13 +342,23 @@ namespace BRQ {
 
         m_RenderContext = RenderContext::GetInstance();
 
+        MeshArenaCreateInfo arenaInfo = {};
+        arenaInfo.VertexStride = sizeof(VoxelVertex);
+        arenaInfo.VertexCapacity = 1 << 21;
+        arenaInfo.IndexCapacity = 1 << 22;
+
+        MeshArena::Init(arenaInfo);
+
         CreateFramebuffers();
         CreateTexture();
         CreateSkybox();
         
         CreateGraphicsPipeline();
         CreateSkyboxPipeline();
+        CreateVoxelPipeline();
 
+        CreateVoxelDrawBuffers();
+        CreateVoxelCuller();
         CreateDescriptorPool();
         CreateDescriptorSets();
         CreateCommands();
@@ -202,6 +371,23 @@ namespace BRQ {
         skybox.Load();
     }
 
+    void Renderer::SetVoxelTextures(const std::vector<std::string>& filenames) {
+
+        // The descriptor sets of frames still in flight reference the old array.
+        WaitIdle();
+
+        delete m_VoxelTextures;
+        m_VoxelTextures = new TextureArray(filenames);
+
+        for (U32 i = 0; i < FRAME_LAG; i++)
+            UpdateVoxelTextureDescriptors(i);
+    }
+
+    void Renderer::WaitIdle() {
+
+        VK_CHECK(vkDeviceWaitIdle(m_RenderContext->GetDevice()));
+    }
+
     void Renderer::DestroyInternal() {
 
         vkDeviceWaitIdle(m_RenderContext->GetDevice());
@@ -213,10 +399,15 @@ namespace BRQ {
         DestroyCommands();
         DestroyGraphicsPipeline();
         DestroySkyboxPipeline();
+        DestroyVoxelPipeline();
         DestroyDescriptorPool();
+        DestroyVoxelDrawBuffers();
+        DestroyVoxelCuller();
         DestroySkybox();
         DestroyTexture();
         DestroyFramebuffers();
+
+        MeshArena::Shutdown();
         
         RenderContext::Destroy();
     }
@@ -298,6 +489,24 @@ namespace BRQ {
         m_Skybox.Destroy();
     }
 
+    void Renderer::CreateVoxelPipeline() {
+
+        BufferLayout layout;
+        layout.PushElement(ElementType::UVec2);
+
+        GraphicsPipelineCreateInfo info = {};
+        info.Layout = layout;
+        info.Flags = (GraphicsPipelineFlags)(EnableCulling | DepthWriteEnabled | DepthTestEnabled | DepthCompareLess);
+        info.Shaders = { { "Resources/Shaders/voxel.vert.spv" }, { "Resources/Shaders/voxel.frag.spv" } };
+
+        m_VoxelPipeline.Init(info);
+    }
+
+    void Renderer::DestroyVoxelPipeline() {
+
+        m_VoxelPipeline.Destroy();
+    }
+
     void Renderer::CreateCommands() {
 
         for (U64 i = 0; i < FRAME_LAG; i++) {
@@ -361,10 +570,22 @@ namespace BRQ {
         info.PoolSizeCount = 1;
         info.PoolSizes = &size;
 
+        VkDescriptorPoolSize voxelSizes[2] = {};
+        voxelSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        voxelSizes[0].descriptorCount = 1;
+        voxelSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        voxelSizes[1].descriptorCount = 1;
+
+        VK::DescriptorPoolCreateInfo voxelInfo = {};
+        voxelInfo.MaxSets = 1;
+        voxelInfo.PoolSizeCount = 2;
+        voxelInfo.PoolSizes = voxelSizes;
+
         for (U64 i = 0; i < FRAME_LAG; i++) {
 
             m_PerFrameData[i].SkyboxDescriptorPool = VK::CreateDescriptorPool(m_RenderContext->GetDevice(), info);
             m_PerFrameData[i].DescriptorPool = VK::CreateDescriptorPool(m_RenderContext->GetDevice(), info);
+            m_PerFrameData[i].VoxelDescriptorPool = VK::CreateDescriptorPool(m_RenderContext->GetDevice(), voxelInfo);
         }
     }
 
@@ -374,6 +595,7 @@ namespace BRQ {
 
             VK::DestoryDescriptorPool(m_RenderContext->GetDevice(), m_PerFrameData[i].DescriptorPool);
             VK::DestoryDescriptorPool(m_RenderContext->GetDevice(), m_PerFrameData[i].SkyboxDescriptorPool);
+            VK::DestoryDescriptorPool(m_RenderContext->GetDevice(), m_PerFrameData[i].VoxelDescriptorPool);
         }
     }
 
@@ -381,6 +603,20 @@ namespace BRQ {
 
         std::vector<VkDescriptorSetLayout> layouts = m_Pipeline.GetDescriptorSetLayouts();
         std::vector<VkDescriptorSetLayout> skyboxLayouts =  m_Skybox.GetDescriptorSetLayouts();
+        std::vector<VkDescriptorSetLayout> voxelLayouts = m_VoxelPipeline.GetDescriptorSetLayouts();
+
+        for (U32 i = 0; i < FRAME_LAG; i++) {
+
+            VK::DescriptorSetAllocateInfo info = {};
+            info.DescriptorPool = m_PerFrameData[i].VoxelDescriptorPool;
+            info.DescriptorSetCount = (U32)voxelLayouts.size();
+            info.SetLayouts = voxelLayouts.data();
+
+            m_PerFrameData[i].VoxelDescriptorSets = VK::AllocateDescriptorSets(m_RenderContext->GetDevice(), info);
+
+            UpdateVoxelTextureDescriptors(i);
+            UpdateVoxelDrawDescriptors(i);
+        }
 
         for (U64 i = 0; i < FRAME_LAG; i++) {
 
@@ -439,14 +675,89 @@ namespace BRQ {
         }
     }
 
+    void Renderer::UpdateVoxelTextureDescriptors(U32 frame) {
+
+        VkDescriptorImageInfo imageInfo = {};
+        imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        imageInfo.imageView = m_VoxelTextures->GetImageView();
+        imageInfo.sampler = m_VoxelTextures->GetSampler();
+
+        VkWriteDescriptorSet descriptorWrites = {};
+        descriptorWrites.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites.dstSet = m_PerFrameData[frame].VoxelDescriptorSets[0];
+        descriptorWrites.dstBinding = 0;
+        descriptorWrites.dstArrayElement = 0;
+        descriptorWrites.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptorWrites.descriptorCount = 1;
+        descriptorWrites.pImageInfo = &imageInfo;
+
+        vkUpdateDescriptorSets(m_RenderContext->GetDevice(), 1, &descriptorWrites, 0, nullptr);
+    }
+
+    void Renderer::UpdateVoxelDrawDescriptors(U32 frame) {
+
+        const IndirectDrawBuffer& draws = m_PerFrameData[frame].VoxelDraws;
+
+        VkDescriptorBufferInfo bufferInfo = {};
+        bufferInfo.buffer = draws.GetDrawDataBuffer().Buffer;
+        bufferInfo.offset = 0;
+        bufferInfo.range = draws.GetDrawDataSize();
+
+        VkWriteDescriptorSet descriptorWrites = {};
+        descriptorWrites.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites.dstSet = m_PerFrameData[frame].VoxelDescriptorSets[0];
+        descriptorWrites.dstBinding = 1;
+        descriptorWrites.dstArrayElement = 0;
+        descriptorWrites.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptorWrites.descriptorCount = 1;
+        descriptorWrites.pBufferInfo = &bufferInfo;
+
+        vkUpdateDescriptorSets(m_RenderContext->GetDevice(), 1, &descriptorWrites, 0, nullptr);
+    }
+
+    void Renderer::CreateVoxelDrawBuffers() {
+
+        // Grows on demand, enough for a few thousand sections to start with.
+        for (U32 i = 0; i < FRAME_LAG; i++)
+            m_PerFrameData[i].VoxelDraws.Init(sizeof(VoxelDrawData), 4096);
+    }
+
+    void Renderer::DestroyVoxelDrawBuffers() {
+
+        for (U32 i = 0; i < FRAME_LAG; i++)
+            m_PerFrameData[i].VoxelDraws.Destroy();
+    }
+
+    void Renderer::CreateVoxelCuller() {
+
+        // Culled draws keep their first instance to find their draw data. The result is drawn with the count the
+        // compute shader wrote when possible, with one multi draw over every slot otherwise.
+        m_GpuCullingSupported = m_RenderContext->IsDrawIndirectFirstInstanceEnabled() &&
+            (m_RenderContext->IsDrawIndirectCountEnabled() || m_RenderContext->IsMultiDrawIndirectEnabled());
+        m_GpuCulling = m_GpuCullingSupported;
+
+        if (m_GpuCullingSupported)
+            m_VoxelCuller.Init(m_RenderContext->IsDrawIndirectCountEnabled());
+        else
+            BRQ_CORE_WARN("GPU culling unavailable, voxel meshes are culled on the CPU.");
+    }
+
+    void Renderer::DestroyVoxelCuller() {
+
+        if (m_GpuCullingSupported)
+            m_VoxelCuller.Destroy();
+    }
+
     void Renderer::CreateTexture() {
 
         m_Texture2D = new Texture2D("Resources/Textures/Lion.jpg");
+        m_VoxelTextures = new TextureArray(std::vector<std::string>());
     }
 
     void Renderer::DestroyTexture() {
 
         delete m_Texture2D;
+        delete m_VoxelTextures;
     }
 
     void Renderer::CreateSkybox() {
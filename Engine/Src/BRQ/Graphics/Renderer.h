@@ -3,9 +3,13 @@
 #include "Events/Event.h"
 #include "Camera/Camera.h"
 #include "Texture2D.h"
+#include "TextureArray.h"
 #include "TextureCube.h"
 #include "Platform/Vulkan/RenderContext.h"
 #include "GraphicsPipeline.h"
+#include "Mesh.h"
+#include "IndirectDrawBuffer.h"
+#include "DrawCuller.h"
 
 namespace BRQ {
 
@@ -22,6 +26,44 @@ namespace BRQ {
         VkDescriptorPool             SkyboxDescriptorPool;
         std::vector<VkDescriptorSet> DescriptorSets;
         std::vector<VkDescriptorSet> SkyboxDescriptorSets;
+
+        VkDescriptorPool             VoxelDescriptorPool;
+        std::vector<VkDescriptorSet> VoxelDescriptorSets;
+        IndirectDrawBuffer           VoxelDraws;
+        // Whether the last EndScene of this frame culled its voxel draws on the GPU.
+        bool                         VoxelDrawsCulled;
+    };
+
+    // Per draw data of voxel meshes, the layout of DrawData in voxel.vert.
+    struct VoxelDrawData {
+
+        glm::vec3 Origin;
+        U32       Lod;
+    };
+
+    // Voxel meshes to draw this frame with their world space bounds, kept as structure of arrays for batched frustum culling.
+    class VoxelDrawList {
+
+    private:
+        std::vector<const Mesh*> m_Meshes;
+        std::vector<glm::vec3>   m_Origins;
+        std::vector<U32>         m_Lods;
+        AABBList                 m_Bounds;
+
+    public:
+        VoxelDrawList() = default;
+        ~VoxelDrawList() = default;
+
+        void Clear();
+        // Empty meshes are skipped.
+        void Add(const Mesh& mesh, const glm::vec3& origin, U32 lod = 0);
+
+        U32 GetCount() const { return (U32)m_Meshes.size(); }
+
+        const Mesh& GetMesh(U32 index) const { return *m_Meshes[index]; }
+        const glm::vec3& GetOrigin(U32 index) const { return m_Origins[index]; }
+        U32 GetLod(U32 index) const { return m_Lods[index]; }
+        const AABBList& GetBounds() const { return m_Bounds; }
     };
 
     class Renderer {
@@ -34,9 +76,27 @@ namespace BRQ {
         
         Texture2D*                                                  m_Texture2D;
         TextureCube*                                                m_TextureCube;
+        // Every voxel material in one image, the vertex picks the layer.
+        TextureArray*                                               m_VoxelTextures;
 
         GraphicsPipeline                                            m_Pipeline;
         GraphicsPipeline                                            m_Skybox;
+        GraphicsPipeline                                            m_VoxelPipeline;
+
+        glm::mat4                                                   m_ViewProjection;
+        Frustum                                                     m_Frustum;
+
+        std::vector<U32>                                            m_VisibleMeshes;
+        // Voxel draws of the current scene, drawn with a single indirect draw at EndScene.
+        std::vector<VkDrawIndexedIndirectCommand>                   m_VoxelCommands;
+        std::vector<VoxelDrawData>                                  m_VoxelDrawData;
+
+        // Frustum culling of voxel draws on the compute queue, replacing the CPU test when the device supports it.
+        DrawCuller                                                  m_VoxelCuller;
+        std::vector<DrawBounds>                                     m_VoxelBounds;
+        bool                                                        m_GpuCullingSupported;
+        bool                                                        m_GpuCulling;
+        U32                                                         m_GpuVisibleVoxelMeshes;
 
         PerFrame                                                    m_PerFrameData[FRAME_LAG];
         std::vector<VkFramebuffer>                                  m_Framebuffers;
@@ -58,14 +118,46 @@ namespace BRQ {
 
         //void Submit();
 
+        // Draws a mesh of BRQ::VoxelVertex with its local positions offset by origin, unless it is outside the camera frustum.
+        // Only valid between BeginScene and EndScene. Voxel meshes are batched and drawn together at EndScene, with GPU
+        // culling enabled the frustum test happens there as well.
+        void SubmitVoxelMesh(const Mesh& mesh, const glm::vec3& origin, U32 lod = 0);
+        // Same for every mesh of the list, culled 4 or 8 at a time.
+        void SubmitVoxelMeshes(const VoxelDrawList& drawList);
+
+        // Frustum of the camera passed to the last BeginScene.
+        const Frustum& GetFrustum() const { return m_Frustum; }
+
+        // Voxel meshes that passed culling since the last BeginScene, with GPU culling every submitted mesh.
+        U32 GetDrawnVoxelMeshCount() const { return (U32)m_VoxelCommands.size(); }
+
+        // Culls voxel meshes with a compute shader instead of on the CPU. Needs drawIndirectFirstInstance and either
+        // drawIndirectCount or multiDrawIndirect, enabling it without them has no effect.
+        void SetGpuCulling(bool enabled) { m_GpuCulling = enabled && m_GpuCullingSupported; }
+        bool IsGpuCullingEnabled() const { return m_GpuCulling; }
+        bool IsGpuCullingSupported() const { return m_GpuCullingSupported; }
+
+        // Voxel meshes the GPU found visible, read back from the frame FRAME_LAG frames before the current one.
+        U32 GetGpuVisibleVoxelMeshCount() const { return m_GpuVisibleVoxelMeshes; }
+
+        // Replaces the voxel textures with one array layer per file, in order. Layer indices are the ones voxel vertices
+        // carry. Waits for the GPU, meant for startup. Until called, voxels use a single placeholder layer.
+        void SetVoxelTextures(const std::vector<std::string>& filenames);
+
         void Present();
 
+        // Blocks until the GPU has finished all submitted frames.
+        void WaitIdle();
+
     private:
         void InitInternal(const Window* window);
         void DestroyInternal();
 
         void RecreateSwapchain();
 
+        void AddVoxelDraw(const Mesh& mesh, const glm::vec3& origin, U32 lod);
+        void DrawVoxelMeshes();
+
         void CreateFramebuffers();
         void DestroyFramebuffers();
 
@@ -75,6 +167,9 @@ namespace BRQ {
         void CreateSkyboxPipeline();
         void DestroySkyboxPipeline();
 
+        void CreateVoxelPipeline();
+        void DestroyVoxelPipeline();
+
         void CreateCommands();
         void DestroyCommands();
 
@@ -85,6 +180,14 @@ namespace BRQ {
         void DestroyDescriptorPool();
 
         void CreateDescriptorSets();
+        void UpdateVoxelDrawDescriptors(U32 frame);
+        void UpdateVoxelTextureDescriptors(U32 frame);
+
+        void CreateVoxelDrawBuffers();
+        void DestroyVoxelDrawBuffers();
+
+        void CreateVoxelCuller();
+        void DestroyVoxelCuller();
 
         // this is temp
         void CreateTexture();
@@ -168,9 +168,9 @@ namespace BRQ {
         VK::SamplerCreateInfo info = {};
         info.MagFilter = VK_FILTER_LINEAR;
         info.MinFilter = VK_FILTER_LINEAR;
-        info.AddressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
-        info.AddressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
-        info.AddressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        info.AddressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        info.AddressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        info.AddressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
         info.AnisotropyEnable = VK_TRUE;
         info.MaxAnisotropy = properties.limits.maxSamplerAnisotropy;
         info.BorderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
@@ -0,0 +1,292 @@
+#include <BRQ.h>
+#include "TextureArray.h"
+
+#include <bit>
+
+#include <stb_image.h>
+
+#include "Platform/Vulkan/RenderContext.h"
+
+namespace BRQ {
+
+    static const U32 s_FallbackSize = 16;
+
+    static bool IsPowerOfTwo(U32 value) { return value && !(value & (value - 1)); }
+
+    // Magenta and black, hard to miss in the world.
+    static void FillCheckerboard(BYTE* pixels, U32 size) {
+
+        for (U32 y = 0; y < size; y++) {
+
+            for (U32 x = 0; x < size; x++) {
+
+                bool magenta = ((x * 2 / size) ^ (y * 2 / size)) & 1;
+
+                BYTE* pixel = pixels + (x + y * size) * 4;
+                pixel[0] = magenta ? 255 : 0;
+                pixel[1] = 0;
+                pixel[2] = magenta ? 255 : 0;
+                pixel[3] = 255;
+            }
+        }
+    }
+
+    // Averages every 2x2 block of source into one pixel of the next smaller level.
+    static void DownsampleLevel(const BYTE* source, U32 sourceSize, BYTE* destination) {
+
+        U32 size = sourceSize / 2;
+
+        for (U32 y = 0; y < size; y++) {
+
+            for (U32 x = 0; x < size; x++) {
+
+                const BYTE* row0 = source + (x * 2 + y * 2 * sourceSize) * 4;
+                const BYTE* row1 = row0 + sourceSize * 4;
+
+                for (U32 channel = 0; channel < 4; channel++)
+                    destination[(x + y * size) * 4 + channel] = (BYTE)((row0[channel] + row0[channel + 4] + row1[channel] + row1[channel + 4] + 2) / 4);
+            }
+        }
+    }
+
+    TextureArray::TextureArray()
+        : m_Sampler(VK_NULL_HANDLE), m_Size(0), m_LayerCount(0), m_MipLevels(0) { }
+
+    TextureArray::TextureArray(const std::vector<std::string>& filenames)
+        : m_Sampler(VK_NULL_HANDLE), m_Size(0), m_LayerCount(0), m_MipLevels(0) {
+
+        LoadTextures(filenames);
+    }
+
+    TextureArray::~TextureArray() {
+
+        auto context = RenderContext::GetInstance();
+
+        VK::DestroyImageView(context->GetDevice(), m_ImageView);
+        VK::DestroyImage(m_Image);
+
+        DestroySampler();
+    }
+
+    void TextureArray::LoadTextures(const std::vector<std::string>& filenames) {
+
+        m_LayerCount = std::max((U32)filenames.size(), 1U);
+
+        stbi_set_flip_vertically_on_load(true);
+
+        std::vector<stbi_uc*> images(filenames.size(), nullptr);
+
+        for (U64 i = 0; i < filenames.size(); i++) {
+
+            I32 width;
+            I32 height;
+            I32 channels;
+
+            images[i] = stbi_load(filenames[i].c_str(), &width, &height, &channels, STBI_rgb_alpha);
+
+            if (!images[i]) {
+
+                BRQ_CORE_WARN("Can't load texture: {}", filenames[i].c_str());
+                continue;
+            }
+
+            if (!m_Size && width == height && IsPowerOfTwo((U32)width))
+                m_Size = (U32)width;
+
+            if ((U32)width != m_Size || (U32)height != m_Size) {
+
+                BRQ_CORE_WARN("Texture {} is {}x{}, texture array layers have to be {}x{}.", filenames[i].c_str(), width, height, m_Size, m_Size);
+
+                stbi_image_free(images[i]);
+                images[i] = nullptr;
+            }
+        }
+
+        if (!m_Size)
+            m_Size = s_FallbackSize;
+
+        m_MipLevels = (U32)std::bit_width(m_Size);
+
+        // Staged level by level, every level holds all layers back to back so one copy region fills a whole level.
+        std::vector<VkDeviceSize> levelOffsets(m_MipLevels);
+        VkDeviceSize size = 0;
+
+        for (U32 level = 0; level < m_MipLevels; level++) {
+
+            U32 levelSize = m_Size >> level;
+
+            levelOffsets[level] = size;
+            size += (VkDeviceSize)levelSize * levelSize * 4 * m_LayerCount;
+        }
+
+        auto vma = VulkanMemoryAllocator::GetInstance();
+
+        VK::BufferCreateInfo bufferInfo = {};
+        bufferInfo.Size = size;
+        bufferInfo.Usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        bufferInfo.SharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        bufferInfo.MemoryUsage = VMA_MEMORY_USAGE_CPU_ONLY;
+
+        VK::Buffer buffer = VK::CreateBuffer(bufferInfo);
+
+        BYTE* data = (BYTE*)vma->MapMemory(buffer);
+
+        for (U32 layer = 0; layer < m_LayerCount; layer++) {
+
+            VkDeviceSize layerSize = (VkDeviceSize)m_Size * m_Size * 4;
+            BYTE* pixels = data + layerSize * layer;
+
+            if (layer < images.size() && images[layer])
+                memcpy(pixels, images[layer], layerSize);
+            else
+                FillCheckerboard(pixels, m_Size);
+
+            for (U32 level = 1; level < m_MipLevels; level++) {
+
+                U32 sourceSize = m_Size >> (level - 1);
+                U32 levelSize = m_Size >> level;
+
+                BYTE* source = data + levelOffsets[level - 1] + (VkDeviceSize)sourceSize * sourceSize * 4 * layer;
+                BYTE* destination = data + levelOffsets[level] + (VkDeviceSize)levelSize * levelSize * 4 * layer;
+
+                DownsampleLevel(source, sourceSize, destination);
+            }
+        }
+
+        vma->UnMapMemory(buffer);
+
+        for (stbi_uc* image : images)
+            stbi_image_free(image);
+
+        VK::ImageCreateInfo imageInfo = {};
+        imageInfo.ImageType = VK_IMAGE_TYPE_2D;
+        imageInfo.Format = VK_FORMAT_R8G8B8A8_UNORM;
+        imageInfo.Extent = { m_Size, m_Size, 1U };
+        imageInfo.MipLevels = m_MipLevels;
+        imageInfo.ArrayLayers = m_LayerCount;
+        imageInfo.Samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.Tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.Usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.SharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.InitialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.MemoryUsage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+        m_Image = VK::CreateImage(imageInfo);
+
+        auto context = RenderContext::GetInstance();
+
+        VK::CommandPoolCreateInfo poolInfo = {};
+        poolInfo.Flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolInfo.QueueFamilyIndex = context->GetGraphicsQueueIndex();
+
+        VkCommandPool pool = VK::CreateCommandPool(context->GetDevice(), poolInfo);
+
+        VK::CommandBufferAllocateInfo allocateInfo = {};
+        allocateInfo.CommandPool = pool;
+        allocateInfo.Level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocateInfo.CommandBufferCount = 1;
+
+        auto cmd = VK::AllocateCommandBuffers(context->GetDevice(), allocateInfo);
+
+        VK::ImageLayoutTransitionInfo transition = {};
+        transition.Image = m_Image.Image;
+        transition.Format = imageInfo.Format;
+        transition.OldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        transition.NewLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        transition.CommandBuffer = cmd[0];
+        transition.SubresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        transition.SubresourceRange.baseMipLevel = 0;
+        transition.SubresourceRange.levelCount = m_MipLevels;
+        transition.SubresourceRange.baseArrayLayer = 0;
+        transition.SubresourceRange.layerCount = m_LayerCount;
+
+        VK::CommandBufferBeginInfo beginInfo = {};
+        beginInfo.CommandBuffer = cmd[0];
+        beginInfo.Flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        VK::CommandBufferBegin(beginInfo);
+
+        VK::ImageLayoutTransition(transition);
+
+        std::vector<VkBufferImageCopy> copyRegions(m_MipLevels);
+
+        for (U32 level = 0; level < m_MipLevels; level++) {
+
+            VkBufferImageCopy& region = copyRegions[level];
+            region = {};
+            region.bufferOffset = levelOffsets[level];
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = level;
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount = m_LayerCount;
+            region.imageExtent = { m_Size >> level, m_Size >> level, 1U };
+        }
+
+        vkCmdCopyBufferToImage(cmd[0], buffer.Buffer, m_Image.Image,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (U32)copyRegions.size(), copyRegions.data());
+
+        transition.OldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        transition.NewLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        VK::ImageLayoutTransition(transition);
+
+        VK::CommandBufferEnd(cmd[0]);
+
+        VK::QueueSubmitInfo submitInfo = {};
+        submitInfo.CommandBufferCount = 1;
+        submitInfo.CommandBuffers = &cmd[0];
+        submitInfo.Queue = context->GetGraphicsQueue();
+
+        VK::QueueSubmit(submitInfo);
+        VK::QueueWaitIdle(context->GetGraphicsQueue());
+
+        VK::DestroyCommandPool(context->GetDevice(), pool);
+        VK::DestoryBuffer(buffer);
+
+        VK::ImageViewCreateInfo viewInfo = {};
+        viewInfo.Image = m_Image.Image;
+        viewInfo.ViewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        viewInfo.Format = imageInfo.Format;
+        viewInfo.SubresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.SubresourceRange.baseMipLevel = 0;
+        viewInfo.SubresourceRange.levelCount = m_MipLevels;
+        viewInfo.SubresourceRange.baseArrayLayer = 0;
+        viewInfo.SubresourceRange.layerCount = m_LayerCount;
+
+        m_ImageView = VK::CreateImageView(context->GetDevice(), viewInfo);
+
+        CreateSampler();
+
+        BRQ_CORE_INFO("Texture array: {} layers of {}x{}, {} mip levels.", m_LayerCount, m_Size, m_Size, m_MipLevels);
+    }
+
+    void TextureArray::CreateSampler() {
+
+        auto context = RenderContext::GetInstance();
+
+        // Nearest up close keeps pixel art sharp, mips filter it smoothly in the distance.
+        VK::SamplerCreateInfo info = {};
+        info.MagFilter = VK_FILTER_NEAREST;
+        info.MinFilter = VK_FILTER_LINEAR;
+        info.AddressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        info.AddressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        info.AddressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        info.AnisotropyEnable = context->IsSamplerAnisotropyEnabled() ? VK_TRUE : VK_FALSE;
+        info.MaxAnisotropy = context->IsSamplerAnisotropyEnabled() ? context->GetSamplerMaxAnisotropy() : 1.0f;
+        info.BorderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+        info.UnnormalizedCoordinates = VK_FALSE;
+        info.CompareEnable = VK_FALSE;
+        info.CompareOp = VK_COMPARE_OP_NEVER;
+        info.MipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+        info.MinLod = 0.0f;
+        info.MaxLod = (F32)m_MipLevels;
+
+        m_Sampler = VK::CreateSampler(context->GetDevice(), info);
+    }
+
+    void TextureArray::DestroySampler() {
+
+        auto context = RenderContext::GetInstance();
+
+        VK::DestroySampler(context->GetDevice(), m_Sampler);
+    }
+}
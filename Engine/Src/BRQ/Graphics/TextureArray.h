@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Platform/Vulkan/VulkanHelpers.h"
+
+namespace BRQ {
+
+    // Square textures of one size packed into the layers of a single 2D array image, each with a full mip chain.
+    // Lets many materials be drawn with one descriptor set, the layer is picked per vertex.
+    class TextureArray {
+
+    private:
+        VK::Image     m_Image;
+        VK::ImageView m_ImageView;
+        VkSampler     m_Sampler;
+        U32           m_Size;
+        U32           m_LayerCount;
+        U32           m_MipLevels;
+
+    public:
+        TextureArray();
+        TextureArray(const std::vector<std::string>& filenames);
+        ~TextureArray();
+
+        VK::ImageView GetImageView() const { return m_ImageView; };
+
+        VkSampler GetSampler() const { return m_Sampler; }
+
+        U32 GetTextureSize() const { return m_Size; }
+        U32 GetLayerCount() const { return m_LayerCount; }
+        U32 GetMipLevels() const { return m_MipLevels; }
+
+        // Layer i is filenames[i]. The first readable file sets the size, every layer has to match it and be a power of
+        // two. Files that can't be used get a checkerboard layer instead, so layer indices never shift.
+        void LoadTextures(const std::vector<std::string>& filenames);
+
+    private:
+        void CreateSampler();
+        void DestroySampler();
+    };
+}
@@ -0,0 +1,237 @@
+#include <BRQ.h>
+
+#include "Frustum.h"
+
+#include <bit>
+
+#ifdef BRQ_FRUSTUM_X86
+    #include <emmintrin.h>
+
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #endif
+#endif
+
+namespace BRQ {
+
+    void AABBList::Clear() {
+
+        m_MinX.clear();
+        m_MinY.clear();
+        m_MinZ.clear();
+        m_MaxX.clear();
+        m_MaxY.clear();
+        m_MaxZ.clear();
+    }
+
+    void AABBList::Reserve(U32 count) {
+
+        m_MinX.reserve(count);
+        m_MinY.reserve(count);
+        m_MinZ.reserve(count);
+        m_MaxX.reserve(count);
+        m_MaxY.reserve(count);
+        m_MaxZ.reserve(count);
+    }
+
+    void AABBList::Add(const glm::vec3& min, const glm::vec3& max) {
+
+        m_MinX.push_back(min.x);
+        m_MinY.push_back(min.y);
+        m_MinZ.push_back(min.z);
+        m_MaxX.push_back(max.x);
+        m_MaxY.push_back(max.y);
+        m_MaxZ.push_back(max.z);
+    }
+
+    namespace FrustumKernels {
+
+        U32 CullScalar(const glm::vec4* planes, const AABBList& boxes, U32 begin, U32 end, U32* visible) {
+
+            U32 count = 0;
+
+            for (U32 i = begin; i < end; i++) {
+
+                bool inside = true;
+
+                // The box corner furthest along the plane normal decides, it is behind the plane only if the whole box is.
+                for (U32 p = 0; p < 6 && inside; p++) {
+
+                    const glm::vec4& plane = planes[p];
+
+                    F32 x = plane.x >= 0.0f ? boxes.GetMaxX()[i] : boxes.GetMinX()[i];
+                    F32 y = plane.y >= 0.0f ? boxes.GetMaxY()[i] : boxes.GetMinY()[i];
+                    F32 z = plane.z >= 0.0f ? boxes.GetMaxZ()[i] : boxes.GetMinZ()[i];
+
+                    inside = plane.x * x + plane.y * y + plane.z * z + plane.w >= 0.0f;
+                }
+
+                if (inside)
+                    visible[count++] = i;
+            }
+
+            return count;
+        }
+
+#ifdef BRQ_FRUSTUM_X86
+        U32 CullSSE(const glm::vec4* planes, const AABBList& boxes, U32 begin, U32 end, U32* visible) {
+
+            // Which side of each box a plane looks at is the same for every box, so it is picked once per plane.
+            const F32* corners[6][3];
+
+            for (U32 p = 0; p < 6; p++) {
+
+                corners[p][0] = planes[p].x >= 0.0f ? boxes.GetMaxX() : boxes.GetMinX();
+                corners[p][1] = planes[p].y >= 0.0f ? boxes.GetMaxY() : boxes.GetMinY();
+                corners[p][2] = planes[p].z >= 0.0f ? boxes.GetMaxZ() : boxes.GetMinZ();
+            }
+
+            const __m128 zero = _mm_setzero_ps();
+
+            U32 count = 0;
+
+            for (U32 i = begin; i < end; i += 4) {
+
+                __m128 inside = _mm_cmpeq_ps(zero, zero);
+
+                for (U32 p = 0; p < 6; p++) {
+
+                    // Summed in the same order as the scalar test so both agree on boxes touching a plane.
+                    __m128 distance = _mm_mul_ps(_mm_set1_ps(planes[p].x), _mm_loadu_ps(corners[p][0] + i));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes[p].y), _mm_loadu_ps(corners[p][1] + i)));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes[p].z), _mm_loadu_ps(corners[p][2] + i)));
+                    distance = _mm_add_ps(distance, _mm_set1_ps(planes[p].w));
+
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, zero));
+                }
+
+                for (U32 bits = (U32)_mm_movemask_ps(inside); bits; bits &= bits - 1)
+                    visible[count++] = i + (U32)std::countr_zero(bits);
+            }
+
+            return count;
+        }
+#endif
+    }
+
+    static bool CpuSupportsAVX() {
+
+#if defined(BRQ_FRUSTUM_X86) && defined(_MSC_VER)
+        I32 info[4];
+
+        __cpuid(info, 1);
+
+        // The OS has to save the YMM registers as well.
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+
+        return osxsave && avx && (_xgetbv(0) & 6) == 6;
+#elif defined(BRQ_FRUSTUM_X86) && defined(__GNUC__)
+        return __builtin_cpu_supports("avx");
+#else
+        return false;
+#endif
+    }
+
+    static FrustumCulling DetectCulling() {
+
+#ifdef BRQ_FRUSTUM_X86
+        return CpuSupportsAVX() ? FrustumCulling::AVX : FrustumCulling::SSE;
+#else
+        return FrustumCulling::Scalar;
+#endif
+    }
+
+    FrustumCulling Frustum::s_Culling = DetectCulling();
+
+    Frustum::Frustum() {
+
+        // Accepts everything until real planes are set.
+        for (glm::vec4& plane : m_Planes)
+            plane = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+
+    Frustum::Frustum(const glm::mat4& viewProjection) {
+
+        glm::vec4 rows[4];
+
+        for (U32 i = 0; i < 4; i++)
+            rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+
+        m_Planes[0] = rows[3] + rows[0];
+        m_Planes[1] = rows[3] - rows[0];
+        m_Planes[2] = rows[3] + rows[1];
+        m_Planes[3] = rows[3] - rows[1];
+        m_Planes[4] = rows[2];
+        m_Planes[5] = rows[3] - rows[2];
+
+        for (glm::vec4& plane : m_Planes)
+            plane /= glm::length(glm::vec3(plane));
+    }
+
+    bool Frustum::Intersects(const glm::vec3& min, const glm::vec3& max) const {
+
+        for (const glm::vec4& plane : m_Planes) {
+
+            glm::vec3 corner(plane.x >= 0.0f ? max.x : min.x, plane.y >= 0.0f ? max.y : min.y, plane.z >= 0.0f ? max.z : min.z);
+
+            if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+                return false;
+        }
+
+        return true;
+    }
+
+    U32 Frustum::Cull(const AABBList& boxes, U32* visible) const {
+
+        U32 count = boxes.GetCount();
+        U32 done = 0;
+        U32 visibleCount = 0;
+
+#ifdef BRQ_FRUSTUM_X86
+        if (s_Culling == FrustumCulling::AVX) {
+
+            done = count & ~7u;
+            visibleCount = FrustumKernels::CullAVX(m_Planes, boxes, 0, done, visible);
+        }
+        else if (s_Culling == FrustumCulling::SSE) {
+
+            done = count & ~3u;
+            visibleCount = FrustumKernels::CullSSE(m_Planes, boxes, 0, done, visible);
+        }
+#endif
+
+        return visibleCount + FrustumKernels::CullScalar(m_Planes, boxes, done, count, visible + visibleCount);
+    }
+
+    bool Frustum::IsSupported(FrustumCulling culling) {
+
+        switch (culling) {
+
+            case FrustumCulling::Scalar:    return true;
+#ifdef BRQ_FRUSTUM_X86
+            case FrustumCulling::SSE:       return true;
+            case FrustumCulling::AVX:       return CpuSupportsAVX();
+#endif
+            default:                        return false;
+        }
+    }
+
+    void Frustum::SetCulling(FrustumCulling culling) {
+
+        BRQ_ASSERT(IsSupported(culling));
+
+        s_Culling = culling;
+    }
+
+    const char* Frustum::GetCullingName(FrustumCulling culling) {
+
+        switch (culling) {
+
+            case FrustumCulling::Scalar:    return "Scalar";
+            case FrustumCulling::SSE:       return "SSE";
+            case FrustumCulling::AVX:       return "AVX";
+            default:                        return "Unknown";
+        }
+    }
+}
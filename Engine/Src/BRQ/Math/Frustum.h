@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+
+#include "Math/Math.h"
+#include "Utilities/Types.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #define BRQ_FRUSTUM_X86
+#endif
+
+namespace BRQ {
+
+    // Axis aligned boxes kept as structure of arrays, so the culling kernels load 4 or 8 boxes per instruction.
+    class AABBList {
+
+    private:
+        std::vector<F32> m_MinX;
+        std::vector<F32> m_MinY;
+        std::vector<F32> m_MinZ;
+        std::vector<F32> m_MaxX;
+        std::vector<F32> m_MaxY;
+        std::vector<F32> m_MaxZ;
+
+    public:
+        AABBList() = default;
+        ~AABBList() = default;
+
+        void Clear();
+        void Reserve(U32 count);
+        void Add(const glm::vec3& min, const glm::vec3& max);
+
+        U32 GetCount() const { return (U32)m_MinX.size(); }
+
+        const F32* GetMinX() const { return m_MinX.data(); }
+        const F32* GetMinY() const { return m_MinY.data(); }
+        const F32* GetMinZ() const { return m_MinZ.data(); }
+        const F32* GetMaxX() const { return m_MaxX.data(); }
+        const F32* GetMaxY() const { return m_MaxY.data(); }
+        const F32* GetMaxZ() const { return m_MaxZ.data(); }
+    };
+
+    enum class FrustumCulling : U8 {
+
+        Scalar = 0,
+        SSE,
+        AVX,
+    };
+
+    class Frustum {
+
+    private:
+        static FrustumCulling s_Culling;
+
+        // Left, right, bottom, top, near and far as (normal, distance) with normals pointing inside.
+        glm::vec4             m_Planes[6];
+
+    public:
+        Frustum();
+        // Extracts the planes from a projection * view matrix with depth in [0, 1] (Gribb & Hartmann).
+        explicit Frustum(const glm::mat4& viewProjection);
+        ~Frustum() = default;
+
+        // Conservative, boxes near a frustum corner may pass while being outside.
+        bool Intersects(const glm::vec3& min, const glm::vec3& max) const;
+
+        // Writes the indices of the boxes that intersect the frustum to visible, in order, and returns how many there are.
+        // visible must hold boxes.GetCount() indices.
+        U32 Cull(const AABBList& boxes, U32* visible) const;
+
+        const glm::vec4* GetPlanes() const { return m_Planes; }
+
+        static bool IsSupported(FrustumCulling culling);
+        static void SetCulling(FrustumCulling culling);
+        static FrustumCulling GetCulling() { return s_Culling; }
+        static const char* GetCullingName(FrustumCulling culling);
+    };
+
+    namespace FrustumKernels {
+
+        // Test the boxes in [begin, end), append visible indices and return how many were appended.
+        U32 CullScalar(const glm::vec4* planes, const AABBList& boxes, U32 begin, U32 end, U32* visible);
+
+#ifdef BRQ_FRUSTUM_X86
+        // end - begin has to be a multiple of the vector width.
+        U32 CullSSE(const glm::vec4* planes, const AABBList& boxes, U32 begin, U32 end, U32* visible);
+        U32 CullAVX(const glm::vec4* planes, const AABBList& boxes, U32 begin, U32 end, U32* visible);
+#endif
+    }
+}
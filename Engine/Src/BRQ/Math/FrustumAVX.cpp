@@ -0,0 +1,57 @@
+#include <BRQ.h>
+
+#include "Frustum.h"
+
+#ifdef BRQ_FRUSTUM_X86
+
+// MSVC accepts AVX intrinsics without /arch:AVX, GCC and Clang need the target enabled for this file.
+// Nothing here runs unless Frustum detected AVX support.
+#if defined(__GNUC__) && !defined(__AVX__)
+    #pragma GCC target("avx")
+#endif
+
+#include <immintrin.h>
+
+#include <bit>
+
+namespace BRQ { namespace FrustumKernels {
+
+    U32 CullAVX(const glm::vec4* planes, const AABBList& boxes, U32 begin, U32 end, U32* visible) {
+
+        const F32* corners[6][3];
+
+        for (U32 p = 0; p < 6; p++) {
+
+            corners[p][0] = planes[p].x >= 0.0f ? boxes.GetMaxX() : boxes.GetMinX();
+            corners[p][1] = planes[p].y >= 0.0f ? boxes.GetMaxY() : boxes.GetMinY();
+            corners[p][2] = planes[p].z >= 0.0f ? boxes.GetMaxZ() : boxes.GetMinZ();
+        }
+
+        const __m256 zero = _mm256_setzero_ps();
+
+        U32 count = 0;
+
+        for (U32 i = begin; i < end; i += 8) {
+
+            __m256 inside = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+
+            for (U32 p = 0; p < 6; p++) {
+
+                // Summed in the same order as the scalar test so both agree on boxes touching a plane.
+                __m256 distance = _mm256_mul_ps(_mm256_set1_ps(planes[p].x), _mm256_loadu_ps(corners[p][0] + i));
+                distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes[p].y), _mm256_loadu_ps(corners[p][1] + i)));
+                distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes[p].z), _mm256_loadu_ps(corners[p][2] + i)));
+                distance = _mm256_add_ps(distance, _mm256_set1_ps(planes[p].w));
+
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, zero, _CMP_GE_OQ));
+            }
+
+            for (U32 bits = (U32)_mm256_movemask_ps(inside); bits; bits &= bits - 1)
+                visible[count++] = i + (U32)std::countr_zero(bits);
+        }
+
+        return count;
+    }
+} }
+
+#endif
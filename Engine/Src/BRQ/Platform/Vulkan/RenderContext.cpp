@@ -81,6 +81,17 @@ namespace BRQ {
         m_Swapchain.Destroy(m_Device);
     }
 
+    std::vector<U32> RenderContext::GetGraphicsAndComputeQueueIndices() const {
+
+        U32 graphics = m_Device.GetGraphicsQueueIndex();
+        U32 compute = m_Device.GetComputeQueueIndex();
+
+        if (graphics == compute)
+            return { graphics };
+
+        return { graphics, compute };
+    }
+
     VkResult RenderContext::AcquireImageIndex(const VkSemaphore& imageAvailableSemaphore) {
 
         U32 index = -1;
@@ -52,6 +52,9 @@ namespace BRQ {
         U32 GetComputeQueueIndex() const { return m_Device.GetComputeQueueIndex(); }
         U32 GetTransferQueueIndex() const { return m_Device.GetTransferQueueIndex(); }
 
+        // Families of buffers used by both graphics and compute work, with two the buffers need concurrent sharing.
+        std::vector<U32> GetGraphicsAndComputeQueueIndices() const;
+
         const VkExtent2D& GetSwapchainExtent2D() const { return m_Swapchain.GetSwapchainExtent2D(); }
 
         const VkSurfaceFormatKHR& GetSurfaceFormat() const { return m_Device.GetSurfaceFormat(); }
@@ -65,6 +68,13 @@ namespace BRQ {
         U32 GetCurrentIndex() const { return m_CurrentIndex; }
         U32 GetImageCount() const { return m_Device.GetSurfaceImageCount(); }
 
+        bool IsSamplerAnisotropyEnabled() const { return m_Device.IsSamplerAnisotropyEnabled(); }
+        F32 GetSamplerMaxAnisotropy() const { return m_Device.GetSamplerMaxAnisotropy(); }
+
+        bool IsMultiDrawIndirectEnabled() const { return m_Device.IsMultiDrawIndirectEnabled(); }
+        bool IsDrawIndirectFirstInstanceEnabled() const { return m_Device.IsDrawIndirectFirstInstanceEnabled(); }
+        bool IsDrawIndirectCountEnabled() const { return m_Device.IsDrawIndirectCountEnabled(); }
+
         const VkRenderPass& GetRenderPass() const { return m_RenderPass; }
 
         void UpdateSwapchain();
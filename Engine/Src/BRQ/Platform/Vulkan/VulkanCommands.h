@@ -25,4 +25,15 @@ namespace BRQ { namespace VK {
 
         vkCmdEndRenderPass(commandBuffer);
     }
+
+    // A global memory barrier, enough for buffers whose queue family ownership never changes.
+    static void CommandPipelineBarrier(const VkCommandBuffer& commandBuffer, VkPipelineStageFlags sourceStage, VkAccessFlags sourceAccess, VkPipelineStageFlags destinationStage, VkAccessFlags destinationAccess) {
+
+        VkMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = sourceAccess;
+        barrier.dstAccessMask = destinationAccess;
+
+        vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
 } }
\ No newline at end of file
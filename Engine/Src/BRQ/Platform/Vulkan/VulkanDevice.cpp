@@ -23,6 +23,9 @@ namespace BRQ {
         m_SurfaceTransform = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
         m_SamplerMaxAnisotropy = 0.0f;
         m_SamplerAnisotropyEnabled = false;
+        m_MultiDrawIndirectEnabled = false;
+        m_DrawIndirectFirstInstanceEnabled = false;
+        m_DrawIndirectCountEnabled = false;
         m_ImageCount = 0;
     }
 
@@ -95,8 +98,20 @@ namespace BRQ {
             deviceFeatures.samplerAnisotropy = VK_TRUE;
         }
 
+        m_MultiDrawIndirectEnabled = features.multiDrawIndirect;
+        m_DrawIndirectFirstInstanceEnabled = features.drawIndirectFirstInstance;
+        m_DrawIndirectCountEnabled = VK::GetPhysicalDeviceVulkan12Features(m_PhysicalDevice).drawIndirectCount;
+
+        deviceFeatures.multiDrawIndirect = features.multiDrawIndirect;
+        deviceFeatures.drawIndirectFirstInstance = features.drawIndirectFirstInstance;
+
+        VkPhysicalDeviceVulkan12Features features12 = {};
+        features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        features12.drawIndirectCount = m_DrawIndirectCountEnabled;
+
         VK::DeviceCreateInfo info = {};
         info.EnabledFeatures = deviceFeatures;
+        info.Next = &features12;
 
         m_Device = VK::CreateDevice(m_PhysicalDevice, m_Surface, info);
     }
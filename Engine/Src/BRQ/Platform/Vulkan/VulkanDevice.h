@@ -31,6 +31,10 @@ namespace BRQ {
         F32                           m_SamplerMaxAnisotropy;
         bool                          m_SamplerAnisotropyEnabled;
 
+        bool                          m_MultiDrawIndirectEnabled;
+        bool                          m_DrawIndirectFirstInstanceEnabled;
+        bool                          m_DrawIndirectCountEnabled;
+
         U32                           m_ImageCount;
 
     public:
@@ -65,6 +69,14 @@ namespace BRQ {
 
         U32 GetSurfaceImageCount() const { return m_ImageCount; }
 
+        bool IsSamplerAnisotropyEnabled() const { return m_SamplerAnisotropyEnabled; }
+        F32 GetSamplerMaxAnisotropy() const { return m_SamplerMaxAnisotropy; }
+
+        // Optional indirect drawing features, enabled whenever the physical device has them.
+        bool IsMultiDrawIndirectEnabled() const { return m_MultiDrawIndirectEnabled; }
+        bool IsDrawIndirectFirstInstanceEnabled() const { return m_DrawIndirectFirstInstanceEnabled; }
+        bool IsDrawIndirectCountEnabled() const { return m_DrawIndirectCountEnabled; }
+
     private:
         void CreateVulkanInstance();
         void DestroyVulkanInstance();
@@ -203,43 +203,51 @@ namespace BRQ { namespace VK {
         std::vector<VkQueueFamilyProperties> queues(queueCount);
         vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueCount, &queues[0]);
 
-        // This is a VERY NAIVE way to find unique queues
-        // Nvidia supports Async Compute and Async Transfer queue from Pascal Arch
-        // It turns out these cards have only 3 Queue Families
-        // Queue Family = 0; supports Graphics, Compute and Transfer
-        // Queue Family = 1; supports Transfer
-        // Queue Family = 2; supports Compute and Transfer
+        // Async queues prefer a family of their own, Nvidia has one with only Compute and Transfer and one with only
+        // Transfer since Pascal. Devices without them, like software implementations exposing a single family, share
+        // the Graphics family; callers must not assume the returned families differ.
+        U32 graphics = VK_QUEUE_FAMILY_IGNORED;
 
-        BRQ_ASSERT(queueCount >= 3);
+        for (U32 i = 0; i < queueCount; i++) {
 
-        if (type == QueueType::Graphics) {
-
-            if (queues[0].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+            if (!(queues[i].queueFlags & VK_QUEUE_GRAPHICS_BIT))
+                continue;
 
-                VkBool32 presentSupport = false;
-                vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, 0, surface, &presentSupport);
+            VkBool32 presentSupport = false;
+            vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
 
-                if (presentSupport) {
+            if (presentSupport) {
 
-                    return 0;
-                }
+                graphics = i;
+                break;
             }
         }
+
+        if (type == QueueType::Graphics || graphics == VK_QUEUE_FAMILY_IGNORED) {
+
+            return graphics;
+        }
         else if (type == QueueType::AsyncTransfer) {
 
-            if (queues[1].queueFlags & VK_QUEUE_TRANSFER_BIT) {
+            for (U32 i = 0; i < queueCount; i++) {
 
-                return 1;
-                
+                if ((queues[i].queueFlags & VK_QUEUE_TRANSFER_BIT) && !(queues[i].queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+                    return i;
             }
+
+            return graphics;
         }
         else if (type == QueueType::AsyncCompute) {
 
-            if (queues[2].queueFlags & VK_QUEUE_TRANSFER_BIT) {
+            for (U32 i = 0; i < queueCount; i++) {
 
-                return 2;
+                if ((queues[i].queueFlags & VK_QUEUE_COMPUTE_BIT) && !(queues[i].queueFlags & VK_QUEUE_GRAPHICS_BIT))
+                    return i;
             }
+
+            return graphics;
         }
+
         return VK_QUEUE_FAMILY_IGNORED;
     }
 
@@ -259,6 +267,22 @@ namespace BRQ { namespace VK {
         return features;
     }
 
+    VkPhysicalDeviceVulkan12Features GetPhysicalDeviceVulkan12Features(const VkPhysicalDevice& physicalDevice) {
+
+        VkPhysicalDeviceVulkan12Features features12 = {};
+        features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+        VkPhysicalDeviceFeatures2 features = {};
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features.pNext = &features12;
+
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+        features12.pNext = nullptr;
+
+        return features12;
+    }
+
     VkPhysicalDevice SeletePhysicalDevice(const VkInstance& instance, const VkSurfaceKHR& surface) {
 
         U32 deviceCount = 0;
@@ -289,11 +313,15 @@ namespace BRQ { namespace VK {
             if (props.apiVersion < VK_API_VERSION_1_2)
                 continue;
 
+            // Discrete GPUs first, anything else only when there is none, e.g. software rasterizers on GPU-less hosts.
             if (props.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
 
                 physicalDevice = device;
                 break;
             }
+
+            if (!physicalDevice)
+                physicalDevice = device;
         }
 
         if (physicalDevice) {
@@ -305,7 +333,7 @@ namespace BRQ { namespace VK {
         }
         else {
 
-            BRQ_CORE_FATAL("Can't Select Discrete GPU!");
+            BRQ_CORE_FATAL("Can't Select Physical Device!");
             BRQ_CORE_ASSERT(false);
         }
 
@@ -324,6 +352,10 @@ namespace BRQ { namespace VK {
         queueIndices.push_back(GetQueueFamilyIndex(physicalDevice, surface, QueueType::AsyncCompute));
         queueIndices.push_back(GetQueueFamilyIndex(physicalDevice, surface, QueueType::AsyncTransfer));
 
+        // Families shared between queue types get a single queue, which every type then uses.
+        std::sort(queueIndices.begin(), queueIndices.end());
+        queueIndices.erase(std::unique(queueIndices.begin(), queueIndices.end()), queueIndices.end());
+
         F32 priority = 1.0f;
 
         for (U32 queueFamily : queueIndices) {
@@ -344,6 +376,7 @@ namespace BRQ { namespace VK {
         deviceCreateInfo.queueCreateInfoCount = (U32)queueCreateInfos.size();
         deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
         deviceCreateInfo.pEnabledFeatures = &info.EnabledFeatures;
+        deviceCreateInfo.pNext = info.Next;
 
 #ifdef BRQ_DEBUG
         layers.push_back("VK_LAYER_KHRONOS_validation");
@@ -792,6 +825,31 @@ namespace BRQ { namespace VK {
         }
     }
 
+    VkPipeline CreateComputePipeline(const VkDevice& device, const ComputePipelineCreateInfo& info) {
+
+        VkComputePipelineCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        createInfo.flags = info.Flags;
+        createInfo.stage = info.Stage;
+        createInfo.layout = info.Layout;
+        createInfo.basePipelineIndex = -1;
+
+        VkPipeline pipeline = VK_NULL_HANDLE;
+
+        VK_CHECK(vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, &pipeline));
+
+        return pipeline;
+    }
+
+    void DestroyComputePipeline(const VkDevice& device, VkPipeline& pipeline) {
+
+        if (pipeline) {
+
+            vkDestroyPipeline(device, pipeline, nullptr);
+            pipeline = VK_NULL_HANDLE;
+        }
+    }
+
     void DestroyGraphicsPipelines(const VkDevice& device, std::vector<VkPipeline>& pipelines) {
 
         for (auto& pipeline : pipelines) {
@@ -871,7 +929,7 @@ namespace BRQ { namespace VK {
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
         submitInfo.waitSemaphoreCount = info.WaitSemaphoreCount;
         submitInfo.pWaitSemaphores = info.WaitSemaphores;
-        submitInfo.pWaitDstStageMask = &info.WaitDstStageMask;
+        submitInfo.pWaitDstStageMask = info.WaitDstStageMasks;
         submitInfo.commandBufferCount = info.CommandBufferCount;
         submitInfo.pCommandBuffers = info.CommandBuffers;
         submitInfo.signalSemaphoreCount = info.SignalSemaphoreCount;
@@ -81,6 +81,8 @@ namespace BRQ { namespace VK {
         std::vector<const char*> EnabledLayerNames = {};
         std::vector<const char*> EnabledExtensionNames = {};
         VkPhysicalDeviceFeatures EnabledFeatures = {};
+        // Chain of feature structures for features newer than VkPhysicalDeviceFeatures.
+        const void*              Next = nullptr;
     };
 
     BRQ_ALIGN(16) struct SwapchainCreateInfo {
@@ -236,6 +238,13 @@ namespace BRQ { namespace VK {
         U32                                          BasePipelineIndex = 0;
     };
 
+    BRQ_ALIGN(16) struct ComputePipelineCreateInfo {
+
+        VkPipelineCreateFlags           Flags = {};
+        VkPipelineShaderStageCreateInfo Stage = {};
+        VkPipelineLayout                Layout = VK_NULL_HANDLE;
+    };
+
     BRQ_ALIGN(16) struct SemaphoreCreateInfo {
 
         VkSemaphoreCreateFlags Flags = {};
@@ -248,15 +257,16 @@ namespace BRQ { namespace VK {
 
     BRQ_ALIGN(16) struct QueueSubmitInfo {
     
-        U32                    WaitSemaphoreCount = 0;
-        const VkSemaphore*     WaitSemaphores = VK_NULL_HANDLE;
-        VkPipelineStageFlags   WaitDstStageMask = {};
-        U32                    CommandBufferCount = 0;
-        const VkCommandBuffer* CommandBuffers = VK_NULL_HANDLE;
-        U32                    SignalSemaphoreCount = 0;
-        const VkSemaphore*     SignalSemaphores = VK_NULL_HANDLE;
-        VkQueue                Queue = VK_NULL_HANDLE;
-        VkFence                CommandBufferExecutedFence = VK_NULL_HANDLE;
+        U32                         WaitSemaphoreCount = 0;
+        const VkSemaphore*          WaitSemaphores = VK_NULL_HANDLE;
+        // One stage mask per wait semaphore.
+        const VkPipelineStageFlags* WaitDstStageMasks = VK_NULL_HANDLE;
+        U32                         CommandBufferCount = 0;
+        const VkCommandBuffer*      CommandBuffers = VK_NULL_HANDLE;
+        U32                         SignalSemaphoreCount = 0;
+        const VkSemaphore*          SignalSemaphores = VK_NULL_HANDLE;
+        VkQueue                     Queue = VK_NULL_HANDLE;
+        VkFence                     CommandBufferExecutedFence = VK_NULL_HANDLE;
     };
 
     BRQ_ALIGN(16) struct CommandPoolCreateInfo {
@@ -371,6 +381,7 @@ namespace BRQ { namespace VK {
 
     VkPhysicalDeviceProperties GetPhysicalDeviceProperties(const VkPhysicalDevice& physicalDevice);
     VkPhysicalDeviceFeatures GetPhysicalDeviceFeatures(const VkPhysicalDevice& physicalDevice);
+    VkPhysicalDeviceVulkan12Features GetPhysicalDeviceVulkan12Features(const VkPhysicalDevice& physicalDevice);
 
     VkPhysicalDevice SeletePhysicalDevice(const VkInstance& instance, const VkSurfaceKHR& surface);
 
@@ -412,6 +423,9 @@ namespace BRQ { namespace VK {
     VkPipeline CreateGraphicsPipeline(const VkDevice& device, const GraphicsPipelineCreateInfo info = {});
     void DestroyGraphicsPipeline(const VkDevice& device, VkPipeline& pipeline);
 
+    VkPipeline CreateComputePipeline(const VkDevice& device, const ComputePipelineCreateInfo& info = {});
+    void DestroyComputePipeline(const VkDevice& device, VkPipeline& pipeline);
+
     std::vector<VkPipeline> CreateGraphicsPipelines(const VkDevice& device, const std::vector<GraphicsPipelineCreateInfo>& infos = {});
     void DestroyGraphicsPipelines(const VkDevice& device, std::vector<VkPipeline>& pipelines);
 
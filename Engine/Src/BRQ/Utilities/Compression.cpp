@@ -0,0 +1,171 @@
+#include <BRQ.h>
+
+#include "Compression.h"
+
+namespace BRQ { namespace Utilities { namespace Compression {
+
+    static constexpr U32 MIN_MATCH  = 4;
+    static constexpr U32 MAX_OFFSET = 65535;
+    static constexpr U32 HASH_BITS  = 12;
+
+    static U32 Read32(const BYTE* data) {
+
+        U32 value;
+        std::memcpy(&value, data, sizeof(value));
+
+        return value;
+    }
+
+    static U32 HashSequence(U32 sequence) {
+
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    static void WriteLength(std::vector<BYTE>& output, U64 length) {
+
+        while (length >= 255) {
+
+            output.push_back(255);
+            length -= 255;
+        }
+
+        output.push_back((BYTE)length);
+    }
+
+    static void WriteSequence(std::vector<BYTE>& output, const BYTE* literals, U64 literalCount, U32 offset, U64 matchLength) {
+
+        U64 matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+
+        output.push_back((BYTE)((std::min<U64>(literalCount, 15) << 4) | std::min<U64>(matchCode, 15)));
+
+        if (literalCount >= 15)
+            WriteLength(output, literalCount - 15);
+
+        output.insert(output.end(), literals, literals + literalCount);
+
+        // The final sequence carries literals only.
+        if (!matchLength)
+            return;
+
+        output.push_back((BYTE)(offset & 0xFF));
+        output.push_back((BYTE)(offset >> 8));
+
+        if (matchCode >= 15)
+            WriteLength(output, matchCode - 15);
+    }
+
+    void Compress(const BYTE* data, U64 size, std::vector<BYTE>& output) {
+
+        output.clear();
+        output.reserve(GetMaxCompressedSize(size));
+
+        // Positions are stored plus one so zero means empty.
+        std::vector<U32> table((U64)1 << HASH_BITS, 0);
+
+        U64 anchor = 0;
+        U64 position = 0;
+
+        while (position + MIN_MATCH <= size) {
+
+            U32 sequence = Read32(data + position);
+            U32& entry = table[HashSequence(sequence)];
+
+            U64 candidate = entry;
+            entry = (U32)(position + 1);
+
+            if (!candidate || position - (candidate - 1) > MAX_OFFSET || Read32(data + candidate - 1) != sequence) {
+
+                position++;
+                continue;
+            }
+
+            U64 match = candidate - 1;
+            U64 length = MIN_MATCH;
+
+            while (position + length < size && data[match + length] == data[position + length])
+                length++;
+
+            WriteSequence(output, data + anchor, position - anchor, (U32)(position - match), length);
+
+            position += length;
+            anchor = position;
+        }
+
+        WriteSequence(output, data + anchor, size - anchor, 0, 0);
+    }
+
+    static bool ReadLength(const BYTE*& input, const BYTE* end, U64& length) {
+
+        BYTE value;
+
+        do {
+
+            if (input >= end)
+                return false;
+
+            value = *input++;
+            length += value;
+        } while (value == 255);
+
+        return true;
+    }
+
+    bool Decompress(const BYTE* data, U64 size, BYTE* output, U64 outputSize) {
+
+        const BYTE* input = data;
+        const BYTE* inputEnd = data + size;
+
+        U64 written = 0;
+
+        while (input < inputEnd) {
+
+            BYTE token = *input++;
+
+            U64 literalCount = token >> 4;
+
+            if (literalCount == 15 && !ReadLength(input, inputEnd, literalCount))
+                return false;
+
+            if (literalCount > (U64)(inputEnd - input) || literalCount > outputSize - written)
+                return false;
+
+            std::memcpy(output + written, input, literalCount);
+            input += literalCount;
+            written += literalCount;
+
+            if (input == inputEnd)
+                break;
+
+            if (inputEnd - input < 2)
+                return false;
+
+            U64 offset = input[0] | ((U64)input[1] << 8);
+            input += 2;
+
+            U64 matchLength = token & 0xF;
+
+            if (matchLength == 15 && !ReadLength(input, inputEnd, matchLength))
+                return false;
+
+            matchLength += MIN_MATCH;
+
+            if (offset == 0 || offset > written || matchLength > outputSize - written)
+                return false;
+
+            // Matches may overlap the bytes they produce, copy forwards one at a time.
+            BYTE* source = output + written - offset;
+
+            for (U64 i = 0; i < matchLength; i++)
+                output[written + i] = source[i];
+
+            written += matchLength;
+        }
+
+        return written == outputSize;
+    }
+
+    U64 GetMaxCompressedSize(U64 size) {
+
+        return size + size / 255 + 16;
+    }
+} } }
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <BRQ.h>
+
+namespace BRQ { namespace Utilities {
+
+    // Byte oriented LZ77 in the spirit of LZ4: sequences of literals followed by a match of at
+    // least 4 bytes within the last 64KB. Fast to decode and needs no dictionary or entropy stage.
+    namespace Compression {
+
+        void Compress(const BYTE* data, U64 size, std::vector<BYTE>& output);
+
+        // Returns false on corrupt input or when the data does not decode to exactly outputSize bytes.
+        bool Decompress(const BYTE* data, U64 size, BYTE* output, U64 outputSize);
+
+        U64 GetMaxCompressedSize(U64 size);
+    }
+} }
@@ -0,0 +1,84 @@
+#include <BRQ.h>
+
+#include "MappedFile.h"
+
+namespace BRQ { namespace Utilities {
+
+    MappedFile::MappedFile()
+        : m_File(nullptr), m_Mapping(nullptr), m_Data(nullptr), m_Size(0) { }
+
+    MappedFile::~MappedFile() {
+
+        Close();
+    }
+
+    bool MappedFile::Open(const std::string_view& path) {
+
+        Close();
+
+        m_Path = path;
+
+        m_File = CreateFileA(m_Path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                             nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (m_File == INVALID_HANDLE_VALUE) {
+
+            m_File = nullptr;
+            BRQ_CORE_WARN("Can't open file: {}", m_Path.c_str());
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        GetFileSizeEx(m_File, &size);
+
+        m_Size = size.QuadPart;
+
+        // Empty files can't be mapped, they simply have no data.
+        if (m_Size == 0)
+            return true;
+
+        m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (!m_Mapping) {
+
+            BRQ_CORE_WARN("Can't map file: {}", m_Path.c_str());
+            Close();
+            return false;
+        }
+
+        m_Data = (const BYTE*)MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0);
+
+        if (!m_Data) {
+
+            BRQ_CORE_WARN("Can't map view of file: {}", m_Path.c_str());
+            Close();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool MappedFile::Remap() {
+
+        std::string path = m_Path;
+
+        return Open(path);
+    }
+
+    void MappedFile::Close() {
+
+        if (m_Data)
+            UnmapViewOfFile(m_Data);
+
+        if (m_Mapping)
+            CloseHandle(m_Mapping);
+
+        if (m_File)
+            CloseHandle(m_File);
+
+        m_File = nullptr;
+        m_Mapping = nullptr;
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+} }
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <BRQ.h>
+
+namespace BRQ { namespace Utilities {
+
+    // Read only view of a whole file. Other handles may keep writing to the file,
+    // Remap picks up data written past the end of the current view.
+    class MappedFile {
+
+    private:
+        std::string m_Path;
+        HANDLE      m_File;
+        HANDLE      m_Mapping;
+        const BYTE* m_Data;
+        U64         m_Size;
+
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool Open(const std::string_view& path);
+        bool Remap();
+        void Close();
+
+        bool IsOpen() const { return m_File != nullptr; }
+
+        const BYTE* GetData() const { return m_Data; }
+        U64 GetSize() const { return m_Size; }
+    };
+} }
@@ -0,0 +1,91 @@
+#include <BRQ.h>
+
+#include "RangeAllocator.h"
+
+namespace BRQ { namespace Utilities {
+
+    RangeAllocator::RangeAllocator()
+        : m_Capacity(0), m_Used(0) { }
+
+    void RangeAllocator::Reset(U64 capacity) {
+
+        m_FreeRanges.clear();
+
+        if (capacity)
+            m_FreeRanges[0] = capacity;
+
+        m_Capacity = capacity;
+        m_Used = 0;
+    }
+
+    bool RangeAllocator::Allocate(U64 size, U64& offset) {
+
+        if (size == 0 || size > GetFree())
+            return false;
+
+        for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end(); ++it) {
+
+            if (it->second < size)
+                continue;
+
+            offset = it->first;
+
+            U64 remaining = it->second - size;
+            m_FreeRanges.erase(it);
+
+            if (remaining)
+                m_FreeRanges[offset + size] = remaining;
+
+            m_Used += size;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void RangeAllocator::Free(U64 offset, U64 size) {
+
+        if (size == 0)
+            return;
+
+        BRQ_CORE_ASSERT(offset + size <= m_Capacity && size <= m_Used);
+
+        m_Used -= size;
+
+        auto next = m_FreeRanges.lower_bound(offset);
+
+        BRQ_CORE_ASSERT(next == m_FreeRanges.end() || next->first >= offset + size);
+
+        if (next != m_FreeRanges.end() && next->first == offset + size) {
+
+            size += next->second;
+            next = m_FreeRanges.erase(next);
+        }
+
+        if (next != m_FreeRanges.begin()) {
+
+            auto previous = std::prev(next);
+
+            BRQ_CORE_ASSERT(previous->first + previous->second <= offset);
+
+            if (previous->first + previous->second == offset) {
+
+                previous->second += size;
+                return;
+            }
+        }
+
+        m_FreeRanges[offset] = size;
+    }
+
+    U64 RangeAllocator::GetLargestFreeRange() const {
+
+        U64 largest = 0;
+
+        for (const auto& [offset, size] : m_FreeRanges)
+            largest = std::max(largest, size);
+
+        return largest;
+    }
+} }
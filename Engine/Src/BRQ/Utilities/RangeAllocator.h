@@ -0,0 +1,35 @@
+#pragma once
+
+#include <BRQ.h>
+
+#include <map>
+
+namespace BRQ { namespace Utilities {
+
+    // Hands out ranges of [0, capacity) from a free list ordered by offset, first fit. Freed ranges are merged
+    // with free neighbours so the list only holds the gaps between live ranges. Units are up to the caller.
+    class RangeAllocator {
+
+    private:
+        // Offset to size of every free range.
+        std::map<U64, U64> m_FreeRanges;
+        U64                m_Capacity;
+        U64                m_Used;
+
+    public:
+        RangeAllocator();
+        ~RangeAllocator() = default;
+
+        // Frees everything.
+        void Reset(U64 capacity);
+
+        bool Allocate(U64 size, U64& offset);
+        void Free(U64 offset, U64 size);
+
+        U64 GetCapacity() const { return m_Capacity; }
+        U64 GetUsed() const { return m_Used; }
+        U64 GetFree() const { return m_Capacity - m_Used; }
+        U64 GetFreeRangeCount() const { return m_FreeRanges.size(); }
+        U64 GetLargestFreeRange() const;
+    };
+} }
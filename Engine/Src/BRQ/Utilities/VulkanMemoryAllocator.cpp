@@ -54,6 +54,16 @@ namespace BRQ {
         vmaUnmapMemory(m_Allocator, info.Allocation);
     }
 
+    void VulkanMemoryAllocator::FlushMemory(const BufferInfo& info, VkDeviceSize offset, VkDeviceSize size) {
+
+        vmaFlushAllocation(m_Allocator, info.Allocation, offset, size);
+    }
+
+    void VulkanMemoryAllocator::InvalidateMemory(const BufferInfo& info, VkDeviceSize offset, VkDeviceSize size) {
+
+        vmaInvalidateAllocation(m_Allocator, info.Allocation, offset, size);
+    }
+
     VulkanMemoryAllocator::BufferInfo VulkanMemoryAllocator::CreateBuffer(const VkBufferCreateInfo& createInfo, const VmaAllocationCreateInfo& allocInfo) {
 
         BufferInfo bufferInfo = {};
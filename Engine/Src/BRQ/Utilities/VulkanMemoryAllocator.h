@@ -45,6 +45,10 @@ namespace BRQ {
 
         void* MapMemory(const BufferInfo& info);
         void UnMapMemory(const BufferInfo& info);
+        // Makes host writes to mapped memory visible to the device, a no-op for host coherent memory.
+        void FlushMemory(const BufferInfo& info, VkDeviceSize offset, VkDeviceSize size);
+        // Makes device writes visible to host reads of mapped memory, a no-op for host coherent memory.
+        void InvalidateMemory(const BufferInfo& info, VkDeviceSize offset, VkDeviceSize size);
 
         static VulkanMemoryAllocator* GetInstance() { return s_Instance; }
 
@@ -6,6 +6,9 @@
 #include "BRQ/Core/Base.h"
 
 #include "BRQ/Utilities/Types.h"
+#include "BRQ/Utilities/FileSystem.h"
+#include "BRQ/Utilities/MappedFile.h"
+#include "BRQ/Utilities/Compression.h"
 
 #include "BRQ/Application/Window.h"
 #include "BRQ/Application/Application.h"
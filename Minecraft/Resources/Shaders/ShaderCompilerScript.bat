@@ -1,3 +1,5 @@
 
 @ECHO "Compling Shaders!"
-for %%i in (*.vert *.frag *.tesc *.tese *.geom *.comp) do "glslangValidator.exe" -V "%%~i" -o "%%~i.spv"
\ No newline at end of file
+pushd "%~dp0"
+for %%i in (*.vert *.frag *.tesc *.tese *.geom *.comp) do "glslangValidator.exe" -V "%%~i" -o "%%~i.spv"
+popd
\ No newline at end of file
@@ -0,0 +1,16 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(location = 0) out vec4 outColor;
+
+layout(location = 0) in vec2 texCoords;
+layout(location = 1) in flat uint layer;
+layout(location = 2) in float shade;
+
+// Every block texture, one layer each. Layers are assigned by MC::BlockRegistry.
+layout(binding = 0) uniform sampler2DArray textureSampler;
+
+void main() {
+
+    outColor = vec4(texture(textureSampler, vec3(texCoords, float(layer))).rgb * shade, 1.0f);
+}
@@ -0,0 +1,58 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+// Decodes BRQ::VoxelVertex, see Graphics/Mesh.h for the bit layout.
+layout(location = 0) in uvec2 inVertex;
+
+layout(location = 0) out vec2 outTexCoords;
+layout(location = 1) out flat uint outLayer;
+layout(location = 2) out float outShade;
+
+layout (push_constant) uniform constants {
+
+    mat4 u_VP;
+    
+} PushConstants;
+
+// BRQ::VoxelDrawData, one per draw. Every draw passes its index as the first instance.
+struct DrawData {
+
+    vec3 Origin;
+    uint Lod;
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer Draws {
+
+    DrawData u_Draws[];
+};
+
+// Same order as MC::BlockFace: Front, Back, Left, Right, Top, Bottom.
+const float c_FaceShade[6] = float[](0.8f, 0.8f, 0.7f, 0.7f, 1.0f, 0.5f);
+
+// Texture U/V axes of every face, matching the BlockData face tables.
+const vec3 c_FaceU[6] = vec3[](vec3(1, 0, 0), vec3(-1, 0, 0), vec3(0, 0, 1), vec3(0, 0, -1), vec3(1, 0, 0), vec3(1, 0, 0));
+const vec3 c_FaceV[6] = vec3[](vec3(0, 1, 0), vec3(0, 1, 0), vec3(0, 1, 0), vec3(0, 1, 0), vec3(0, 0, -1), vec3(0, 0, 1));
+
+void main() {
+
+    uint data = inVertex.x;
+
+    vec3 position = vec3(data & 63u, (data >> 6) & 63u, (data >> 12) & 63u);
+    uint face = (data >> 18) & 7u;
+    float ao = float((data >> 21) & 3u) / 3.0f;
+
+    uint skyLight = (inVertex.y >> 16) & 15u;
+    uint blockLight = (inVertex.y >> 20) & 15u;
+
+    DrawData draw = u_Draws[gl_InstanceIndex];
+
+    gl_Position = PushConstants.u_VP * vec4(position - 0.5f + draw.Origin, 1.0f);
+
+    // Merged quads span several blocks, deriving UVs from the position tiles the texture once per block.
+    outTexCoords = vec2(dot(position, c_FaceU[face]), dot(position, c_FaceV[face]));
+    outLayer = inVertex.y & 0xFFFFu;
+    // Every light level darkens by a fifth, fully dark faces keep a little ambient light.
+    float light = max(pow(0.8f, float(15u - max(skyLight, blockLight))), 0.05f);
+
+    outShade = c_FaceShade[face] * (0.4f + 0.6f * ao) * light;
+}
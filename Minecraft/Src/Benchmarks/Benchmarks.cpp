@@ -0,0 +1,19 @@
+#include "Benchmarks.h"
+
+namespace MC { namespace Benchmarks {
+
+    void RunAll() {
+
+        RunMeshingBenchmark();
+        RunMeshingBackendBenchmark();
+        RunTerrainBenchmark();
+        RunGenerationScalingBenchmark(16);
+        RunPopulationBenchmark();
+        RunLightingBenchmark();
+        RunLodBenchmark();
+        RunCullingBenchmark();
+        RunOcclusionBenchmark();
+        RunCollisionBenchmark();
+        RunChunkCacheBenchmark();
+    }
+} }
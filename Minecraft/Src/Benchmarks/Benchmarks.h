@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Engine.h>
+
+namespace MC { namespace Benchmarks {
+
+    // Logs vertex and triangle counts of the culled and greedy meshers for the reference chunks.
+    void RunMeshingBenchmark();
+
+    // Checks that both greedy meshing backends produce identical meshes and logs their timings.
+    void RunMeshingBackendBenchmark();
+
+    // Logs single threaded terrain generation throughput for every supported noise SIMD level.
+    void RunTerrainBenchmark();
+
+    // Generates a gridSize x gridSize area on the generation workers with every thread count from 1 to the hardware
+    // threads, logs chunks per second and scaling efficiency, and checks every chunk against single threaded generation.
+    // Needs no window or GPU, see --benchmark-generation.
+    void RunGenerationScalingBenchmark(U32 gridSize = 32);
+
+    // Logs the cost of populating chunks with trees and ore veins, and checks that populating the same chunks in
+    // another order places exactly the same blocks.
+    void RunPopulationBenchmark();
+
+    // Logs the cost of lighting new chunks and of the incremental relight after typical block edits,
+    // and checks the incremental result against lighting everything from scratch.
+    void RunLightingBenchmark();
+
+    // Logs triangle counts and meshing times per level of detail, and the triangles of whole view distances with and without LOD.
+    void RunLodBenchmark();
+
+    // Logs the cost of frustum culling every section of a large world for every supported SIMD level,
+    // and checks the SIMD kernels against the scalar test.
+    void RunCullingBenchmark();
+
+    // Logs the cost of computing section connectivity and how many frustum visible sections the cave culling walk
+    // reaches from the surface and from underground.
+    void RunOcclusionBenchmark();
+
+    // Logs the cost of moving many walking and falling entities through generated terrain with the voxel collider,
+    // and checks that none of them ends up inside a block.
+    void RunCollisionBenchmark();
+
+    // Logs how well unloaded chunks compress in the chunk cache, the cost of compressing them and of reading blocks
+    // back, and checks that chunks come back unchanged and that eviction keeps the most recently used.
+    void RunChunkCacheBenchmark();
+
+    void RunAll();
+} }
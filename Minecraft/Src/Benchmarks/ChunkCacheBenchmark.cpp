@@ -0,0 +1,164 @@
+#include "Benchmarks.h"
+
+#include <random>
+
+#include "../World/Generation/TerrainGenerator.h"
+#include "../World/Storage/ChunkCache.h"
+
+namespace MC { namespace Benchmarks {
+
+    static const I32 s_Radius = 4;
+    static const U32 s_ReadCount = 1000000;
+
+    void RunChunkCacheBenchmark() {
+
+        const I32 size = s_Radius * 2 + 1;
+
+        BRQ_INFO("Chunk cache benchmark ({} chunks)", size * size);
+
+        TerrainGenerator generator;
+        std::vector<Chunk> chunks(size * size);
+
+        for (I32 z = 0; z < size; z++) {
+
+            for (I32 x = 0; x < size; x++) {
+
+                Chunk& chunk = chunks[x + z * size];
+                chunk.SetCoordinate({ x - s_Radius, z - s_Radius });
+                generator.Generate(chunk);
+                chunk.MarkSaved();
+            }
+        }
+
+        ChunkCache cache;
+        cache.Init(nullptr, ~0ULL);
+
+        BRQ::Timer timer;
+
+        for (const Chunk& chunk : chunks)
+            cache.Insert(chunk);
+
+        F32 encodeTime = timer.GetTime();
+
+        const ChunkCacheStatistics& statistics = cache.GetStatistics();
+        const U64 compressedSize = statistics.CompressedSize;
+
+        BRQ_INFO("  {} KB as palettes, {} KB compressed ({}x)", statistics.UncompressedSize / 1024, statistics.CompressedSize / 1024,
+                 (F32)statistics.UncompressedSize / (F32)statistics.CompressedSize);
+        BRQ_INFO("  {}ms per chunk to compress", encodeTime / chunks.size());
+
+        std::mt19937 random(WORLD_SEED);
+        std::uniform_int_distribution<I32> chunkDistribution(-s_Radius, s_Radius);
+        std::uniform_int_distribution<U32> xz(0, CHUNK_WIDTH - 1);
+        std::uniform_int_distribution<U32> y(0, CHUNK_HEIGHT - 1);
+
+        U32 mismatches = 0;
+
+        // A read decompresses at most the one section it falls in, and only when that section wasn't read recently.
+        for (U32 pass = 0; pass < 2; pass++) {
+
+            const U32 readsPerChunk = pass == 0 ? s_ReadCount / (U32)chunks.size() : 1;
+            const U32 reads = pass == 0 ? readsPerChunk * (U32)chunks.size() : s_ReadCount / 100;
+            const U64 decodes = statistics.SectionDecodes;
+
+            timer.Reset();
+
+            for (U32 read = 0; read < reads; read += readsPerChunk) {
+
+                ChunkCoordinate coordinate = { chunkDistribution(random), chunkDistribution(random) };
+                const Chunk& chunk = chunks[(coordinate.X + s_Radius) + (coordinate.Z + s_Radius) * size];
+
+                for (U32 i = 0; i < readsPerChunk; i++) {
+
+                    U32 bx = xz(random);
+                    U32 by = y(random);
+                    U32 bz = xz(random);
+
+                    BlockType type = BlockType::Air;
+                    cache.GetBlock(coordinate, bx, by, bz, type);
+
+                    mismatches += type != chunk.GetBlockType(bx, by, bz);
+                }
+            }
+
+            F32 time = timer.GetTime();
+            U64 sectionDecodes = statistics.SectionDecodes - decodes;
+
+            BRQ_INFO("  GetBlock {}: {}ns per read, {} sections decompressed", pass == 0 ? "within a chunk" : "across chunks",
+                     time * 1000000.0f / reads, sectionDecodes);
+
+            mismatches += sectionDecodes > reads;
+        }
+
+        // Reads that go back and forth between two neighbours at the same height, like lighting or collision along a
+        // chunk border, keep one decompressed section of each.
+        const ChunkCoordinate neighbours[2] = { { 0, 0 }, { 1, 0 } };
+        std::uniform_int_distribution<U32> sectionY(0, SECTION_HEIGHT - 1);
+
+        const U32 baseY = CHUNK_HEIGHT / 4;
+        const U64 decodes = statistics.SectionDecodes;
+
+        timer.Reset();
+
+        for (U32 read = 0; read < s_ReadCount; read++) {
+
+            const ChunkCoordinate& coordinate = neighbours[read & 1];
+            const Chunk& chunk = chunks[(coordinate.X + s_Radius) + (coordinate.Z + s_Radius) * size];
+
+            U32 bx = xz(random);
+            U32 by = baseY + sectionY(random);
+            U32 bz = xz(random);
+
+            BlockType type = BlockType::Air;
+            cache.GetBlock(coordinate, bx, by, bz, type);
+
+            mismatches += type != chunk.GetBlockType(bx, by, bz);
+        }
+
+        F32 alternatingTime = timer.GetTime();
+        U64 alternatingDecodes = statistics.SectionDecodes - decodes;
+
+        BRQ_INFO("  GetBlock alternating between two chunks: {}ns per read, {} sections decompressed", alternatingTime * 1000000.0f / s_ReadCount,
+                 alternatingDecodes);
+
+        mismatches += alternatingDecodes > 2;
+
+        timer.Reset();
+
+        for (const Chunk& original : chunks) {
+
+            Chunk chunk;
+            chunk.SetCoordinate(original.GetCoordinate());
+
+            if (!cache.Take(chunk)) {
+
+                mismatches++;
+                continue;
+            }
+
+            for (U32 by = 0; by < CHUNK_HEIGHT; by++)
+                for (U32 bz = 0; bz < CHUNK_LENGTH; bz++)
+                    for (U32 bx = 0; bx < CHUNK_WIDTH; bx++)
+                        mismatches += chunk.GetBlockType(bx, by, bz) != original.GetBlockType(bx, by, bz);
+
+            mismatches += chunk.IsModified();
+        }
+
+        BRQ_INFO("  {}ms per chunk to decompress and check", timer.GetTime() / chunks.size());
+
+        // Half the budget keeps about the most recently inserted half.
+        for (const Chunk& chunk : chunks)
+            cache.Insert(chunk);
+
+        U64 budget = compressedSize / 2;
+        cache.SetBudget(budget);
+
+        BRQ_INFO("  {} of {} chunks kept under a {} KB budget, {} evicted", statistics.ChunkCount, chunks.size(), budget / 1024, statistics.Evictions);
+
+        if (!cache.Contains(chunks.back().GetCoordinate()) || cache.Contains(chunks.front().GetCoordinate()))
+            mismatches++;
+
+        if (mismatches)
+            BRQ_ERROR("  {} blocks or chunks differ after a round trip through the cache", mismatches);
+    }
+} }
@@ -0,0 +1,115 @@
+#include "Benchmarks.h"
+
+#include <random>
+
+#include "../World/Generation/TerrainGenerator.h"
+#include "../World/Physics/VoxelCollider.h"
+
+namespace MC { namespace Benchmarks {
+
+    static const I32 s_Radius = 2;
+    static const U32 s_EntityCount = 500;
+    static const U32 s_TickCount = 200;
+    static const F32 s_TickTime = 1.0f / 20.0f;
+
+    struct Entity {
+
+        glm::vec3 Position;
+        glm::vec3 Velocity;
+        bool      Grounded;
+    };
+
+    static CollisionBox GetBox(const Entity& entity) {
+
+        return CollisionBox::FromEye(entity.Position, 0.6f, 1.8f, 1.6f);
+    }
+
+    void RunCollisionBenchmark() {
+
+        const I32 size = s_Radius * 2 + 1;
+
+        BRQ_INFO("Collision benchmark ({} entities walking {} ticks over {} chunks)", s_EntityCount, s_TickCount, size * size);
+
+        TerrainGenerator generator;
+        std::vector<Chunk> chunks(size * size);
+
+        for (I32 z = 0; z < size; z++) {
+
+            for (I32 x = 0; x < size; x++) {
+
+                Chunk& chunk = chunks[x + z * size];
+                chunk.SetCoordinate({ x - s_Radius, z - s_Radius });
+                generator.Generate(chunk);
+            }
+        }
+
+        // Outside the generated square counts as solid, so nobody walks off the edge.
+        VoxelCollider collider([&chunks, size](const ChunkCoordinate& coordinate) -> const Chunk* {
+
+            I32 x = coordinate.X + s_Radius;
+            I32 z = coordinate.Z + s_Radius;
+
+            return (x < 0 || z < 0 || x >= size || z >= size) ? nullptr : &chunks[x + z * size];
+        });
+
+        collider.SetUnloadedSolid(true);
+
+        std::mt19937 random(WORLD_SEED);
+        std::uniform_real_distribution<F32> spread(-s_Radius * 16.0f, s_Radius * 16.0f);
+        std::uniform_real_distribution<F32> direction(-1.0f, 1.0f);
+
+        std::vector<Entity> entities(s_EntityCount);
+
+        for (Entity& entity : entities) {
+
+            entity.Position = glm::vec3(spread(random), (F32)CHUNK_HEIGHT - 4.0f, spread(random));
+            entity.Velocity = glm::vec3(direction(random) * 4.0f, 0.0f, direction(random) * 4.0f);
+            entity.Grounded = false;
+        }
+
+        U64 steps = 0;
+        U64 moves = 0;
+        F32 time = 0.0f;
+
+        for (U32 tick = 0; tick < s_TickCount; tick++) {
+
+            BRQ::Timer timer;
+
+            for (Entity& entity : entities) {
+
+                entity.Velocity.y = entity.Grounded ? 0.0f : std::max(entity.Velocity.y - 32.0f * s_TickTime, -60.0f);
+
+                CollisionResult result = collider.Move(GetBox(entity), entity.Velocity * s_TickTime, 1.0f);
+
+                entity.Position += result.Displacement;
+                entity.Grounded = result.Grounded;
+
+                // Turn around at walls that are too high to step onto.
+                if (result.Collided.x)
+                    entity.Velocity.x = -entity.Velocity.x;
+                if (result.Collided.z)
+                    entity.Velocity.z = -entity.Velocity.z;
+
+                steps += result.SteppedUp;
+            }
+
+            time += timer.GetTime();
+            moves += entities.size();
+        }
+
+        U32 grounded = 0;
+        U32 stuck = 0;
+
+        for (const Entity& entity : entities) {
+
+            grounded += entity.Grounded;
+            stuck += collider.Overlaps(GetBox(entity));
+        }
+
+        BRQ_INFO("  {}ms per tick, {}us per move", time / s_TickCount, time * 1000.0f / moves);
+        BRQ_INFO("  {} of {} entities grounded, {} step ups", grounded, s_EntityCount, steps);
+
+        if (stuck)
+            BRQ_ERROR("  {} entities ended inside terrain", stuck);
+    }
+} }
@@ -0,0 +1,98 @@
+#include "Benchmarks.h"
+
+#include <random>
+
+#include <Engine.h>
+
+#include "../World/WorldConfig.h"
+
+namespace MC { namespace Benchmarks {
+
+    // Every section of a 64 x 64 chunk world around the camera.
+    static const I32 s_GridSize = 64;
+    static const U32 s_Iterations = 100;
+
+    void RunCullingBenchmark() {
+
+        const U32 sectionCount = s_GridSize * s_GridSize * SECTION_COUNT;
+
+        BRQ_INFO("Frustum culling benchmark ({} sections, {} iterations)", sectionCount, s_Iterations);
+
+        BRQ::AABBList boxes;
+        boxes.Reserve(sectionCount);
+
+        for (I32 z = 0; z < s_GridSize; z++) {
+
+            for (I32 x = 0; x < s_GridSize; x++) {
+
+                for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+                    glm::vec3 min((F32)((x - s_GridSize / 2) * CHUNK_WIDTH), (F32)(section * SECTION_HEIGHT), (F32)((z - s_GridSize / 2) * CHUNK_LENGTH));
+                    boxes.Add(min - 0.5f, min + glm::vec3(CHUNK_WIDTH, SECTION_HEIGHT, CHUNK_LENGTH) - 0.5f);
+                }
+            }
+        }
+
+        // Same projection as CameraController, looking along a random direction each iteration.
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+        std::mt19937 random(WORLD_SEED);
+        std::uniform_real_distribution<F32> angle(0.0f, glm::radians(360.0f));
+
+        std::vector<BRQ::Frustum> frustums;
+
+        for (U32 i = 0; i < s_Iterations; i++) {
+
+            F32 yaw = angle(random);
+            glm::vec3 position(0.0f, 80.0f, 0.0f);
+            glm::vec3 front(glm::cos(yaw), -0.3f, glm::sin(yaw));
+
+            frustums.emplace_back(projection * glm::lookAt(position, position + front, glm::vec3(0.0f, 1.0f, 0.0f)));
+        }
+
+        BRQ::FrustumCulling culling = BRQ::Frustum::GetCulling();
+        const BRQ::FrustumCulling levels[] = { BRQ::FrustumCulling::Scalar, BRQ::FrustumCulling::SSE, BRQ::FrustumCulling::AVX };
+
+        std::vector<U32> reference(sectionCount);
+        std::vector<U32> visible(sectionCount);
+        std::vector<U32> referenceCounts;
+
+        for (BRQ::FrustumCulling candidate : levels) {
+
+            if (!BRQ::Frustum::IsSupported(candidate))
+                continue;
+
+            BRQ::Frustum::SetCulling(candidate);
+
+            U64 visibleTotal = 0;
+            bool matches = true;
+            F32 time = 0.0f;
+
+            for (U32 i = 0; i < s_Iterations; i++) {
+
+                std::vector<U32>& output = candidate == BRQ::FrustumCulling::Scalar ? reference : visible;
+
+                BRQ::Timer timer;
+                U32 count = frustums[i].Cull(boxes, output.data());
+                time += timer.GetTime();
+
+                visibleTotal += count;
+
+                // Only the last iteration's indices are kept, counts are compared for all of them.
+                if (candidate == BRQ::FrustumCulling::Scalar)
+                    referenceCounts.push_back(count);
+                else
+                    matches = matches && count == referenceCounts[i];
+
+                if (candidate != BRQ::FrustumCulling::Scalar && i + 1 == s_Iterations)
+                    matches = matches && std::equal(visible.begin(), visible.begin() + count, reference.begin());
+            }
+
+            BRQ_INFO("  {}: {}ms per frame, {} of {} sections visible", BRQ::Frustum::GetCullingName(candidate), time / s_Iterations, visibleTotal / s_Iterations, sectionCount);
+
+            if (!matches)
+                BRQ_ERROR("  {}: visible sections differ from the scalar test!", BRQ::Frustum::GetCullingName(candidate));
+        }
+
+        BRQ::Frustum::SetCulling(culling);
+    }
+} }
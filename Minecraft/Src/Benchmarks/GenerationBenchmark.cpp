@@ -0,0 +1,86 @@
+#include "Benchmarks.h"
+#include "ReferenceChunks.h"
+
+#include <random>
+
+#include "../World/Generation/GenerationWorkerPool.h"
+
+namespace MC { namespace Benchmarks {
+
+    void RunGenerationScalingBenchmark(U32 gridSize) {
+
+        const I32 radius = (I32)gridSize / 2;
+        const U32 chunkCount = gridSize * gridSize;
+        const U32 maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+        BRQ_INFO("Generation scaling benchmark ({}x{} chunks, 1 to {} threads)", gridSize, gridSize, maxThreads);
+
+        TerrainGenerator generator;
+
+        std::vector<ChunkCoordinate> coordinates;
+        coordinates.reserve(chunkCount);
+
+        for (I32 z = 0; z < (I32)gridSize; z++)
+            for (I32 x = 0; x < (I32)gridSize; x++)
+                coordinates.push_back({ x - radius, z - radius });
+
+        // Reference hashes from the calling thread in reverse order, every run below has to match them.
+        std::unordered_map<ChunkCoordinate, U64, ChunkCoordinateHash> reference;
+
+        for (auto it = coordinates.rbegin(); it != coordinates.rend(); it++) {
+
+            Chunk chunk;
+            chunk.SetCoordinate(*it);
+            generator.Generate(chunk);
+
+            reference[*it] = HashBlocks(chunk);
+        }
+
+        std::mt19937 random(WORLD_SEED);
+        std::vector<GenerationResult> results;
+
+        F32 singleThreadRate = 0.0f;
+
+        for (U32 threads = 1; threads <= maxThreads; threads++) {
+
+            // Every run submits in a different order, results still have to be identical.
+            std::shuffle(coordinates.begin(), coordinates.end(), random);
+
+            GenerationWorkerPool pool;
+            pool.Init(&generator, threads);
+
+            results.clear();
+            results.reserve(chunkCount);
+
+            BRQ::Timer timer;
+
+            for (const ChunkCoordinate& coordinate : coordinates)
+                pool.Submit(coordinate);
+
+            while (results.size() < chunkCount) {
+
+                pool.PollCompleted(results);
+                std::this_thread::yield();
+            }
+
+            F32 time = timer.GetTime();
+
+            pool.Shutdown();
+
+            U32 mismatches = 0;
+
+            for (const GenerationResult& result : results)
+                mismatches += HashBlocks(*result.Generated) != reference[result.Coordinate];
+
+            F32 rate = chunkCount * 1000.0f / time;
+
+            if (threads == 1)
+                singleThreadRate = rate;
+
+            BRQ_INFO("  {} threads: {}ms, {} chunks/s, {}% scaling efficiency", threads, time, rate, rate * 100.0f / (singleThreadRate * threads));
+
+            if (mismatches)
+                BRQ_ERROR("  {} threads: {} chunks differ from single threaded generation!", threads, mismatches);
+        }
+    }
+} }
@@ -0,0 +1,168 @@
+#include "Benchmarks.h"
+
+#include <bit>
+
+#include "../World/Generation/TerrainGenerator.h"
+#include "../World/Lighting/LightPropagator.h"
+
+namespace MC { namespace Benchmarks {
+
+    static const I32 s_GridSize = 5;
+    static const U32 s_EditRepetitions = 50;
+
+    struct LightingEdit {
+
+        const char* Name;
+        // Relative to the surface block in the middle of the center chunk.
+        I32         Height;
+        BlockType   Type;
+    };
+
+    static F32 LightFromScratch(LightPropagator& propagator, std::vector<Chunk>& chunks) {
+
+        LightingJob job;
+
+        for (const Chunk& chunk : chunks) {
+
+            LightChunk& lightChunk = job.Chunks.emplace_back();
+            lightChunk.Snapshot = chunk;
+            lightChunk.Initialize = true;
+        }
+
+        BRQ::Timer timer;
+        propagator.Run(job);
+        F32 time = timer.GetTime();
+
+        for (U64 i = 0; i < chunks.size(); i++)
+            chunks[i].CopyLight(job.Chunks[i].Snapshot, SECTION_MASK);
+
+        return time;
+    }
+
+    void RunLightingBenchmark() {
+
+        const U32 chunkCount = s_GridSize * s_GridSize;
+        const I32 center = s_GridSize / 2;
+
+        BRQ_INFO("Lighting benchmark ({} chunks, 1 thread)", chunkCount);
+
+        TerrainGenerator generator;
+        LightPropagator propagator;
+
+        std::vector<Chunk> chunks(chunkCount);
+
+        for (I32 z = 0; z < s_GridSize; z++) {
+
+            for (I32 x = 0; x < s_GridSize; x++) {
+
+                Chunk& chunk = chunks[x + z * s_GridSize];
+                chunk.SetCoordinate({ x, z });
+                generator.Generate(chunk);
+            }
+        }
+
+        F32 time = LightFromScratch(propagator, chunks);
+        BRQ_INFO("  Initial light: {}ms, {}ms per chunk", time, time / chunkCount);
+
+        // What a chunk loading next to lit chunks costs, its 8 neighbours take part in the job.
+        auto buildNeighbourhoodJob = [&chunks, center]() {
+
+            LightingJob job;
+
+            for (I32 z = center - 1; z <= center + 1; z++) {
+
+                for (I32 x = center - 1; x <= center + 1; x++) {
+
+                    LightChunk& lightChunk = job.Chunks.emplace_back();
+                    lightChunk.Snapshot = chunks[x + z * s_GridSize];
+                }
+            }
+
+            return job;
+        };
+
+        LightingJob relightJob = buildNeighbourhoodJob();
+        relightJob.Chunks[4].Initialize = true;
+
+        BRQ::Timer relightTimer;
+        propagator.Run(relightJob);
+        BRQ_INFO("  Relight of one chunk: {}ms", relightTimer.GetTime());
+
+        Chunk& centerChunk = chunks[center + center * s_GridSize];
+        const I32 localX = CHUNK_WIDTH / 2;
+        const I32 localZ = CHUNK_LENGTH / 2;
+
+        I32 surface = CHUNK_HEIGHT - 1;
+
+        while (surface > 0 && centerChunk.GetBlockType(localX, surface, localZ) == BlockType::Air)
+            surface--;
+
+        BlockType surfaceType = centerChunk.GetBlockType(localX, surface, localZ);
+
+        // Every pass ends with the terrain it started from.
+        const LightingEdit edits[] = {
+
+            { "Break surface block",  0,  BlockType::Air   },
+            { "Place surface block",  0,  surfaceType      },
+            { "Place light",          1,  BlockType::Lignt },
+            { "Remove light",         1,  BlockType::Air   },
+            { "Place block in sky",   8,  BlockType::Dirt  },
+            { "Break block in sky",   8,  BlockType::Air   },
+        };
+
+        const U32 editCount = sizeof(edits) / sizeof(edits[0]);
+
+        F32 editTimes[editCount] = {};
+        U32 editSections[editCount] = {};
+
+        for (U32 repetition = 0; repetition < s_EditRepetitions; repetition++) {
+
+            for (U32 i = 0; i < editCount; i++) {
+
+                glm::ivec3 position(center * CHUNK_WIDTH + localX, surface + edits[i].Height, center * CHUNK_LENGTH + localZ);
+                glm::vec3 local((F32)localX, (F32)position.y, (F32)localZ);
+
+                LightEdit edit = { position, centerChunk.GetBlockType(localX, position.y, localZ) };
+                centerChunk.SetBlock(edits[i].Type, local);
+
+                LightingJob job = buildNeighbourhoodJob();
+                job.Edits.push_back(edit);
+
+                BRQ::Timer timer;
+                propagator.Run(job);
+                editTimes[i] += timer.GetTime();
+
+                U32 index = 0;
+
+                for (I32 z = center - 1; z <= center + 1; z++) {
+
+                    for (I32 x = center - 1; x <= center + 1; x++) {
+
+                        const LightChunk& lightChunk = job.Chunks[index++];
+
+                        chunks[x + z * s_GridSize].CopyLight(lightChunk.Snapshot, lightChunk.ChangedSections);
+                        editSections[i] += std::popcount(lightChunk.RemeshSections);
+                    }
+                }
+            }
+        }
+
+        for (U32 i = 0; i < editCount; i++)
+            BRQ_INFO("  {}: {}ms, {} sections to remesh", edits[i].Name, editTimes[i] / s_EditRepetitions, editSections[i] / s_EditRepetitions);
+
+        // Incremental updates have to end up where lighting everything again does.
+        std::vector<Chunk> reference = chunks;
+        LightFromScratch(propagator, reference);
+
+        U64 mismatches = 0;
+
+        for (U32 i = 0; i < chunkCount; i++)
+            for (U32 y = 0; y < CHUNK_HEIGHT; y++)
+                for (U32 z = 0; z < CHUNK_LENGTH; z++)
+                    for (U32 x = 0; x < CHUNK_WIDTH; x++)
+                        mismatches += chunks[i].GetLight(x, y, z) != reference[i].GetLight(x, y, z);
+
+        if (mismatches)
+            BRQ_ERROR("  Incremental light differs from a full relight in {} blocks!", mismatches);
+    }
+} }
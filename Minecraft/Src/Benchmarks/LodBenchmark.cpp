@@ -0,0 +1,118 @@
+#include "Benchmarks.h"
+
+#include "../World/World.h"
+#include "../World/Generation/TerrainGenerator.h"
+#include "../World/Lighting/LightPropagator.h"
+#include "../World/Meshing/LodMesher.h"
+
+namespace MC { namespace Benchmarks {
+
+    // Chunks around the measured ones are generated and lit too, so borders and skirts see real neighbours.
+    static const I32 s_GridSize = 8;
+    static const I32 s_ViewDistances[] = { 8, 16, 24, 32, 48 };
+
+    void RunLodBenchmark() {
+
+        BRQ_INFO("LOD benchmark ({} chunks per level)", (s_GridSize - 2) * (s_GridSize - 2));
+
+        TerrainGenerator generator;
+        LightPropagator propagator;
+
+        std::vector<Chunk> chunks(s_GridSize * s_GridSize);
+        LightingJob job;
+
+        for (I32 z = 0; z < s_GridSize; z++) {
+
+            for (I32 x = 0; x < s_GridSize; x++) {
+
+                Chunk& chunk = chunks[x + z * s_GridSize];
+                chunk.SetCoordinate({ x, z });
+                generator.Generate(chunk);
+
+                LightChunk& lightChunk = job.Chunks.emplace_back();
+                lightChunk.Snapshot = chunk;
+                lightChunk.Initialize = true;
+            }
+        }
+
+        propagator.Run(job);
+
+        for (U64 i = 0; i < chunks.size(); i++)
+            chunks[i].CopyLight(job.Chunks[i].Snapshot, SECTION_MASK);
+
+        F32 trianglesPerChunk[LOD_COUNT] = {};
+
+        for (U32 lod = 0; lod < LOD_COUNT; lod++) {
+
+            U64 triangles = 0;
+            U32 meshed = 0;
+            F32 time = 0.0f;
+
+            for (I32 z = 1; z < s_GridSize - 1; z++) {
+
+                for (I32 x = 1; x < s_GridSize - 1; x++) {
+
+                    ChunkNeighbours neighbours;
+                    neighbours.Chunks[(U32)BlockFace::Front] = &chunks[x + (z + 1) * s_GridSize];
+                    neighbours.Chunks[(U32)BlockFace::Back] = &chunks[x + (z - 1) * s_GridSize];
+                    neighbours.Chunks[(U32)BlockFace::Left] = &chunks[(x - 1) + z * s_GridSize];
+                    neighbours.Chunks[(U32)BlockFace::Right] = &chunks[(x + 1) + z * s_GridSize];
+
+                    for (U32 corner = 0; corner < 4; corner++)
+                        neighbours.Corners[corner] = &chunks[(x + (corner & 1) * 2 - 1) + (z + (corner >> 1) * 2 - 1) * s_GridSize];
+
+                    const Chunk& chunk = chunks[x + z * s_GridSize];
+                    BRQ::VoxelMeshData sectionMeshes[SECTION_COUNT];
+
+                    BRQ::Timer timer;
+
+                    if (lod)
+                        LodMesher::Mesh(chunk, lod, neighbours, sectionMeshes);
+                    else
+                        ChunkMesher::Mesh(chunk, SECTION_MASK, MeshingMode::Greedy, neighbours, sectionMeshes);
+
+                    time += timer.GetTime();
+
+                    for (const BRQ::VoxelMeshData& meshData : sectionMeshes)
+                        triangles += ChunkMesher::GetStatistics(meshData).TriangleCount;
+
+                    meshed++;
+                }
+            }
+
+            trianglesPerChunk[lod] = (F32)triangles / meshed;
+
+            BRQ_INFO("  Level {} ({}x): {} triangles, {}ms per chunk", lod, LodMesher::GetScale(lod), trianglesPerChunk[lod], time / meshed);
+        }
+
+        // Whole view distances are estimated from the averages above, with the default LOD rings.
+        StreamingSettings settings;
+
+        for (I32 distance : s_ViewDistances) {
+
+            F32 fullDetail = 0.0f;
+            F32 withLod = 0.0f;
+
+            for (I32 z = -distance; z <= distance; z++) {
+
+                for (I32 x = -distance; x <= distance; x++) {
+
+                    I32 distanceSquared = x * x + z * z;
+
+                    if (distanceSquared > distance * distance)
+                        continue;
+
+                    U32 lod = 0;
+
+                    while (lod < LOD_COUNT - 1 && distanceSquared > settings.LodDistances[lod] * settings.LodDistances[lod])
+                        lod++;
+
+                    fullDetail += trianglesPerChunk[0];
+                    withLod += trianglesPerChunk[lod];
+                }
+            }
+
+            BRQ_INFO("  View distance {}: {} triangles at full detail, {} with LOD ({}x fewer)", distance, (U64)fullDetail, (U64)withLod, fullDetail / withLod);
+        }
+    }
+} }
@@ -0,0 +1,85 @@
+#include "Benchmarks.h"
+#include "ReferenceChunks.h"
+
+#include "../World/Meshing/ChunkMesher.h"
+
+namespace MC { namespace Benchmarks {
+
+    static F32 Reduction(U64 before, U64 after) {
+
+        if (before == 0)
+            return 0.0f;
+
+        return 100.0f * (1.0f - (F32)after / (F32)before);
+    }
+
+    void RunMeshingBenchmark() {
+
+        BRQ_INFO("Meshing benchmark (culled -> greedy)");
+
+        U64 totalCulled = 0;
+        U64 totalGreedy = 0;
+
+        for (const ReferenceChunk& reference : CreateReferenceChunks()) {
+
+            MeshingStatistics culled = ChunkMesher::GetStatistics(ChunkMesher::Mesh(reference.Data, MeshingMode::Culled));
+            MeshingStatistics greedy = ChunkMesher::GetStatistics(ChunkMesher::Mesh(reference.Data, MeshingMode::Greedy));
+
+            BRQ_INFO("  {}: vertices {} -> {} ({}% fewer), triangles {} -> {} ({}% fewer)", reference.Name,
+                culled.VertexCount, greedy.VertexCount, Reduction(culled.VertexCount, greedy.VertexCount),
+                culled.TriangleCount, greedy.TriangleCount, Reduction(culled.TriangleCount, greedy.TriangleCount));
+
+            totalCulled += culled.TriangleCount;
+            totalGreedy += greedy.TriangleCount;
+        }
+
+        BRQ_INFO("  Total: triangles {} -> {} ({}% fewer)", totalCulled, totalGreedy, Reduction(totalCulled, totalGreedy));
+    }
+
+    static bool MeshesMatch(const BRQ::VoxelMeshData& a, const BRQ::VoxelMeshData& b) {
+
+        return a.Verticies == b.Verticies && a.Indicies == b.Indicies;
+    }
+
+    void RunMeshingBackendBenchmark() {
+
+        const U32 iterations = 200;
+
+        BRQ_INFO("Meshing backend benchmark (reference vs binary, {} iterations)", iterations);
+
+        std::vector<ReferenceChunk> chunks = CreateReferenceChunks();
+
+        MeshingBackend backend = ChunkMesher::GetBackend();
+
+        for (const ReferenceChunk& reference : chunks) {
+
+            // Surround every section with copies of itself so border culling is exercised too.
+            SectionNeighbours neighbours;
+
+            for (U32 i = 0; i < (U32)BlockFace::BlockFaceMaxEnumerations; i++)
+                neighbours.Sections[i] = &reference.Data;
+
+            F32 timings[2] = {};
+            BRQ::VoxelMeshData meshes[2];
+
+            for (U32 i = 0; i < 2; i++) {
+
+                ChunkMesher::SetBackend(i == 0 ? MeshingBackend::Reference : MeshingBackend::Binary);
+
+                BRQ::Timer timer;
+
+                for (U32 j = 0; j < iterations; j++)
+                    meshes[i] = ChunkMesher::Mesh(reference.Data, MeshingMode::Greedy, neighbours);
+
+                timings[i] = timer.GetTime() / iterations;
+            }
+
+            if (!MeshesMatch(meshes[0], meshes[1]))
+                BRQ_ERROR("  {}: binary mesher output differs from the reference mesher!", reference.Name);
+
+            BRQ_INFO("  {}: reference {}ms, binary {}ms per section", reference.Name, timings[0], timings[1]);
+        }
+
+        ChunkMesher::SetBackend(backend);
+    }
+} }
@@ -0,0 +1,103 @@
+#include "Benchmarks.h"
+
+#include "../World/Generation/TerrainGenerator.h"
+#include "../World/Culling/OcclusionCuller.h"
+
+namespace MC { namespace Benchmarks {
+
+    static const I32 s_Radius = 8;
+    static const U32 s_Directions = 8;
+
+    static void CullFrom(const char* name, const glm::vec3& position, OcclusionCuller& culler, const std::vector<Chunk>& chunks) {
+
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+        std::vector<VisibleSection> visible;
+
+        U64 frustumSections = 0;
+        U64 occlusionSections = 0;
+        F32 time = 0.0f;
+
+        for (U32 i = 0; i < s_Directions; i++) {
+
+            F32 yaw = glm::radians(360.0f) * i / s_Directions;
+            glm::vec3 front(glm::cos(yaw), -0.2f, glm::sin(yaw));
+            BRQ::Frustum frustum(projection * glm::lookAt(position, position + front, glm::vec3(0.0f, 1.0f, 0.0f)));
+
+            for (const Chunk& chunk : chunks) {
+
+                for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+                    glm::vec3 min = chunk.GetSectionPosition(section) - 0.5f;
+
+                    if (frustum.Intersects(min, min + glm::vec3(CHUNK_WIDTH, SECTION_HEIGHT, CHUNK_LENGTH)))
+                        frustumSections++;
+                }
+            }
+
+            visible.clear();
+
+            BRQ::Timer timer;
+            culler.Cull(position, frustum, visible);
+            time += timer.GetTime();
+
+            occlusionSections += visible.size();
+        }
+
+        BRQ_INFO("  {}: {} sections in the frustum, {} reachable ({}%), {}ms per walk", name, frustumSections / s_Directions,
+            occlusionSections / s_Directions, occlusionSections * 100 / std::max<U64>(frustumSections, 1), time / s_Directions);
+    }
+
+    void RunOcclusionBenchmark() {
+
+        const I32 size = s_Radius * 2 + 1;
+
+        BRQ_INFO("Occlusion culling benchmark ({} chunks, {} directions)", size * size, s_Directions);
+
+        TerrainGenerator generator;
+        std::vector<Chunk> chunks(size * size);
+
+        for (I32 z = 0; z < size; z++) {
+
+            for (I32 x = 0; x < size; x++) {
+
+                Chunk& chunk = chunks[x + z * size];
+                chunk.SetCoordinate({ x - s_Radius, z - s_Radius });
+                generator.Generate(chunk);
+            }
+        }
+
+        // Empty meshes upload nothing, so the connectivity can be stored without a renderer.
+        const BRQ::VoxelMeshData sectionMeshes[SECTION_COUNT];
+        std::vector<BRQ::Mesh> retired;
+
+        F32 time = 0.0f;
+
+        for (Chunk& chunk : chunks) {
+
+            U16 visibility[SECTION_COUNT];
+
+            BRQ::Timer timer;
+            SectionVisibility::Compute(chunk, SECTION_MASK, visibility);
+            time += timer.GetTime();
+
+            chunk.SetMeshes(sectionMeshes, visibility, SECTION_MASK, 1, retired);
+        }
+
+        BRQ_INFO("  Connectivity: {}ms per chunk", time / chunks.size());
+
+        OcclusionCuller culler;
+        culler.Begin({ 0, 0 }, s_Radius);
+
+        for (const Chunk& chunk : chunks)
+            culler.AddChunk(chunk);
+
+        const Chunk& center = chunks[s_Radius + s_Radius * size];
+        U32 surface = CHUNK_HEIGHT - 1;
+
+        while (surface > 0 && center.GetBlockType(0, surface, 0) == BlockType::Air)
+            surface--;
+
+        CullFrom("Surface", glm::vec3(0.0f, (F32)surface + 2.0f, 0.0f), culler, chunks);
+        CullFrom("Underground", glm::vec3(0.0f, (F32)surface * 0.5f, 0.0f), culler, chunks);
+    }
+} }
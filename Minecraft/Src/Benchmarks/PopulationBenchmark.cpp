@@ -0,0 +1,99 @@
+#include "Benchmarks.h"
+#include "ReferenceChunks.h"
+
+#include <random>
+
+#include "../World/Generation/TerrainGenerator.h"
+#include "../World/Generation/ChunkPopulator.h"
+
+namespace MC { namespace Benchmarks {
+
+    static const I32 s_GridSize = 8;
+
+    // Populates the inner chunks of a generated grid in the given order, placing edits like World does.
+    static void PopulateGrid(std::vector<Chunk>& chunks, const std::vector<I32>& order, const ChunkPopulator& populator, U64& edits, U64& placed) {
+
+        std::vector<PopulationEdit> chunkEdits;
+
+        for (I32 index : order) {
+
+            chunkEdits.clear();
+            populator.Populate(chunks[index], chunkEdits);
+            edits += chunkEdits.size();
+
+            for (const PopulationEdit& edit : chunkEdits) {
+
+                ChunkCoordinate coordinate = ChunkCoordinate::FromBlock(edit.Position.x, edit.Position.z);
+
+                if (coordinate.X < 0 || coordinate.Z < 0 || coordinate.X >= s_GridSize || coordinate.Z >= s_GridSize)
+                    continue;
+
+                Chunk& chunk = chunks[coordinate.X + coordinate.Z * s_GridSize];
+
+                U32 x = (U32)(edit.Position.x - coordinate.X * CHUNK_WIDTH);
+                U32 z = (U32)(edit.Position.z - coordinate.Z * CHUNK_LENGTH);
+
+                if (!ChunkPopulator::CanReplace(chunk.GetBlockType(x, (U32)edit.Position.y, z), edit.Type))
+                    continue;
+
+                chunk.SetBlock(edit.Type, glm::vec3(x, edit.Position.y, z));
+                placed++;
+            }
+        }
+    }
+
+    void RunPopulationBenchmark() {
+
+        BRQ_INFO("Population benchmark ({} chunks populated in two orders)", (s_GridSize - 2) * (s_GridSize - 2));
+
+        TerrainGenerator generator;
+        ChunkPopulator populator;
+
+        std::vector<Chunk> terrain(s_GridSize * s_GridSize);
+
+        for (I32 z = 0; z < s_GridSize; z++) {
+
+            for (I32 x = 0; x < s_GridSize; x++) {
+
+                Chunk& chunk = terrain[x + z * s_GridSize];
+                chunk.SetCoordinate({ x, z });
+                generator.Generate(chunk);
+            }
+        }
+
+        // Only chunks with all 8 neighbours are populated, like in the world.
+        std::vector<I32> order;
+
+        for (I32 z = 1; z < s_GridSize - 1; z++)
+            for (I32 x = 1; x < s_GridSize - 1; x++)
+                order.push_back(x + z * s_GridSize);
+
+        std::vector<Chunk> rowMajor = terrain;
+        std::vector<Chunk> shuffled = terrain;
+
+        U64 edits = 0;
+        U64 placed = 0;
+
+        BRQ::Timer timer;
+        PopulateGrid(rowMajor, order, populator, edits, placed);
+        F32 time = timer.GetTime();
+
+        BRQ_INFO("  {}ms per chunk, {} edits and {} blocks placed per chunk", time / order.size(), edits / order.size(), placed / order.size());
+
+        std::mt19937 random(WORLD_SEED);
+        std::shuffle(order.begin(), order.end(), random);
+
+        U64 shuffledEdits = 0;
+        U64 shuffledPlaced = 0;
+
+        PopulateGrid(shuffled, order, populator, shuffledEdits, shuffledPlaced);
+
+        U32 mismatches = 0;
+
+        for (U64 i = 0; i < terrain.size(); i++)
+            mismatches += HashBlocks(rowMajor[i]) != HashBlocks(shuffled[i]);
+
+        if (mismatches)
+            BRQ_ERROR("  {} chunks differ between population orders!", mismatches);
+    }
+} }
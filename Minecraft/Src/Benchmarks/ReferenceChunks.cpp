@@ -0,0 +1,90 @@
+#include "ReferenceChunks.h"
+
+namespace MC { namespace Benchmarks {
+
+    static U32 Hash(U32 x, U32 y, U32 z) {
+
+        U32 hash = x * 73856093u ^ y * 19349663u ^ z * 83492791u;
+        hash ^= hash >> 13;
+        hash *= 0x5bd1e995u;
+        hash ^= hash >> 15;
+
+        return hash;
+    }
+
+    template <typename Function>
+    static ReferenceChunk CreateChunk(const char* name, Function function) {
+
+        ReferenceChunk reference = { name, {} };
+
+        for (U32 y = 0; y < SECTION_HEIGHT; y++)
+            for (U32 z = 0; z < CHUNK_LENGTH; z++)
+                for (U32 x = 0; x < CHUNK_WIDTH; x++)
+                    reference.Data.Set(BlockStorage::ToIndex(x, y, z), function(x, y, z));
+
+        return reference;
+    }
+
+    std::vector<ReferenceChunk> CreateReferenceChunks() {
+
+        std::vector<ReferenceChunk> chunks;
+
+        chunks.push_back(CreateChunk("Flat", [](U32 x, U32 y, U32 z) {
+
+            if (y < SECTION_HEIGHT / 2)
+                return BlockType::Dirt;
+
+            return y == SECTION_HEIGHT / 2 ? BlockType::Grass : BlockType::Air;
+        }));
+
+        chunks.push_back(CreateChunk("Hills", [](U32 x, U32 y, U32 z) {
+
+            U32 height = (U32)(SECTION_HEIGHT / 2 + 3.0f * glm::sin(x / 3.0f) + 2.0f * glm::cos(z / 4.0f));
+
+            if (y < height)
+                return BlockType::Dirt;
+
+            return y == height ? BlockType::Grass : BlockType::Air;
+        }));
+
+        chunks.push_back(CreateChunk("Solid with ores", [](U32 x, U32 y, U32 z) {
+
+            U32 hash = Hash(x, y, z) % 64;
+
+            if (hash == 0)
+                return BlockType::Gold;
+
+            return hash < 4 ? BlockType::Iron : BlockType::Dirt;
+        }));
+
+        chunks.push_back(CreateChunk("Noise", [](U32 x, U32 y, U32 z) {
+
+            return Hash(x, y, z) % 3 == 0 ? BlockType::Air : BlockType::Dirt;
+        }));
+
+        chunks.push_back(CreateChunk("Checkerboard", [](U32 x, U32 y, U32 z) {
+
+            return (x + y + z) % 2 ? BlockType::Air : BlockType::Dirt;
+        }));
+
+        return chunks;
+    }
+
+    U64 HashBlocks(const Chunk& chunk) {
+
+        U64 hash = 0xcbf29ce484222325ULL;
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            const BlockStorage& storage = chunk.GetSection(section);
+
+            for (U32 index = 0; index < SECTION_SIZE; index++) {
+
+                hash ^= (U64)storage.Get(index);
+                hash *= 0x100000001b3ULL;
+            }
+        }
+
+        return hash;
+    }
+} }
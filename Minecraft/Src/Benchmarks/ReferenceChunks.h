@@ -0,0 +1,22 @@
+#pragma once
+
+#include <Engine.h>
+
+#include "../World/Chunks/Chunk.h"
+
+namespace MC { namespace Benchmarks {
+
+    struct ReferenceChunk {
+
+        const char*  Name;
+        // One section, the unit every mesher works on.
+        BlockStorage Data;
+    };
+
+    // A fixed set of chunk layouts covering the common (flat, hills, solid)
+    // and the pathological (checkerboard, noise) cases for meshing.
+    std::vector<ReferenceChunk> CreateReferenceChunks();
+
+    // FNV-1a over every block in BlockStorage::ToIndex order, section by section, to compare chunks between runs.
+    U64 HashBlocks(const Chunk& chunk);
+} }
@@ -0,0 +1,47 @@
+#include "Benchmarks.h"
+
+#include "../World/Generation/TerrainGenerator.h"
+
+namespace MC { namespace Benchmarks {
+
+    void RunTerrainBenchmark() {
+
+        const I32 gridSize = 16;
+        const U32 chunkCount = gridSize * gridSize;
+
+        BRQ_INFO("Terrain generation benchmark ({} chunks, 1 thread)", chunkCount);
+
+        TerrainGenerator generator;
+        SimdLevel level = GradientNoise::GetSimdLevel();
+
+        std::vector<BlockType> reference((size_t)chunkCount * (CHUNK_SIZE));
+        std::vector<BlockType> blocks((size_t)chunkCount * (CHUNK_SIZE));
+
+        const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2 };
+
+        for (SimdLevel candidate : levels) {
+
+            if (!GradientNoise::IsSupported(candidate))
+                continue;
+
+            GradientNoise::SetSimdLevel(candidate);
+
+            std::vector<BlockType>& output = candidate == SimdLevel::Scalar ? reference : blocks;
+
+            BRQ::Timer timer;
+
+            for (I32 x = 0; x < gridSize; x++)
+                for (I32 z = 0; z < gridSize; z++)
+                    generator.Generate({ x, z }, output.data() + (size_t)(x * gridSize + z) * (CHUNK_SIZE));
+
+            F32 time = timer.GetTime();
+
+            BRQ_INFO("  {}: {}ms, {} chunks/s per core", GradientNoise::GetSimdLevelName(candidate), time, chunkCount * 1000.0f / time);
+
+            if (candidate != SimdLevel::Scalar && blocks != reference)
+                BRQ_ERROR("  {}: terrain differs from the scalar generator!", GradientNoise::GetSimdLevelName(candidate));
+        }
+
+        GradientNoise::SetSimdLevel(level);
+    }
+} }
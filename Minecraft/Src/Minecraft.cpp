@@ -1,22 +1,136 @@
 #include <Engine.h>
 #include <BRQ/Application/EntryPoint.h>
 
+#include "Benchmarks/Benchmarks.h"
+#include "World/World.h"
+#include "World/Blocks/BlockRegistry.h"
+#include "World/Physics/VoxelCollider.h"
+
 class Minecraft : public BRQ::Application {
 
+private:
+    MC::World         m_World;
+    MC::VoxelCollider m_CameraCollider;
+
+    MC::BlockType     m_SelectedBlock;
+    bool              m_BreakHeld;
+    bool              m_PlaceHeld;
+
 public:
     Minecraft(const BRQ::WindowProperties& props)
-        : Application(props)
+        : Application(props), m_CameraCollider(m_World), m_SelectedBlock(MC::BlockType::Dirt), m_BreakHeld(false), m_PlaceHeld(false)
     {
+        MC::BlockRegistry::Load("Resources/Blocks/Blocks.txt");
+
+        // One texture array layer per texture the blocks name, in the registry's layer order.
+        std::vector<std::string> textures;
+
+        for (const std::string& name : MC::BlockRegistry::GetTextureNames())
+            textures.push_back("Resources/Textures/Blocks/" + name + ".png");
+
+        m_Renderer->SetVoxelTextures(textures);
 
+        for (I32 i = 1; i < __argc; i++) {
+
+            if (strcmp(__argv[i], "--benchmark") == 0)
+                MC::Benchmarks::RunAll();
+        }
+
+        m_World.Init();
+
+        // The camera still flies, but collides with blocks and steps up ledges like a player sized box.
+        m_CameraController.SetMovementResolver([this](const glm::vec3& position, const glm::vec3& displacement) {
+
+            return position + m_CameraCollider.Move(GetCameraBox(position), displacement, 1.0f).Displacement;
+        });
     }
 
     ~Minecraft()
     {
+        m_World.Shutdown();
+    }
 
+protected:
+    void OnClientUpdate(F32 dt) override
+    {
+        UpdateBlockInteraction();
+
+        m_World.Update(m_CameraController.GetCamera());
+    }
+
+    void OnClientRender() override
+    {
+        m_World.Render(m_Renderer);
+    }
+
+private:
+    static MC::CollisionBox GetCameraBox(const glm::vec3& eye)
+    {
+        return MC::CollisionBox::FromEye(eye, 0.6f, 1.8f, 1.6f);
+    }
+
+    void UpdateBlockInteraction()
+    {
+        const F32 reach = 8.0f;
+
+        // Number keys pick the block to place, starting after air.
+        for (U32 i = 1; i < (U32)MC::BlockType::BlockTypeMaxEnumerations; i++) {
+
+            if (m_InputManager->IsKeyPressed((BRQ::Key)((U32)BRQ::Key::KEY_0 + i)))
+                m_SelectedBlock = (MC::BlockType)i;
+        }
+
+        bool breakPressed = m_InputManager->IsMouseButtonPressed(BRQ::MouseButton::ButtonLeft);
+        bool placePressed = m_InputManager->IsMouseButtonPressed(BRQ::MouseButton::ButtonRight);
+
+        // One edit per click.
+        bool breakBlock = breakPressed && !m_BreakHeld;
+        bool placeBlock = placePressed && !m_PlaceHeld;
+
+        m_BreakHeld = breakPressed;
+        m_PlaceHeld = placePressed;
+
+        if (!breakBlock && !placeBlock)
+            return;
+
+        const BRQ::Camera& camera = m_CameraController.GetCamera();
+
+        MC::RaycastHit hit;
+
+        if (!m_World.Raycast(camera.GetPosition(), camera.GetFront(), reach, hit))
+            return;
+
+        if (breakBlock) {
+
+            m_World.BreakBlock(hit.Block);
+            return;
+        }
+
+        // A block placed into the camera's box would trap it, the collider can't move a box out of a block.
+        if (MC::BlockRegistry::HasCollision(m_SelectedBlock) &&
+            GetCameraBox(camera.GetPosition()).Intersects(MC::CollisionBox::FromBlock(hit.Adjacent)))
+            return;
+
+        m_World.PlaceBlock(hit.Adjacent, m_SelectedBlock);
     }
 };
 
 BRQ::Application* BRQ::CreateApplication(const BRQ::WindowProperties& props) {
 
+    // Runs before any window or device exists, so it works on headless servers. An optional grid size may follow.
+    for (I32 i = 1; i < __argc; i++) {
+
+        if (strcmp(__argv[i], "--benchmark-generation") == 0) {
+
+            U32 gridSize = i + 1 < __argc ? (U32)atoi(__argv[i + 1]) : 0;
+
+            BRQ::Log::Init();
+            MC::Benchmarks::RunGenerationScalingBenchmark(gridSize ? gridSize : 32);
+            BRQ::Log::Shutdown();
+
+            std::exit(0);
+        }
+    }
+
     return new Minecraft(props);
 }
\ No newline at end of file
@@ -12,6 +12,8 @@ namespace MC {
         Iron,
         Gold,
         Lignt,
+        Log,
+        Leaves,
         BlockTypeMaxEnumerations
     };
 
@@ -52,4 +52,49 @@ static const F32 BottomFace[20] = {
     -BLOCK_SIZE, -BLOCK_SIZE,  BLOCK_SIZE, 0.0f, 1.0f,
      BLOCK_SIZE, -BLOCK_SIZE, -BLOCK_SIZE, 1.0f, 0.0f,
      BLOCK_SIZE, -BLOCK_SIZE,  BLOCK_SIZE, 1.0f, 1.0f,
+};
+
+enum class BlockFace : U8 {
+
+    Front = 0,  // +Z
+    Back,       // -Z
+    Left,       // -X
+    Right,      // +X
+    Top,        // +Y
+    Bottom,     // -Y
+    BlockFaceMaxEnumerations
+};
+
+static const F32* const FaceVertices[6] = { FrontFace, BackFace, LeftFace, RightFace, TopFace, BottomFace };
+
+static const I32 FaceNormals[6][3] = {
+
+    {  0,  0,  1 },
+    {  0,  0, -1 },
+    { -1,  0,  0 },
+    {  1,  0,  0 },
+    {  0,  1,  0 },
+    {  0, -1,  0 },
+};
+
+struct FaceAxes {
+
+    I32 Normal;
+    I32 NormalSign;
+    I32 U;
+    I32 USign;
+    I32 V;
+    I32 VSign;
+};
+
+// U/V axes match the texture orientation of the face tables above,
+// so a quad spanning several blocks tiles its texture the same way single faces do.
+static const FaceAxes BlockFaceAxes[6] = {
+
+    { 2,  1, 0,  1, 1,  1 },    // Front
+    { 2, -1, 0, -1, 1,  1 },    // Back
+    { 0, -1, 2,  1, 1,  1 },    // Left
+    { 0,  1, 2, -1, 1,  1 },    // Right
+    { 1,  1, 0,  1, 2, -1 },    // Top
+    { 1, -1, 0,  1, 2,  1 },    // Bottom
 };
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "BlockRegistry.h"
+
+#include "../WorldConfig.h"
+
+namespace MC {
+
+    U64                      BlockRegistry::s_Opaque[BLOCK_ID_COUNT / 64];
+    U64                      BlockRegistry::s_Meshed[BLOCK_ID_COUNT / 64];
+    CollisionShape           BlockRegistry::s_Collision[BLOCK_ID_COUNT];
+    U8                       BlockRegistry::s_Emission[BLOCK_ID_COUNT];
+    F32                      BlockRegistry::s_Hardness[BLOCK_ID_COUNT];
+    U16                      BlockRegistry::s_TextureLayers[(U32)BlockFace::BlockFaceMaxEnumerations][BLOCK_ID_COUNT];
+    std::string              BlockRegistry::s_Names[BLOCK_ID_COUNT];
+    std::vector<std::string> BlockRegistry::s_TextureNames;
+
+    static const char* s_MissingTexture = "missing";
+
+    bool BlockRegistry::Load(const std::string_view& filename) {
+
+        Reset();
+
+        std::vector<BYTE> file = BRQ::Utilities::FileSystem::GetInstance()->ReadFile(filename);
+
+        if (file.empty()) {
+
+            BRQ_ERROR("Can't load block definitions from {}", filename.data());
+            return false;
+        }
+
+        std::istringstream stream(std::string(file.begin(), file.end()));
+        std::string line;
+        U32 lineNumber = 0;
+        U32 count = 0;
+
+        while (std::getline(stream, line)) {
+
+            lineNumber++;
+
+            U64 comment = line.find('#');
+
+            if (comment != std::string::npos)
+                line.erase(comment);
+
+            if (line.find_first_not_of(" \t\r") == std::string::npos)
+                continue;
+
+            if (ParseDefinition(line))
+                count++;
+            else
+                BRQ_ERROR("{}:{}: invalid block definition", filename.data(), lineNumber);
+        }
+
+        BRQ_INFO("Loaded {} block definitions, {} textures", count, s_TextureNames.size());
+
+        return true;
+    }
+
+    void BlockRegistry::Reset() {
+
+        s_TextureNames.clear();
+
+        U16 missing = AddTexture(s_MissingTexture);
+
+        for (U32 id = 0; id < BLOCK_ID_COUNT; id++) {
+
+            s_Collision[id] = CollisionShape::Full;
+            s_Emission[id] = 0;
+            s_Hardness[id] = 1.0f;
+            s_Names[id] = "Block" + std::to_string(id);
+
+            for (U32 face = 0; face < (U32)BlockFace::BlockFaceMaxEnumerations; face++)
+                s_TextureLayers[face][id] = missing;
+        }
+
+        std::fill(std::begin(s_Opaque), std::end(s_Opaque), ~0ULL);
+        std::fill(std::begin(s_Meshed), std::end(s_Meshed), ~0ULL);
+
+        s_Opaque[0] &= ~1ULL;
+        s_Meshed[0] &= ~1ULL;
+        s_Collision[(U8)BlockType::Air] = CollisionShape::None;
+        s_Hardness[(U8)BlockType::Air] = 0.0f;
+        s_Names[(U8)BlockType::Air] = "Air";
+    }
+
+    // id name opaque collision emission hardness textures, where textures is one name for every face, three for
+    // top, sides and bottom, or six in BlockFace order. "-" names no texture, for blocks that are never meshed.
+    bool BlockRegistry::ParseDefinition(const std::string& line) {
+
+        std::istringstream stream(line);
+
+        U32 id;
+        std::string name;
+        U32 opaque;
+        std::string collision;
+        U32 emission;
+        F32 hardness;
+
+        if (!(stream >> id >> name >> opaque >> collision >> emission >> hardness))
+            return false;
+
+        // Saves store ids, air has to stay air.
+        if (id >= (U32)BlockType::BlockTypeMaxEnumerations || (id == (U32)BlockType::Air && (opaque || collision != "None")))
+            return false;
+
+        if (opaque > 1 || emission > LIGHT_MAX || hardness < 0.0f)
+            return false;
+
+        CollisionShape shape;
+
+        if (collision == "None")
+            shape = CollisionShape::None;
+        else if (collision == "Full")
+            shape = CollisionShape::Full;
+        else
+            return false;
+
+        std::vector<std::string> textures;
+
+        for (std::string texture; stream >> texture; )
+            textures.push_back(texture);
+
+        if (textures.size() != 1 && textures.size() != 3 && textures.size() != 6)
+            return false;
+
+        static const U32 s_TopSideBottom[6] = { 1, 1, 1, 1, 0, 2 };
+
+        bool meshed = false;
+
+        for (U32 face = 0; face < (U32)BlockFace::BlockFaceMaxEnumerations; face++) {
+
+            const std::string& texture = textures.size() == 1 ? textures[0] : textures.size() == 3 ? textures[s_TopSideBottom[face]] : textures[face];
+
+            s_TextureLayers[face][id] = texture == "-" ? 0 : AddTexture(texture);
+            meshed |= texture != "-";
+        }
+
+        U64 bit = 1ULL << (id & 63);
+        s_Opaque[id >> 6] = opaque ? s_Opaque[id >> 6] | bit : s_Opaque[id >> 6] & ~bit;
+        s_Meshed[id >> 6] = meshed ? s_Meshed[id >> 6] | bit : s_Meshed[id >> 6] & ~bit;
+
+        s_Collision[id] = shape;
+        s_Emission[id] = (U8)emission;
+        s_Hardness[id] = hardness;
+        s_Names[id] = name;
+
+        return true;
+    }
+
+    U16 BlockRegistry::AddTexture(const std::string& name) {
+
+        auto it = std::find(s_TextureNames.begin(), s_TextureNames.end(), name);
+
+        if (it != s_TextureNames.end())
+            return (U16)(it - s_TextureNames.begin());
+
+        s_TextureNames.push_back(name);
+
+        return (U16)(s_TextureNames.size() - 1);
+    }
+}
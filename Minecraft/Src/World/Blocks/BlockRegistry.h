@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Engine.h>
+
+#include "Block.h"
+#include "BlockData.h"
+
+namespace MC {
+
+    #define BLOCK_ID_COUNT  256     // Every value a BlockType can hold
+
+    enum class CollisionShape : U8 {
+
+        None = 0,   // Entities pass through, e.g. air.
+        Full,       // The whole block.
+    };
+
+    // Block properties loaded from a definitions file at startup, see Resources/Blocks/Blocks.txt.
+    // Every property is its own dense table indexed by block id, so hot loops read one entry without
+    // branching on the type. The tables cover every possible id, lookups need no bounds check.
+    // Written once by Load before any world work starts, read only afterwards from any thread.
+    class BlockRegistry {
+
+    private:
+        static U64                      s_Opaque[BLOCK_ID_COUNT / 64];
+        static U64                      s_Meshed[BLOCK_ID_COUNT / 64];
+        static CollisionShape           s_Collision[BLOCK_ID_COUNT];
+        static U8                       s_Emission[BLOCK_ID_COUNT];
+        static F32                      s_Hardness[BLOCK_ID_COUNT];
+        // Face major, the faces a mesher emits in one pass read one contiguous row.
+        static U16                      s_TextureLayers[(U32)BlockFace::BlockFaceMaxEnumerations][BLOCK_ID_COUNT];
+        static std::string              s_Names[BLOCK_ID_COUNT];
+        static std::vector<std::string> s_TextureNames;
+
+    public:
+        // Ids the file leaves out are plain opaque full blocks, air is always empty. Returns false when the
+        // file can't be read, the defaults stay in place then.
+        static bool Load(const std::string_view& filename);
+
+        // Hides the faces of blocks next to it and blocks light.
+        static bool IsOpaque(BlockType type) { return (s_Opaque[(U8)type >> 6] >> ((U8)type & 63)) & 1; }
+        // Has faces to mesh, false for air and blocks whose every face names no texture.
+        static bool IsMeshed(BlockType type) { return (s_Meshed[(U8)type >> 6] >> ((U8)type & 63)) & 1; }
+        static bool HasCollision(BlockType type) { return s_Collision[(U8)type] != CollisionShape::None; }
+        static CollisionShape GetCollisionShape(BlockType type) { return s_Collision[(U8)type]; }
+        // Block light level the block emits, 0 to LIGHT_MAX.
+        static U8 GetEmission(BlockType type) { return s_Emission[(U8)type]; }
+        static F32 GetHardness(BlockType type) { return s_Hardness[(U8)type]; }
+        static U16 GetTextureLayer(BlockType type, BlockFace face) { return s_TextureLayers[(U32)face][(U8)type]; }
+        static const std::string& GetName(BlockType type) { return s_Names[(U8)type]; }
+
+        // Every texture the definitions name, in texture layer order.
+        static const std::vector<std::string>& GetTextureNames() { return s_TextureNames; }
+
+    private:
+        static void Reset();
+        static bool ParseDefinition(const std::string& line);
+        static U16 AddTexture(const std::string& name);
+    };
+}
@@ -0,0 +1,234 @@
+#include "BlockStorage.h"
+
+#include "../Blocks/BlockRegistry.h"
+
+namespace MC {
+
+    BlockStorage::BlockStorage()
+        : m_BitsPerBlock(0) {
+
+        m_Palette.push_back(BlockType::Air);
+    }
+
+    BlockStorage::BlockStorage(BlockType type)
+        : m_BitsPerBlock(0) {
+
+        m_Palette.push_back(type);
+    }
+
+    void BlockStorage::Set(U32 index, BlockType type) {
+
+        BRQ_ASSERT(index < (SECTION_SIZE));
+
+        if (m_BitsPerBlock == 0 && m_Palette[0] == type)
+            return;
+
+        U32 paletteIndex = 0;
+
+        for (; paletteIndex < (U32)m_Palette.size(); paletteIndex++) {
+
+            if (m_Palette[paletteIndex] == type)
+                break;
+        }
+
+        if (paletteIndex == (U32)m_Palette.size()) {
+
+            m_Palette.push_back(type);
+
+            U32 bitsPerBlock = GetBitsForPaletteSize(m_Palette.size());
+
+            if (bitsPerBlock != m_BitsPerBlock) {
+
+                std::vector<U32> remap(m_Palette.size());
+
+                for (U32 i = 0; i < (U32)remap.size(); i++)
+                    remap[i] = i;
+
+                Repack(bitsPerBlock, remap);
+            }
+        }
+
+        SetPaletteIndex(index, paletteIndex);
+    }
+
+    void BlockStorage::Fill(BlockType type) {
+
+        m_Palette.clear();
+        m_Palette.push_back(type);
+
+        m_Data.clear();
+        m_Data.shrink_to_fit();
+
+        m_BitsPerBlock = 0;
+    }
+
+    void BlockStorage::Load(const BlockType* blocks) {
+
+        U8 lookup[256];
+        std::memset(lookup, 0xFF, sizeof(lookup));
+
+        m_Palette.clear();
+
+        for (U32 i = 0; i < (SECTION_SIZE); i++) {
+
+            U8 type = (U8)blocks[i];
+
+            if (lookup[type] == 0xFF) {
+
+                lookup[type] = (U8)m_Palette.size();
+                m_Palette.push_back(blocks[i]);
+            }
+        }
+
+        m_BitsPerBlock = GetBitsForPaletteSize(m_Palette.size());
+
+        if (m_BitsPerBlock == 0) {
+
+            m_Data.clear();
+            m_Data.shrink_to_fit();
+            return;
+        }
+
+        m_Data.assign((SECTION_SIZE) * m_BitsPerBlock / 64, 0);
+
+        U32 blocksPerWord = 64 / m_BitsPerBlock;
+
+        for (U32 i = 0; i < (SECTION_SIZE); i++)
+            m_Data[i / blocksPerWord] |= (U64)lookup[(U8)blocks[i]] << ((i % blocksPerWord) * m_BitsPerBlock);
+    }
+
+    void BlockStorage::Optimize() {
+
+        if (m_BitsPerBlock == 0)
+            return;
+
+        std::vector<U32> usage(m_Palette.size(), 0);
+
+        for (U32 i = 0; i < (SECTION_SIZE); i++)
+            usage[GetPaletteIndex(i)]++;
+
+        std::vector<BlockType> palette;
+        std::vector<U32> remap(m_Palette.size(), 0);
+
+        for (U32 i = 0; i < (U32)m_Palette.size(); i++) {
+
+            if (usage[i] == 0)
+                continue;
+
+            remap[i] = (U32)palette.size();
+            palette.push_back(m_Palette[i]);
+        }
+
+        if (palette.size() == 1) {
+
+            Fill(palette[0]);
+            return;
+        }
+
+        U32 bitsPerBlock = GetBitsForPaletteSize(palette.size());
+
+        if (palette.size() == m_Palette.size() && bitsPerBlock == m_BitsPerBlock)
+            return;
+
+        Repack(bitsPerBlock, remap);
+
+        m_Palette = std::move(palette);
+    }
+
+    bool BlockStorage::IsOpaque() const {
+
+        return std::all_of(m_Palette.begin(), m_Palette.end(), BlockRegistry::IsOpaque);
+    }
+
+    U64 BlockStorage::GetMemoryUsage() const {
+
+        return sizeof(BlockStorage) + m_Palette.capacity() * sizeof(BlockType) + m_Data.capacity() * sizeof(U64);
+    }
+
+    void BlockStorage::Serialize(std::vector<BYTE>& data) const {
+
+        data.push_back((BYTE)m_BitsPerBlock);
+        data.push_back((BYTE)(m_Palette.size() - 1));
+
+        for (BlockType type : m_Palette)
+            data.push_back((BYTE)type);
+
+        const BYTE* words = (const BYTE*)m_Data.data();
+        data.insert(data.end(), words, words + m_Data.size() * sizeof(U64));
+    }
+
+    bool BlockStorage::Deserialize(const BYTE* data, U64 size, U64& used) {
+
+        if (size < 2)
+            return false;
+
+        U32 bitsPerBlock = data[0];
+        U64 paletteSize = (U64)data[1] + 1;
+
+        if (bitsPerBlock != GetBitsForPaletteSize(paletteSize))
+            return false;
+
+        U64 wordCount = (SECTION_SIZE) * bitsPerBlock / 64;
+
+        U64 storageSize = 2 + paletteSize + wordCount * sizeof(U64);
+
+        if (size < storageSize)
+            return false;
+
+        for (U64 i = 0; i < paletteSize; i++) {
+
+            if (data[2 + i] >= (BYTE)BlockType::BlockTypeMaxEnumerations)
+                return false;
+        }
+
+        m_BitsPerBlock = bitsPerBlock;
+        m_Palette.assign((const BlockType*)(data + 2), (const BlockType*)(data + 2 + paletteSize));
+        m_Data.resize(wordCount);
+
+        std::memcpy(m_Data.data(), data + 2 + paletteSize, wordCount * sizeof(U64));
+
+        used = storageSize;
+
+        return true;
+    }
+
+    void BlockStorage::SetPaletteIndex(U32 index, U32 paletteIndex) {
+
+        U32 blocksPerWord = 64 / m_BitsPerBlock;
+        U32 shift = (index % blocksPerWord) * m_BitsPerBlock;
+        U64 mask = (1ULL << m_BitsPerBlock) - 1;
+
+        U64& word = m_Data[index / blocksPerWord];
+        word = (word & ~(mask << shift)) | ((U64)paletteIndex << shift);
+    }
+
+    void BlockStorage::Repack(U32 bitsPerBlock, const std::vector<U32>& remap) {
+
+        std::vector<U64> data((SECTION_SIZE) * bitsPerBlock / 64, 0);
+
+        U32 blocksPerWord = 64 / bitsPerBlock;
+
+        for (U32 i = 0; i < (SECTION_SIZE); i++) {
+
+            U64 paletteIndex = remap[m_BitsPerBlock == 0 ? 0 : GetPaletteIndex(i)];
+            data[i / blocksPerWord] |= paletteIndex << ((i % blocksPerWord) * bitsPerBlock);
+        }
+
+        m_Data = std::move(data);
+        m_BitsPerBlock = bitsPerBlock;
+    }
+
+    U32 BlockStorage::GetBitsForPaletteSize(U64 size) {
+
+        if (size <= 1)
+            return 0;
+        if (size <= 2)
+            return 1;
+        if (size <= 4)
+            return 2;
+        if (size <= 16)
+            return 4;
+
+        return 8;
+    }
+}
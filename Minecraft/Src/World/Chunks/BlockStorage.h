@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Engine.h>
+
+#include "../WorldConfig.h"
+#include "../Blocks/Block.h"
+
+namespace MC {
+
+    // Palette compressed block storage for one chunk section. Every block stores an index into
+    // m_Palette packed into 1, 2, 4 or 8 bits, the width grows when the palette overflows. A storage
+    // with a single palette entry (all air, all stone, ...) keeps no index data at all.
+    class BlockStorage {
+
+    private:
+        std::vector<BlockType> m_Palette;
+        std::vector<U64>       m_Data;
+        U32                    m_BitsPerBlock;
+
+    public:
+        BlockStorage();
+        BlockStorage(BlockType type);
+        ~BlockStorage() = default;
+
+        BlockType Get(U32 index) const {
+
+            if (m_BitsPerBlock == 0)
+                return m_Palette[0];
+
+            return m_Palette[GetPaletteIndex(index)];
+        }
+
+        void Set(U32 index, BlockType type);
+
+        void Fill(BlockType type);
+
+        // Rebuilds the storage from SECTION_SIZE blocks laid out by ToIndex, with the smallest palette that fits.
+        void Load(const BlockType* blocks);
+
+        // Drops unused palette entries and shrinks the index width to the smallest that fits.
+        void Optimize();
+
+        bool IsUniform() const { return m_BitsPerBlock == 0; }
+        // Every block is opaque per BlockRegistry::IsOpaque. Conservative until Optimize, palette entries are only dropped there.
+        bool IsOpaque() const;
+        U32 GetBitsPerBlock() const { return m_BitsPerBlock; }
+        const std::vector<BlockType>& GetPalette() const { return m_Palette; }
+
+        U64 GetMemoryUsage() const;
+
+        // Appends bits per block, the palette and the packed indices to data.
+        void Serialize(std::vector<BYTE>& data) const;
+        // Reads one serialized storage from the front of data and sets used to its size in bytes.
+        // Returns false if data does not start with a complete serialized storage, the storage is left unchanged then.
+        bool Deserialize(const BYTE* data, U64 size, U64& used);
+
+        // Bits per block, the palette size byte, a full palette of 256 types and 8 bit indices.
+        static constexpr U64 GetMaxSerializedSize() { return 2 + 256 + (SECTION_SIZE); }
+
+        // y is relative to the section.
+        static U32 ToIndex(U32 x, U32 y, U32 z) { return x + CHUNK_WIDTH * (z + CHUNK_LENGTH * y); }
+
+    private:
+        U32 GetPaletteIndex(U32 index) const {
+
+            U32 blocksPerWord = 64 / m_BitsPerBlock;
+            U32 shift = (index % blocksPerWord) * m_BitsPerBlock;
+            U64 mask = (1ULL << m_BitsPerBlock) - 1;
+
+            return (U32)((m_Data[index / blocksPerWord] >> shift) & mask);
+        }
+
+        void SetPaletteIndex(U32 index, U32 paletteIndex);
+
+        void Repack(U32 bitsPerBlock, const std::vector<U32>& remap);
+
+        static U32 GetBitsForPaletteSize(U64 size);
+    };
+}
@@ -0,0 +1,376 @@
+#include "Chunk.h"
+
+#include <atomic>
+
+#include "../Culling/SectionVisibility.h"
+
+namespace MC {
+
+    Chunk::Chunk()
+        : m_Position(0.0f), m_Revision(1), m_MeshRevision(0), m_MeshPending(false), m_Modified(false), m_Lit(false), m_Populated(false), m_Lod(0),
+          m_DirtySections(SECTION_MASK), m_DirtyBorders(0) {
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            m_Sections[section] = GetUniformSection(BlockType::Air);
+            m_Light[section] = GetUniformLight(0);
+            m_SectionMeshes[section] = {};
+            m_SectionMeshRevisions[section] = 0;
+            m_SectionVisibility[section] = SectionVisibility::All;
+        }
+    }
+
+    void Chunk::SetBlock(BlockType type, const glm::vec3& position) {
+
+        U32 x = (U32)position.x;
+        U32 y = (U32)position.y;
+        U32 z = (U32)position.z;
+
+        BRQ_ASSERT(x < CHUNK_WIDTH && y < CHUNK_HEIGHT && z < CHUNK_LENGTH);
+
+        if (GetBlockType(x, y, z) == type)
+            return;
+
+        U32 section = y / SECTION_HEIGHT;
+        U32 sectionY = y % SECTION_HEIGHT;
+
+        GetWritableSection(section).Set(BlockStorage::ToIndex(x, sectionY, z), type);
+
+        m_DirtySections |= 1u << section;
+
+        // Blocks on a section boundary also decide which faces of the section next to them are visible.
+        if (sectionY == 0 && section > 0)
+            m_DirtySections |= 1u << (section - 1);
+        else if (sectionY == SECTION_HEIGHT - 1 && section < SECTION_COUNT - 1)
+            m_DirtySections |= 1u << (section + 1);
+
+        m_Revision++;
+        m_Modified = true;
+    }
+
+    Block Chunk::GetBlock(const glm::vec3& position) const {
+
+        U32 x = (U32)position.x;
+        U32 y = (U32)position.y;
+        U32 z = (U32)position.z;
+
+        BRQ_ASSERT(x < CHUNK_WIDTH && y < CHUNK_HEIGHT && z < CHUNK_LENGTH);
+
+        Block block;
+        block.Type = GetBlockType(x, y, z);
+        block.IsRendered = block.Type != BlockType::Air;
+
+        return block;
+    }
+
+    void Chunk::LoadChunk(const glm::vec3 position, const Block blocks[CHUNK_WIDTH][CHUNK_HEIGHT][CHUNK_LENGTH]) {
+
+        m_Position = position;
+
+        BlockType sectionBlocks[SECTION_SIZE];
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            for (U32 x = 0; x < CHUNK_WIDTH; x++) {
+
+                for (U32 y = 0; y < SECTION_HEIGHT; y++) {
+
+                    for (U32 z = 0; z < CHUNK_LENGTH; z++) {
+
+                        sectionBlocks[BlockStorage::ToIndex(x, y, z)] = blocks[x][section * SECTION_HEIGHT + y][z].Type;
+                    }
+                }
+            }
+
+            LoadSection(section, sectionBlocks);
+        }
+    }
+
+    void Chunk::LoadBlocks(const BlockType* blocks) {
+
+        for (U32 section = 0; section < SECTION_COUNT; section++)
+            LoadSection(section, blocks + section * (SECTION_SIZE));
+    }
+
+    void Chunk::LoadSection(U32 section, const BlockType* blocks) {
+
+        std::shared_ptr<BlockStorage> storage = std::make_shared<BlockStorage>();
+        storage->Load(blocks);
+
+        m_Sections[section] = storage->IsUniform() ? GetUniformSection(storage->GetPalette()[0]) : std::move(storage);
+
+        MarkSectionsDirty(1u << section);
+        m_Modified = true;
+    }
+
+    void Chunk::FillSection(U32 section, BlockType type) {
+
+        m_Sections[section] = GetUniformSection(type);
+
+        MarkSectionsDirty(1u << section);
+        m_Modified = true;
+    }
+
+    void Chunk::Optimize(U32 sectionMask) {
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            std::shared_ptr<BlockStorage>& storage = m_Sections[section];
+
+            // Shared storage is either a uniform section already or still read by a meshing snapshot.
+            if (!(sectionMask & (1u << section)) || storage.use_count() > 1)
+                continue;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            storage->Optimize();
+
+            if (storage->IsUniform())
+                storage = GetUniformSection(storage->GetPalette()[0]);
+        }
+    }
+
+    U64 Chunk::GetMemoryUsage() const {
+
+        U64 usage = sizeof(Chunk);
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            if (m_Sections[section] != GetUniformSection(m_Sections[section]->GetPalette()[0]))
+                usage += m_Sections[section]->GetMemoryUsage();
+        }
+
+        return usage;
+    }
+
+    void Chunk::Serialize(std::vector<BYTE>& data) const {
+
+        data.push_back((BYTE)SECTION_COUNT);
+
+        for (U32 section = 0; section < SECTION_COUNT; section++)
+            m_Sections[section]->Serialize(data);
+
+        data.push_back((BYTE)m_Populated);
+    }
+
+    bool Chunk::Deserialize(const BYTE* data, U64 size) {
+
+        if (size < 1 || data[0] != SECTION_COUNT)
+            return false;
+
+        std::shared_ptr<BlockStorage> sections[SECTION_COUNT];
+        U64 offset = 1;
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            U64 used = 0;
+
+            sections[section] = std::make_shared<BlockStorage>();
+
+            if (!sections[section]->Deserialize(data + offset, size - offset, used))
+                return false;
+
+            offset += used;
+        }
+
+        // Chunks saved before population existed end after the sections, they count as populated so features never
+        // land on top of what players built there.
+        bool populated = true;
+
+        if (offset + 1 == size)
+            populated = data[offset++] != 0;
+
+        if (offset != size)
+            return false;
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            if (sections[section]->IsUniform())
+                m_Sections[section] = GetUniformSection(sections[section]->GetPalette()[0]);
+            else
+                m_Sections[section] = std::move(sections[section]);
+        }
+
+        m_Populated = populated;
+
+        MarkSectionsDirty(SECTION_MASK);
+        m_Modified = true;
+
+        return true;
+    }
+
+    void Chunk::MarkSectionsDirty(U32 sectionMask) {
+
+        m_DirtySections |= sectionMask;
+        m_Revision++;
+    }
+
+    void Chunk::MarkBorderDirty(BlockFace face) {
+
+        m_DirtyBorders |= 1u << (U32)face;
+        m_Revision++;
+    }
+
+    void Chunk::ClearDirty() {
+
+        m_DirtySections = 0;
+        m_DirtyBorders = 0;
+    }
+
+    void Chunk::SetLight(U32 x, U32 y, U32 z, U8 light) {
+
+        GetWritableLight(y / SECTION_HEIGHT).Set(BlockStorage::ToIndex(x, y % SECTION_HEIGHT, z), light);
+    }
+
+    void Chunk::FillSectionLight(U32 section, U8 light) {
+
+        m_Light[section] = GetUniformLight(light);
+    }
+
+    void Chunk::OptimizeLight(U32 sectionMask) {
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            std::shared_ptr<LightStorage>& light = m_Light[section];
+
+            if (!(sectionMask & (1u << section)) || light.use_count() > 1)
+                continue;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            light->Optimize();
+
+            if (light->IsUniform())
+                light = GetUniformLight(light->Get(0));
+        }
+    }
+
+    void Chunk::CopyLight(const Chunk& snapshot, U32 sectionMask) {
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            if (sectionMask & (1u << section))
+                m_Light[section] = snapshot.m_Light[section];
+        }
+    }
+
+    void Chunk::SetCoordinate(const ChunkCoordinate& coordinate) {
+
+        m_Coordinate = coordinate;
+        m_Position = glm::vec3(coordinate.X * CHUNK_WIDTH, 0.0f, coordinate.Z * CHUNK_LENGTH);
+    }
+
+    void Chunk::SetMeshes(const BRQ::VoxelMeshData* sectionMeshes, const U16* sectionVisibility, U32 sectionMask, U32 revision, std::vector<BRQ::Mesh>& retired) {
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            // Sections are meshed independently, a newer mesh of this section may already be uploaded.
+            if (!(sectionMask & (1u << section)) || revision <= m_SectionMeshRevisions[section])
+                continue;
+
+            BRQ::Mesh& mesh = m_SectionMeshes[section];
+
+            // The mesh arena replaces the old mesh in place, only meshes that became empty are handed back.
+            if (!sectionMeshes[section].Indicies.empty()) {
+
+                mesh.LoadMesh(sectionMeshes[section]);
+            }
+            else if (mesh.IndexCount) {
+
+                retired.push_back(mesh);
+                mesh = {};
+            }
+
+            m_SectionMeshRevisions[section] = revision;
+            m_SectionVisibility[section] = sectionVisibility[section];
+        }
+
+        m_MeshRevision = std::max(m_MeshRevision, revision);
+    }
+
+    void Chunk::DestroyMeshes() {
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            if (m_SectionMeshes[section].IndexCount)
+                m_SectionMeshes[section].DestroyMesh();
+
+            m_SectionMeshes[section] = {};
+            m_SectionMeshRevisions[section] = 0;
+            m_SectionVisibility[section] = SectionVisibility::All;
+        }
+
+        m_MeshRevision = 0;
+    }
+
+    void Chunk::ReleaseMeshes(std::vector<BRQ::Mesh>& meshes) {
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            if (m_SectionMeshes[section].IndexCount)
+                meshes.push_back(m_SectionMeshes[section]);
+
+            m_SectionMeshes[section] = {};
+            m_SectionMeshRevisions[section] = 0;
+            m_SectionVisibility[section] = SectionVisibility::All;
+        }
+
+        m_MeshRevision = 0;
+    }
+
+    BlockStorage& Chunk::GetWritableSection(U32 section) {
+
+        std::shared_ptr<BlockStorage>& storage = m_Sections[section];
+
+        // Uniform sections are always shared, so they get their own storage here as well.
+        if (storage.use_count() > 1)
+            storage = std::make_shared<BlockStorage>(*storage);
+
+        // Pairs with the release in the reference count drop of the last snapshot that shared the storage.
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        return *storage;
+    }
+
+    LightStorage& Chunk::GetWritableLight(U32 section) {
+
+        std::shared_ptr<LightStorage>& light = m_Light[section];
+
+        if (light.use_count() > 1)
+            light = std::make_shared<LightStorage>(*light);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        return *light;
+    }
+
+    const std::shared_ptr<BlockStorage>& Chunk::GetUniformSection(BlockType type) {
+
+        static const std::vector<std::shared_ptr<BlockStorage>> sections = []() {
+
+            std::vector<std::shared_ptr<BlockStorage>> result;
+
+            for (U32 i = 0; i < (U32)BlockType::BlockTypeMaxEnumerations; i++)
+                result.push_back(std::make_shared<BlockStorage>((BlockType)i));
+
+            return result;
+        }();
+
+        return sections[(U32)type];
+    }
+
+    const std::shared_ptr<LightStorage>& Chunk::GetUniformLight(U8 light) {
+
+        static const std::vector<std::shared_ptr<LightStorage>> lights = []() {
+
+            std::vector<std::shared_ptr<LightStorage>> result;
+
+            for (U32 i = 0; i < 256; i++)
+                result.push_back(std::make_shared<LightStorage>((U8)i));
+
+            return result;
+        }();
+
+        return lights[light];
+    }
+}
\ No newline at end of file
@@ -1,24 +1,157 @@
 #pragma once
 
+#include <memory>
+
 #include "../WorldConfig.h"
 #include "../Blocks/Block.h"
+#include "../Blocks/BlockData.h"
+#include "BlockStorage.h"
+#include "LightStorage.h"
+#include "ChunkCoordinate.h"
 
 namespace MC {
 
+    // A column of SECTION_COUNT sections stacked along Y, each stored and meshed on its own.
     BRQ_ALIGN(16) class Chunk {
 
     private:
-        Block     m_Blocks[CHUNK_WIDTH][CHUNK_HEIGHT][CHUNK_LENGTH]; // Do we really want to allocate blocks on stack ????? 2 * 16 * 16 * 16 = 8KB per chunk
-        BRQ::Mesh m_ChunkMesh;
-        glm::vec3 m_Position;
+        // Sections are copy on write, copying a chunk for the meshing workers only copies pointers.
+        // Uniform sections (all air, all dirt, ...) point at one storage per block type shared by every chunk.
+        // Solid sections of several types, stone with ores, keep their own storage since their blocks can still be dug
+        // out. Meshing skips them while they're buried, see ChunkMesher::IsSectionHidden.
+        std::shared_ptr<BlockStorage> m_Sections[SECTION_COUNT];
+        // Shared the same way, open sky and buried sections point at one storage per light value.
+        std::shared_ptr<LightStorage> m_Light[SECTION_COUNT];
+
+        BRQ::Mesh       m_SectionMeshes[SECTION_COUNT];
+        U32             m_SectionMeshRevisions[SECTION_COUNT];
+        // Face connectivity of each section as of its current mesh, see SectionVisibility. Unmeshed sections connect everything.
+        U16             m_SectionVisibility[SECTION_COUNT];
+
+        glm::vec3       m_Position;
+        ChunkCoordinate m_Coordinate;
+
+        // Bumped by everything that changes the mesh, the mesh revision tells which revision the newest section mesh was built from.
+        U32             m_Revision;
+        U32             m_MeshRevision;
+        bool            m_MeshPending;
+        bool            m_Modified;
+        bool            m_Lit;
+        // Trees and other features that cross into neighbours have been placed, see ChunkPopulator. Saved with the blocks.
+        bool            m_Populated;
+        // Level of detail the chunk is meshed at, see LodMesher.
+        U8              m_Lod;
+
+        // What changed since the last mesh snapshot: a bit per section and a bit per BlockFace border.
+        U32             m_DirtySections;
+        U8              m_DirtyBorders;
 
     public:
-        Chunk() = default;
+        Chunk();
         ~Chunk() = default;
 
+        // Positions are relative to the chunk, y spans the whole column.
         void SetBlock(BlockType type, const glm::vec3& position);
-        Block GetBlock(const glm::vec3& position);
+        Block GetBlock(const glm::vec3& position) const;
+
+        BlockType GetBlockType(U32 x, U32 y, U32 z) const {
+
+            return m_Sections[y / SECTION_HEIGHT]->Get(BlockStorage::ToIndex(x, y % SECTION_HEIGHT, z));
+        }
+
+        void LoadChunk(const glm::vec3 position, const Block blocks[CHUNK_WIDTH][CHUNK_HEIGHT][CHUNK_LENGTH]);
+
+        // Replaces every block at once, blocks holds SECTION_COUNT sections of SECTION_SIZE blocks laid out by BlockStorage::ToIndex.
+        void LoadBlocks(const BlockType* blocks);
+        // Replaces one section from SECTION_SIZE blocks, or with a single block type without any storage.
+        void LoadSection(U32 section, const BlockType* blocks);
+        void FillSection(U32 section, BlockType type);
+
+        // Shrinks the palettes of the given sections and turns sections that became uniform back into shared ones.
+        void Optimize(U32 sectionMask);
+
+        const BlockStorage& GetSection(U32 section) const { return *m_Sections[section]; }
+        bool IsSectionEmpty(U32 section) const { return m_Sections[section]->IsUniform() && m_Sections[section]->GetPalette()[0] == BlockType::Air; }
+        bool IsSectionSolid(U32 section) const { return m_Sections[section]->IsOpaque(); }
+
+        // Light is written by the lighting worker on snapshots, chunks stay dark until their first lighting job is applied.
+        U8 GetLight(U32 x, U32 y, U32 z) const {
+
+            return m_Light[y / SECTION_HEIGHT]->Get(BlockStorage::ToIndex(x, y % SECTION_HEIGHT, z));
+        }
+
+        void SetLight(U32 x, U32 y, U32 z, U8 light);
+        void FillSectionLight(U32 section, U8 light);
+        void OptimizeLight(U32 sectionMask);
+
+        // Takes over the light of the sections in sectionMask from a lighting snapshot of this chunk.
+        void CopyLight(const Chunk& snapshot, U32 sectionMask);
+
+        const LightStorage& GetSectionLight(U32 section) const { return *m_Light[section]; }
+
+        bool IsLit() const { return m_Lit; }
+        void SetLit(bool lit) { m_Lit = lit; }
+
+        bool IsPopulated() const { return m_Populated; }
+        void SetPopulated(bool populated) { m_Populated = populated; }
+        // Population changes what the chunk saves even when it placed nothing in this chunk.
+        void MarkPopulated() { m_Populated = true; m_Modified = true; }
+
+        U32 GetLod() const { return m_Lod; }
+        void SetLod(U32 lod) { m_Lod = (U8)lod; }
+
+        void SetCoordinate(const ChunkCoordinate& coordinate);
+        const ChunkCoordinate& GetCoordinate() const { return m_Coordinate; }
+
+        const glm::vec3& GetPosition() const { return m_Position; }
+        glm::vec3 GetSectionPosition(U32 section) const { return m_Position + glm::vec3(0.0f, (F32)(section * SECTION_HEIGHT), 0.0f); }
+
+        // Block storage owned by this chunk alone, shared uniform sections are free.
+        U64 GetMemoryUsage() const;
+
+        void Serialize(std::vector<BYTE>& data) const;
+        bool Deserialize(const BYTE* data, U64 size);
+
+        // Section count, every section at its largest and the populated flag.
+        static constexpr U64 GetMaxSerializedSize() { return 1 + SECTION_COUNT * BlockStorage::GetMaxSerializedSize() + 1; }
+
+        // Modified chunks differ from what was last generated, loaded or saved.
+        bool IsModified() const { return m_Modified; }
+        void MarkSaved() { m_Modified = false; }
+
+        // Lighting and other non block changes that need the given sections remeshed.
+        void MarkSectionsDirty(U32 sectionMask);
+        // The neighbour across face changed along the shared border.
+        void MarkBorderDirty(BlockFace face);
+
+        bool IsDirty() const { return m_DirtySections || m_DirtyBorders; }
+        // Sections to remesh, a dirty border touches every section.
+        U32 GetDirtySections() const { return m_DirtyBorders ? SECTION_MASK : m_DirtySections; }
+        U8 GetDirtyBorders() const { return m_DirtyBorders; }
+        // Called once the dirty state has been handed to the mesher.
+        void ClearDirty();
+
+        U32 GetRevision() const { return m_Revision; }
+        U32 GetMeshRevision() const { return m_MeshRevision; }
+        bool IsMeshPending() const { return m_MeshPending; }
+        void SetMeshPending(bool pending) { m_MeshPending = pending; }
+
+        // Uploads the section meshes in sectionMask that are older than revision, on the calling thread which must be
+        // the render thread, and takes over their face connectivity. Meshes that became empty are appended to retired,
+        // frames in flight may still read them.
+        void SetMeshes(const BRQ::VoxelMeshData* sectionMeshes, const U16* sectionVisibility, U32 sectionMask, U32 revision, std::vector<BRQ::Mesh>& retired);
+        void DestroyMeshes();
+
+        // Hands the GPU meshes to the caller without destroying them.
+        void ReleaseMeshes(std::vector<BRQ::Mesh>& meshes);
+        const BRQ::Mesh& GetSectionMesh(U32 section) const { return m_SectionMeshes[section]; }
+        U16 GetSectionVisibility(U32 section) const { return m_SectionVisibility[section]; }
+
+    private:
+        BlockStorage& GetWritableSection(U32 section);
+        LightStorage& GetWritableLight(U32 section);
 
-        void LoadChunk(const glm::vec3 position, const Block blocks[CHUNK_WIDTH][CHUNK_HEIGHT][CHUNK_LENGTH]); 
+        static const std::shared_ptr<BlockStorage>& GetUniformSection(BlockType type);
+        static const std::shared_ptr<LightStorage>& GetUniformLight(U8 light);
     };
-}
\ No newline at end of file
+}
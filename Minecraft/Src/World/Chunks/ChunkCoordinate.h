@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Engine.h>
+
+#include "../WorldConfig.h"
+
+namespace MC {
+
+    // Rounds towards negative infinity, unlike integer division.
+    inline I32 FloorDivide(I32 value, I32 divisor) {
+
+        I32 quotient = value / divisor;
+
+        return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+    }
+
+    struct ChunkCoordinate {
+
+        I32 X = 0;
+        I32 Z = 0;
+
+        bool operator==(const ChunkCoordinate& other) const { return X == other.X && Z == other.Z; }
+        bool operator!=(const ChunkCoordinate& other) const { return !(*this == other); }
+
+        static ChunkCoordinate FromBlock(I32 x, I32 z) { return { FloorDivide(x, CHUNK_WIDTH), FloorDivide(z, CHUNK_LENGTH) }; }
+    };
+
+    struct ChunkCoordinateHash {
+
+        U64 operator()(const ChunkCoordinate& coordinate) const {
+
+            U64 key = ((U64)(U32)coordinate.X << 32) | (U32)coordinate.Z;
+            key ^= key >> 33;
+            key *= 0xff51afd7ed558ccdULL;
+            key ^= key >> 33;
+
+            return key;
+        }
+    };
+}
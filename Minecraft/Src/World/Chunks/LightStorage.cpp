@@ -0,0 +1,46 @@
+#include "LightStorage.h"
+
+namespace MC {
+
+    LightStorage::LightStorage(U8 light)
+        : m_Uniform(light) { }
+
+    void LightStorage::Set(U32 index, U8 light) {
+
+        BRQ_ASSERT(index < (SECTION_SIZE));
+
+        if (m_Data.empty()) {
+
+            if (light == m_Uniform)
+                return;
+
+            m_Data.assign(SECTION_SIZE, m_Uniform);
+        }
+
+        m_Data[index] = light;
+    }
+
+    void LightStorage::Fill(U8 light) {
+
+        m_Data.clear();
+        m_Data.shrink_to_fit();
+
+        m_Uniform = light;
+    }
+
+    void LightStorage::Optimize() {
+
+        if (m_Data.empty())
+            return;
+
+        U8 light = m_Data[0];
+
+        for (U8 value : m_Data) {
+
+            if (value != light)
+                return;
+        }
+
+        Fill(light);
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Engine.h>
+
+#include "../WorldConfig.h"
+
+namespace MC {
+
+    // Sky and block light of one chunk section, 4 bits each, sky light in the high nibble of every
+    // byte. A storage where every block has the same light (open sky, buried rock) keeps no data.
+    class LightStorage {
+
+    private:
+        std::vector<U8> m_Data;
+        U8              m_Uniform;
+
+    public:
+        LightStorage(U8 light = 0);
+        ~LightStorage() = default;
+
+        U8 Get(U32 index) const { return m_Data.empty() ? m_Uniform : m_Data[index]; }
+        U8 GetSky(U32 index) const { return Get(index) >> 4; }
+        U8 GetBlock(U32 index) const { return Get(index) & 15; }
+
+        void Set(U32 index, U8 light);
+        void SetSky(U32 index, U8 level) { Set(index, (U8)((level << 4) | (Get(index) & 15))); }
+        void SetBlock(U32 index, U8 level) { Set(index, (U8)((Get(index) & 0xF0) | level)); }
+
+        void Fill(U8 light);
+
+        // Drops the data again when every block ended up with the same light.
+        void Optimize();
+
+        bool IsUniform() const { return m_Data.empty(); }
+
+        U64 GetMemoryUsage() const { return sizeof(LightStorage) + m_Data.capacity(); }
+
+        static U8 Pack(U8 sky, U8 block) { return (U8)((sky << 4) | block); }
+    };
+}
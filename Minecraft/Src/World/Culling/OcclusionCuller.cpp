@@ -0,0 +1,104 @@
+#include "OcclusionCuller.h"
+
+namespace MC {
+
+    static const U8 s_NoEntry = (U8)BlockFace::BlockFaceMaxEnumerations;
+
+    OcclusionCuller::OcclusionCuller()
+        : m_Radius(0), m_Size(0) { }
+
+    void OcclusionCuller::Begin(const ChunkCoordinate& center, I32 radius) {
+
+        m_Center = center;
+        m_Radius = radius;
+        m_Size = radius * 2 + 1;
+
+        m_Grid.assign((U64)m_Size * m_Size, nullptr);
+    }
+
+    void OcclusionCuller::AddChunk(const Chunk& chunk) {
+
+        I32 x = chunk.GetCoordinate().X - m_Center.X + m_Radius;
+        I32 z = chunk.GetCoordinate().Z - m_Center.Z + m_Radius;
+
+        if (x < 0 || z < 0 || x >= m_Size || z >= m_Size)
+            return;
+
+        m_Grid[x + z * m_Size] = &chunk;
+    }
+
+    void OcclusionCuller::Cull(const glm::vec3& cameraPosition, const BRQ::Frustum& frustum, std::vector<VisibleSection>& visible) {
+
+        glm::ivec3 block = glm::ivec3(glm::floor(cameraPosition + 0.5f));
+        ChunkCoordinate coordinate = ChunkCoordinate::FromBlock(block.x, block.z);
+
+        I32 startX = coordinate.X - m_Center.X + m_Radius;
+        I32 startZ = coordinate.Z - m_Center.Z + m_Radius;
+
+        bool inside = block.y >= 0 && block.y < CHUNK_HEIGHT && startX >= 0 && startZ >= 0 && startX < m_Size && startZ < m_Size;
+
+        if (!inside || !GetChunk(startX, startZ)) {
+
+            for (const Chunk* chunk : m_Grid) {
+
+                if (!chunk)
+                    continue;
+
+                for (U32 section = 0; section < SECTION_COUNT; section++)
+                    visible.push_back({ chunk, section });
+            }
+
+            return;
+        }
+
+        m_Visited.assign((U64)m_Size * m_Size * SECTION_COUNT, 0);
+        m_Queue.clear();
+
+        Step start = { startX, block.y / SECTION_HEIGHT, startZ, s_NoEntry, 0 };
+
+        m_Visited[ToVisitedIndex(start.X, start.Y, start.Z)] = 1;
+        m_Queue.push_back(start);
+
+        // The queue only grows, every section enters it at most once.
+        for (U64 next = 0; next < m_Queue.size(); next++) {
+
+            Step step = m_Queue[next];
+            const Chunk* chunk = GetChunk(step.X, step.Z);
+
+            visible.push_back({ chunk, (U32)step.Y });
+
+            U16 visibility = chunk->GetSectionVisibility((U32)step.Y);
+
+            for (U32 face = 0; face < (U32)BlockFace::BlockFaceMaxEnumerations; face++) {
+
+                // Faces come in pairs, face ^ 1 is the opposite direction.
+                if (step.Directions & (1u << (face ^ 1)))
+                    continue;
+
+                if (step.Entry != s_NoEntry && !SectionVisibility::IsConnected(visibility, (BlockFace)step.Entry, (BlockFace)face))
+                    continue;
+
+                I32 x = step.X + FaceNormals[face][0];
+                I32 y = step.Y + FaceNormals[face][1];
+                I32 z = step.Z + FaceNormals[face][2];
+
+                if (x < 0 || z < 0 || x >= m_Size || z >= m_Size || y < 0 || y >= SECTION_COUNT)
+                    continue;
+
+                const Chunk* neighbour = GetChunk(x, z);
+                U8& visited = m_Visited[ToVisitedIndex(x, y, z)];
+
+                if (!neighbour || visited)
+                    continue;
+
+                glm::vec3 min = neighbour->GetSectionPosition((U32)y) - 0.5f;
+
+                if (!frustum.Intersects(min, min + glm::vec3(CHUNK_WIDTH, SECTION_HEIGHT, CHUNK_LENGTH)))
+                    continue;
+
+                visited = 1;
+                m_Queue.push_back({ x, y, z, (U8)(face ^ 1), (U8)(step.Directions | (1u << face)) });
+            }
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Engine.h>
+
+#include "SectionVisibility.h"
+
+namespace MC {
+
+    struct VisibleSection {
+
+        const Chunk* Column;
+        U32          Section;
+    };
+
+    // Cave culling: a breadth first walk from the camera's section through the face connectivity of SectionVisibility.
+    // A section is left only through faces connected to the one the walk entered by, and never towards a direction
+    // the walk already moved away from, so sections behind solid terrain are never reached. Sections outside the
+    // frustum end the walk as well.
+    class OcclusionCuller {
+
+    private:
+        struct Step {
+
+            I32 X;
+            I32 Y;
+            I32 Z;
+            // BlockFace the section was entered through, BlockFaceMaxEnumerations for the camera's section.
+            U8  Entry;
+            // Bit per BlockFace the walk moved towards to get here.
+            U8  Directions;
+        };
+
+        // Chunks around the camera chunk in a dense square, missing chunks stop the walk.
+        std::vector<const Chunk*> m_Grid;
+        ChunkCoordinate           m_Center;
+        I32                       m_Radius;
+        I32                       m_Size;
+
+        std::vector<U8>           m_Visited;
+        std::vector<Step>         m_Queue;
+
+    public:
+        OcclusionCuller();
+        ~OcclusionCuller() = default;
+
+        // Starts a new frame, only chunks within radius of center take part.
+        void Begin(const ChunkCoordinate& center, I32 radius);
+        void AddChunk(const Chunk& chunk);
+
+        // Appends the reachable sections to visible. With the camera outside the world or its chunk missing there is
+        // nothing to walk from, and every section of every chunk is appended.
+        void Cull(const glm::vec3& cameraPosition, const BRQ::Frustum& frustum, std::vector<VisibleSection>& visible);
+
+    private:
+        const Chunk* GetChunk(I32 x, I32 z) const { return m_Grid[x + z * m_Size]; }
+        U32 ToVisitedIndex(I32 x, I32 y, I32 z) const { return (U32)(x + m_Size * (z + m_Size * y)); }
+    };
+}
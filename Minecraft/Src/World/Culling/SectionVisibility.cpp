@@ -0,0 +1,142 @@
+#include "SectionVisibility.h"
+
+#include "../Blocks/BlockRegistry.h"
+
+#include <array>
+
+namespace MC {
+
+    static const U32 s_FaceCount = (U32)BlockFace::BlockFaceMaxEnumerations;
+
+    static const std::array<std::array<U16, 6>, 6> s_PairBits = []() {
+
+        std::array<std::array<U16, 6>, 6> bits = {};
+        U32 pair = 0;
+
+        for (U32 a = 0; a < s_FaceCount; a++) {
+
+            for (U32 b = a + 1; b < s_FaceCount; b++) {
+
+                bits[a][b] = (U16)(1u << pair);
+                bits[b][a] = (U16)(1u << pair);
+                pair++;
+            }
+        }
+
+        return bits;
+    }();
+
+    // Every pair among a set of faces, indexed by a bit mask of BlockFaces.
+    static const std::array<U16, 64> s_FaceSetPairs = []() {
+
+        std::array<U16, 64> pairs = {};
+
+        for (U32 faces = 0; faces < 64; faces++)
+            for (U32 a = 0; a < s_FaceCount; a++)
+                for (U32 b = a + 1; b < s_FaceCount; b++)
+                    if ((faces & (1u << a)) && (faces & (1u << b)))
+                        pairs[faces] |= s_PairBits[a][b];
+
+        return pairs;
+    }();
+
+    U16 SectionVisibility::GetPairBit(BlockFace a, BlockFace b) {
+
+        return s_PairBits[(U32)a][(U32)b];
+    }
+
+    U16 SectionVisibility::Compute(const BlockStorage& section) {
+
+        if (section.IsOpaque())
+            return None;
+
+        if (section.IsUniform())
+            return All;
+
+        // See through blocks no flood fill has reached yet.
+        U8 open[SECTION_SIZE];
+
+        for (U32 i = 0; i < (SECTION_SIZE); i++)
+            open[i] = !BlockRegistry::IsOpaque(section.Get(i));
+
+        const U32 strideZ = CHUNK_WIDTH;
+        const U32 strideY = CHUNK_WIDTH * CHUNK_LENGTH;
+
+        U16 stack[SECTION_SIZE];
+        U16 visibility = None;
+
+        // Each fill covers one pocket of see through blocks and connects every face it touches. Pockets touching no face connect nothing.
+        for (U32 start = 0; start < (SECTION_SIZE) && visibility != All; start++) {
+
+            if (!open[start])
+                continue;
+
+            U32 faces = 0;
+            U32 top = 0;
+
+            open[start] = 0;
+            stack[top++] = (U16)start;
+
+            auto visit = [&open, &stack, &top](U32 index) {
+
+                if (open[index]) {
+
+                    open[index] = 0;
+                    stack[top++] = (U16)index;
+                }
+            };
+
+            while (top) {
+
+                U32 index = stack[--top];
+
+                U32 x = index % CHUNK_WIDTH;
+                U32 z = (index / strideZ) % CHUNK_LENGTH;
+                U32 y = index / strideY;
+
+                if (x == 0)
+                    faces |= 1u << (U32)BlockFace::Left;
+                else
+                    visit(index - 1);
+
+                if (x == CHUNK_WIDTH - 1)
+                    faces |= 1u << (U32)BlockFace::Right;
+                else
+                    visit(index + 1);
+
+                if (z == 0)
+                    faces |= 1u << (U32)BlockFace::Back;
+                else
+                    visit(index - strideZ);
+
+                if (z == CHUNK_LENGTH - 1)
+                    faces |= 1u << (U32)BlockFace::Front;
+                else
+                    visit(index + strideZ);
+
+                if (y == 0)
+                    faces |= 1u << (U32)BlockFace::Bottom;
+                else
+                    visit(index - strideY);
+
+                if (y == SECTION_HEIGHT - 1)
+                    faces |= 1u << (U32)BlockFace::Top;
+                else
+                    visit(index + strideY);
+            }
+
+            visibility |= s_FaceSetPairs[faces];
+        }
+
+        return visibility;
+    }
+
+    void SectionVisibility::Compute(const Chunk& chunk, U32 sectionMask, U16* visibility) {
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            if (sectionMask & (1u << section))
+                visibility[section] = Compute(chunk.GetSection(section));
+        }
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Engine.h>
+
+#include "../Chunks/Chunk.h"
+
+namespace MC {
+
+    // Which pairs of a section's 6 faces are connected through see through blocks inside it, one bit per unordered pair of BlockFaces.
+    // A view entering through one face can only leave through faces connected to it, which is what the occlusion culler walks.
+    class SectionVisibility {
+
+    public:
+        static constexpr U16 None = 0;
+        static constexpr U16 All  = 0x7FFF;
+
+        static U16 Compute(const BlockStorage& section);
+        // Computes the sections of chunk in sectionMask into visibility, indexed by section.
+        static void Compute(const Chunk& chunk, U32 sectionMask, U16* visibility);
+
+        static bool IsConnected(U16 visibility, BlockFace a, BlockFace b) { return (visibility & GetPairBit(a, b)) != 0; }
+        static U16 GetPairBit(BlockFace a, BlockFace b);
+    };
+}
@@ -0,0 +1,113 @@
+#include "ChunkPopulator.h"
+
+namespace MC {
+
+    // splitmix64, the same sequence on every platform unlike the standard distributions.
+    static U64 NextRandom(U64& state) {
+
+        U64 value = (state += 0x9E3779B97F4A7C15ULL);
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+
+        return value ^ (value >> 31);
+    }
+
+    static U32 NextRandom(U64& state, U32 bound) {
+
+        return (U32)(NextRandom(state) % bound);
+    }
+
+    ChunkPopulator::ChunkPopulator(const PopulationSettings& settings)
+        : m_Settings(settings) { }
+
+    void ChunkPopulator::Populate(const Chunk& chunk, std::vector<PopulationEdit>& edits) const {
+
+        const ChunkCoordinate& coordinate = chunk.GetCoordinate();
+
+        U64 random = ((U64)m_Settings.Seed << 32) ^ ((U64)(U32)coordinate.X * 0x9E3779B1ULL) ^ ((U64)(U32)coordinate.Z * 0x85EBCA77ULL << 16);
+        NextRandom(random);
+
+        glm::ivec3 origin(coordinate.X * CHUNK_WIDTH, 0, coordinate.Z * CHUNK_LENGTH);
+
+        for (U32 i = 0; i < m_Settings.TreeAttempts; i++) {
+
+            U32 x = NextRandom(random, CHUNK_WIDTH);
+            U32 z = NextRandom(random, CHUNK_LENGTH);
+            U32 trunk = m_Settings.MinTrunk + NextRandom(random, m_Settings.MaxTrunk - m_Settings.MinTrunk + 1);
+
+            // Features of neighbours never add or remove grass, so the topmost grass is the same whichever of them
+            // were populated first. Columns where a cave opened the surface have none.
+            I32 ground = CHUNK_HEIGHT - 1;
+
+            while (ground >= 0 && chunk.GetBlockType(x, (U32)ground, z) != BlockType::Grass)
+                ground--;
+
+            if (ground < 0 || ground + (I32)trunk + 2 >= CHUNK_HEIGHT)
+                continue;
+
+            PlaceTree(origin + glm::ivec3(x, ground, z), trunk, edits);
+        }
+
+        for (U32 i = 0; i < m_Settings.VeinsPerChunk; i++) {
+
+            U32 x = NextRandom(random, CHUNK_WIDTH);
+            U32 z = NextRandom(random, CHUNK_LENGTH);
+            I32 y = 1 + (I32)NextRandom(random, (U32)m_Settings.VeinMaxHeight);
+
+            BlockType type = NextRandom(random, 4) == 0 && y < m_Settings.VeinMaxHeight / 2 ? BlockType::Gold : BlockType::Iron;
+
+            PlaceVein(origin + glm::ivec3(x, y, z), type, random, edits);
+        }
+    }
+
+    bool ChunkPopulator::CanReplace(BlockType existing, BlockType type) {
+
+        switch (type) {
+
+            case BlockType::Log:    return existing == BlockType::Air || existing == BlockType::Leaves;
+            case BlockType::Leaves: return existing == BlockType::Air;
+            case BlockType::Iron:   return existing == BlockType::Dirt;
+            case BlockType::Gold:   return existing == BlockType::Dirt || existing == BlockType::Iron;
+            default:                return false;
+        }
+    }
+
+    void ChunkPopulator::PlaceTree(const glm::ivec3& ground, U32 trunk, std::vector<PopulationEdit>& edits) const {
+
+        I32 top = ground.y + (I32)trunk;
+
+        // Two wide layers around the upper trunk without their corners, then a small cross on top.
+        for (I32 y = top - 2; y <= top + 1; y++) {
+
+            I32 radius = y < top ? 2 : 1;
+
+            for (I32 dz = -radius; dz <= radius; dz++) {
+
+                for (I32 dx = -radius; dx <= radius; dx++) {
+
+                    if (std::abs(dx) == radius && std::abs(dz) == radius)
+                        continue;
+
+                    edits.push_back({ glm::ivec3(ground.x + dx, y, ground.z + dz), BlockType::Leaves });
+                }
+            }
+        }
+
+        for (I32 y = ground.y + 1; y <= top; y++)
+            edits.push_back({ glm::ivec3(ground.x, y, ground.z), BlockType::Log });
+    }
+
+    void ChunkPopulator::PlaceVein(glm::ivec3 position, BlockType type, U64& random, std::vector<PopulationEdit>& edits) const {
+
+        static const I32 s_Steps[6][3] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+
+        for (U32 i = 0; i < m_Settings.VeinLength; i++) {
+
+            if (position.y > 0 && position.y < CHUNK_HEIGHT)
+                edits.push_back({ position, type });
+
+            const I32* step = s_Steps[NextRandom(random, 6)];
+            position += glm::ivec3(step[0], step[1], step[2]);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../Chunks/Chunk.h"
+
+namespace MC {
+
+    struct PopulationSettings {
+
+        U32 Seed          = WORLD_SEED;
+
+        // Candidate columns per chunk, only columns with grass on top grow a tree.
+        U32 TreeAttempts  = 3;
+        U32 MinTrunk      = 4;
+        U32 MaxTrunk      = 6;
+
+        U32 VeinsPerChunk = 6;
+        U32 VeinLength    = 10;
+        // Veins start below this height.
+        I32 VeinMaxHeight = 40;
+    };
+
+    // Block position in world blocks and what to place there, see ChunkPopulator::CanReplace.
+    struct PopulationEdit {
+
+        glm::ivec3 Position;
+        BlockType  Type;
+    };
+
+    // Second generation stage, run once a chunk and its 8 neighbours have terrain. Places trees and ore veins that
+    // start in the chunk and may reach up to one chunk into its neighbours.
+    // Edits are a pure function of the seed, the coordinate and where the chunk's terrain has grass, and CanReplace
+    // resolves overlapping features the same way in any order, so neighbours can be populated in any order.
+    class ChunkPopulator {
+
+    private:
+        PopulationSettings m_Settings;
+
+    public:
+        ChunkPopulator(const PopulationSettings& settings = PopulationSettings());
+        ~ChunkPopulator() = default;
+
+        // Appends the edits of chunk's features to edits, chunk is only read.
+        void Populate(const Chunk& chunk, std::vector<PopulationEdit>& edits) const;
+
+        const PopulationSettings& GetSettings() const { return m_Settings; }
+
+        // Features only overwrite what they may grow into: logs win over leaves, gold over iron, ores only replace dirt.
+        static bool CanReplace(BlockType existing, BlockType type);
+
+    private:
+        void PlaceTree(const glm::ivec3& ground, U32 trunk, std::vector<PopulationEdit>& edits) const;
+        void PlaceVein(glm::ivec3 position, BlockType type, U64& random, std::vector<PopulationEdit>& edits) const;
+    };
+}
@@ -0,0 +1,111 @@
+#include "GenerationWorkerPool.h"
+
+namespace MC {
+
+    GenerationWorkerPool::GenerationWorkerPool()
+        : m_Generator(nullptr), m_Running(false) { }
+
+    GenerationWorkerPool::~GenerationWorkerPool() {
+
+        Shutdown();
+    }
+
+    void GenerationWorkerPool::Init(const TerrainGenerator* generator, U32 threadCount) {
+
+        BRQ_ASSERT(!m_Running);
+
+        if (threadCount == 0) {
+
+            U32 hardwareThreads = std::thread::hardware_concurrency();
+            threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        m_Generator = generator;
+        m_Running = true;
+
+        m_Workers.reserve(threadCount);
+
+        for (U32 i = 0; i < threadCount; i++)
+            m_Workers.emplace_back(&GenerationWorkerPool::WorkerLoop, this);
+    }
+
+    void GenerationWorkerPool::Shutdown() {
+
+        {
+            std::lock_guard<std::mutex> lock(m_JobMutex);
+
+            if (!m_Running)
+                return;
+
+            m_Running = false;
+            m_Jobs.clear();
+        }
+
+        m_JobAvailable.notify_all();
+
+        for (auto& worker : m_Workers)
+            worker.join();
+
+        m_Workers.clear();
+
+        std::lock_guard<std::mutex> lock(m_CompletedMutex);
+        m_Completed.clear();
+    }
+
+    void GenerationWorkerPool::Submit(const ChunkCoordinate& coordinate) {
+
+        {
+            std::lock_guard<std::mutex> lock(m_JobMutex);
+            m_Jobs.push_back(coordinate);
+        }
+
+        m_JobAvailable.notify_one();
+    }
+
+    void GenerationWorkerPool::PollCompleted(std::vector<GenerationResult>& results) {
+
+        std::lock_guard<std::mutex> lock(m_CompletedMutex);
+
+        for (auto& result : m_Completed)
+            results.push_back(std::move(result));
+
+        m_Completed.clear();
+    }
+
+    U64 GenerationWorkerPool::GetQueuedJobCount() {
+
+        std::lock_guard<std::mutex> lock(m_JobMutex);
+
+        return m_Jobs.size();
+    }
+
+    void GenerationWorkerPool::WorkerLoop() {
+
+        while (true) {
+
+            ChunkCoordinate coordinate;
+
+            {
+                std::unique_lock<std::mutex> lock(m_JobMutex);
+                m_JobAvailable.wait(lock, [this]() { return !m_Running || !m_Jobs.empty(); });
+
+                if (!m_Running)
+                    return;
+
+                coordinate = m_Jobs.front();
+                m_Jobs.pop_front();
+            }
+
+            GenerationResult result;
+            result.Coordinate = coordinate;
+            result.Generated = std::make_shared<Chunk>();
+            result.Generated->SetCoordinate(coordinate);
+
+            m_Generator->Generate(*result.Generated);
+            result.Generated->MarkSaved();
+
+            std::lock_guard<std::mutex> lock(m_CompletedMutex);
+            m_Completed.push_back(std::move(result));
+        }
+    }
+}
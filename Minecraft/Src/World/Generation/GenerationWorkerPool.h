@@ -0,0 +1,60 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+#include "TerrainGenerator.h"
+
+namespace MC {
+
+    struct GenerationResult {
+
+        ChunkCoordinate        Coordinate;
+        // Freshly generated and marked saved, nothing else refers to it yet.
+        std::shared_ptr<Chunk> Generated;
+    };
+
+    // Generates terrain for chunk coordinates on worker threads. Terrain only depends on the seed and the coordinate,
+    // so results are identical whichever thread picks a chunk up and in whatever order, and they can be applied as
+    // they complete.
+    class GenerationWorkerPool {
+
+    private:
+        std::vector<std::thread>      m_Workers;
+
+        std::deque<ChunkCoordinate>   m_Jobs;
+        std::mutex                    m_JobMutex;
+        std::condition_variable       m_JobAvailable;
+
+        std::vector<GenerationResult> m_Completed;
+        std::mutex                    m_CompletedMutex;
+
+        const TerrainGenerator*       m_Generator;
+        bool                          m_Running;
+
+    public:
+        GenerationWorkerPool();
+        ~GenerationWorkerPool();
+
+        GenerationWorkerPool(const GenerationWorkerPool&) = delete;
+        GenerationWorkerPool& operator=(const GenerationWorkerPool&) = delete;
+
+        // generator has to outlive the pool. threadCount 0 uses every hardware thread except the one running the frame loop.
+        void Init(const TerrainGenerator* generator, U32 threadCount = 0);
+        // Drops queued coordinates and finished chunks nobody polled.
+        void Shutdown();
+
+        void Submit(const ChunkCoordinate& coordinate);
+
+        // Moves every finished chunk into results, never blocks on the workers.
+        void PollCompleted(std::vector<GenerationResult>& results);
+
+        U32 GetThreadCount() const { return (U32)m_Workers.size(); }
+        U64 GetQueuedJobCount();
+
+    private:
+        void WorkerLoop();
+    };
+}
@@ -0,0 +1,214 @@
+#include "GradientNoise.h"
+#include "GradientNoiseKernel.h"
+
+#if defined(MC_NOISE_X86) && defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace MC {
+
+    namespace NoiseKernels {
+
+        struct ScalarOps {
+
+            using Float = F32;
+            using Int   = U32;
+            using Mask  = bool;
+
+            static constexpr U32 Width = 1;
+
+            static Float Load(const F32* data) { return *data; }
+            static void Store(F32* data, Float value) { *data = value; }
+
+            static Float Set(F32 value) { return value; }
+            static Int SetInt(U32 value) { return value; }
+
+            static Float Add(Float a, Float b) { return a + b; }
+            static Float Sub(Float a, Float b) { return a - b; }
+            static Float Mul(Float a, Float b) { return a * b; }
+            static Float Floor(Float value) { return std::floor(value); }
+            static Int ToInt(Float value) { return (U32)(I32)value; }
+
+            static Int Add(Int a, Int b) { return a + b; }
+            static Int Mul(Int a, Int b) { return a * b; }
+            static Int Xor(Int a, Int b) { return a ^ b; }
+            static Int And(Int a, Int b) { return a & b; }
+            static Int ShiftRight(Int value, I32 bits) { return value >> bits; }
+
+            static Mask Less(Int value, U32 bound) { return value < bound; }
+            static Mask Equal(Int value, U32 other) { return value == other; }
+            static Mask TestBit(Int value, U32 bit) { return (value & bit) != 0; }
+            static Mask Or(Mask a, Mask b) { return a || b; }
+
+            static Float Select(Mask mask, Float a, Float b) { return mask ? a : b; }
+        };
+
+        void Accumulate2DScalar(I32 seed, const F32* x, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude) {
+
+            GradientKernel<ScalarOps>::Accumulate2D(seed, x, z, out, count, frequency, amplitude);
+        }
+
+        void Accumulate3DScalar(I32 seed, const F32* x, const F32* y, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude) {
+
+            GradientKernel<ScalarOps>::Accumulate3D(seed, x, y, z, out, count, frequency, amplitude);
+        }
+    }
+
+    static bool CpuSupportsAVX2() {
+
+#if defined(MC_NOISE_X86) && defined(_MSC_VER)
+        I32 info[4];
+
+        __cpuid(info, 0);
+
+        if (info[0] < 7)
+            return false;
+
+        // The OS has to save the YMM registers as well.
+        __cpuid(info, 1);
+
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+
+        if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+
+        return (info[1] & (1 << 5)) != 0;
+#elif defined(MC_NOISE_X86) && defined(__GNUC__)
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+
+    static SimdLevel DetectSimdLevel() {
+
+#ifdef MC_NOISE_X86
+        return CpuSupportsAVX2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    SimdLevel GradientNoise::s_SimdLevel = DetectSimdLevel();
+
+    GradientNoise::GradientNoise(U32 seed)
+        : m_Seed((I32)seed) { }
+
+    void GradientNoise::Accumulate2D(const F32* x, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude) const {
+
+        U32 done = 0;
+
+#ifdef MC_NOISE_X86
+        if (s_SimdLevel == SimdLevel::AVX2)
+            done = NoiseKernels::Accumulate2DAVX2(m_Seed, x, z, out, count, frequency, amplitude);
+        else if (s_SimdLevel == SimdLevel::SSE2)
+            done = NoiseKernels::Accumulate2DSSE2(m_Seed, x, z, out, count, frequency, amplitude);
+#endif
+
+        NoiseKernels::Accumulate2DScalar(m_Seed, x + done, z + done, out + done, count - done, frequency, amplitude);
+    }
+
+    void GradientNoise::Accumulate3D(const F32* x, const F32* y, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude) const {
+
+        U32 done = 0;
+
+#ifdef MC_NOISE_X86
+        if (s_SimdLevel == SimdLevel::AVX2)
+            done = NoiseKernels::Accumulate3DAVX2(m_Seed, x, y, z, out, count, frequency, amplitude);
+        else if (s_SimdLevel == SimdLevel::SSE2)
+            done = NoiseKernels::Accumulate3DSSE2(m_Seed, x, y, z, out, count, frequency, amplitude);
+#endif
+
+        NoiseKernels::Accumulate3DScalar(m_Seed, x + done, y + done, z + done, out + done, count - done, frequency, amplitude);
+    }
+
+    void GradientNoise::Fractal2D(const F32* x, const F32* z, F32* out, U32 count, F32 frequency, U32 octaves) const {
+
+        std::fill(out, out + count, 0.0f);
+
+        F32 amplitude = 1.0f;
+        F32 total = 0.0f;
+
+        for (U32 octave = 0; octave < octaves; octave++) {
+
+            GradientNoise((U32)m_Seed + octave).Accumulate2D(x, z, out, count, frequency, amplitude);
+
+            total += amplitude;
+            frequency *= 2.0f;
+            amplitude *= 0.5f;
+        }
+
+        for (U32 i = 0; i < count; i++)
+            out[i] /= total;
+    }
+
+    void GradientNoise::Fractal3D(const F32* x, const F32* y, const F32* z, F32* out, U32 count, F32 frequency, U32 octaves) const {
+
+        std::fill(out, out + count, 0.0f);
+
+        F32 amplitude = 1.0f;
+        F32 total = 0.0f;
+
+        for (U32 octave = 0; octave < octaves; octave++) {
+
+            GradientNoise((U32)m_Seed + octave).Accumulate3D(x, y, z, out, count, frequency, amplitude);
+
+            total += amplitude;
+            frequency *= 2.0f;
+            amplitude *= 0.5f;
+        }
+
+        for (U32 i = 0; i < count; i++)
+            out[i] /= total;
+    }
+
+    F32 GradientNoise::Sample2D(F32 x, F32 z) const {
+
+        F32 out = 0.0f;
+        NoiseKernels::Accumulate2DScalar(m_Seed, &x, &z, &out, 1, 1.0f, 1.0f);
+
+        return out;
+    }
+
+    F32 GradientNoise::Sample3D(F32 x, F32 y, F32 z) const {
+
+        F32 out = 0.0f;
+        NoiseKernels::Accumulate3DScalar(m_Seed, &x, &y, &z, &out, 1, 1.0f, 1.0f);
+
+        return out;
+    }
+
+    bool GradientNoise::IsSupported(SimdLevel level) {
+
+        switch (level) {
+
+            case SimdLevel::Scalar: return true;
+#ifdef MC_NOISE_X86
+            case SimdLevel::SSE2:   return true;
+            case SimdLevel::AVX2:   return CpuSupportsAVX2();
+#endif
+            default:                return false;
+        }
+    }
+
+    void GradientNoise::SetSimdLevel(SimdLevel level) {
+
+        BRQ_ASSERT(IsSupported(level));
+
+        s_SimdLevel = level;
+    }
+
+    const char* GradientNoise::GetSimdLevelName(SimdLevel level) {
+
+        switch (level) {
+
+            case SimdLevel::Scalar: return "Scalar";
+            case SimdLevel::SSE2:   return "SSE2";
+            case SimdLevel::AVX2:   return "AVX2";
+            default:                return "Unknown";
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Engine.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #define MC_NOISE_X86
+#endif
+
+namespace MC {
+
+    enum class SimdLevel : U8 {
+
+        Scalar = 0,
+        SSE2,
+        AVX2,
+    };
+
+    // Seeded gradient (Perlin) noise evaluated in batches. Coordinates are passed as
+    // structure of arrays and every call accumulates amplitude * noise(p * frequency) into out,
+    // so fractal sums cost one pass per octave. All SIMD levels produce the same values as the scalar path.
+    class GradientNoise {
+
+    private:
+        static SimdLevel s_SimdLevel;
+
+        I32              m_Seed;
+
+    public:
+        GradientNoise(U32 seed = 0);
+        ~GradientNoise() = default;
+
+        void Accumulate2D(const F32* x, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude) const;
+        void Accumulate3D(const F32* x, const F32* y, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude) const;
+
+        // Sums octaves with doubling frequency and halving amplitude, out is overwritten.
+        void Fractal2D(const F32* x, const F32* z, F32* out, U32 count, F32 frequency, U32 octaves) const;
+        void Fractal3D(const F32* x, const F32* y, const F32* z, F32* out, U32 count, F32 frequency, U32 octaves) const;
+
+        F32 Sample2D(F32 x, F32 z) const;
+        F32 Sample3D(F32 x, F32 y, F32 z) const;
+
+        static bool IsSupported(SimdLevel level);
+        static void SetSimdLevel(SimdLevel level);
+        static SimdLevel GetSimdLevel() { return s_SimdLevel; }
+        static const char* GetSimdLevelName(SimdLevel level);
+    };
+
+    namespace NoiseKernels {
+
+        void Accumulate2DScalar(I32 seed, const F32* x, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude);
+        void Accumulate3DScalar(I32 seed, const F32* x, const F32* y, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude);
+
+#ifdef MC_NOISE_X86
+        // Process count rounded down to a multiple of the vector width and return how many were done.
+        U32 Accumulate2DSSE2(I32 seed, const F32* x, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude);
+        U32 Accumulate3DSSE2(I32 seed, const F32* x, const F32* y, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude);
+
+        U32 Accumulate2DAVX2(I32 seed, const F32* x, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude);
+        U32 Accumulate3DAVX2(I32 seed, const F32* x, const F32* y, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude);
+#endif
+    }
+}
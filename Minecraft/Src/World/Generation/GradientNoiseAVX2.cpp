@@ -0,0 +1,62 @@
+#include "GradientNoise.h"
+
+#ifdef MC_NOISE_X86
+
+// MSVC accepts AVX2 intrinsics without /arch:AVX2, GCC and Clang need the target enabled for this file.
+// Nothing here runs unless GradientNoise detected AVX2 support.
+#if defined(__GNUC__) && !defined(__AVX2__)
+    #pragma GCC target("avx2")
+#endif
+
+#include <immintrin.h>
+
+#include "GradientNoiseKernel.h"
+
+namespace MC { namespace NoiseKernels {
+
+    struct AVX2Ops {
+
+        using Float = __m256;
+        using Int   = __m256i;
+        using Mask  = __m256i;
+
+        static constexpr U32 Width = 8;
+
+        static Float Load(const F32* data) { return _mm256_loadu_ps(data); }
+        static void Store(F32* data, Float value) { _mm256_storeu_ps(data, value); }
+
+        static Float Set(F32 value) { return _mm256_set1_ps(value); }
+        static Int SetInt(U32 value) { return _mm256_set1_epi32((I32)value); }
+
+        static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+        static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+        static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+        static Float Floor(Float value) { return _mm256_floor_ps(value); }
+        static Int ToInt(Float value) { return _mm256_cvttps_epi32(value); }
+
+        static Int Add(Int a, Int b) { return _mm256_add_epi32(a, b); }
+        static Int Mul(Int a, Int b) { return _mm256_mullo_epi32(a, b); }
+        static Int Xor(Int a, Int b) { return _mm256_xor_si256(a, b); }
+        static Int And(Int a, Int b) { return _mm256_and_si256(a, b); }
+        static Int ShiftRight(Int value, I32 bits) { return _mm256_srli_epi32(value, bits); }
+
+        static Mask Less(Int value, U32 bound) { return _mm256_cmpgt_epi32(_mm256_set1_epi32((I32)bound), value); }
+        static Mask Equal(Int value, U32 other) { return _mm256_cmpeq_epi32(value, _mm256_set1_epi32((I32)other)); }
+        static Mask TestBit(Int value, U32 bit) { return Equal(And(value, SetInt(bit)), bit); }
+        static Mask Or(Mask a, Mask b) { return _mm256_or_si256(a, b); }
+
+        static Float Select(Mask mask, Float a, Float b) { return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(mask)); }
+    };
+
+    U32 Accumulate2DAVX2(I32 seed, const F32* x, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude) {
+
+        return GradientKernel<AVX2Ops>::Accumulate2D(seed, x, z, out, count, frequency, amplitude);
+    }
+
+    U32 Accumulate3DAVX2(I32 seed, const F32* x, const F32* y, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude) {
+
+        return GradientKernel<AVX2Ops>::Accumulate3D(seed, x, y, z, out, count, frequency, amplitude);
+    }
+} }
+
+#endif
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "GradientNoise.h"
+
+// Gradient noise written once against a small set of lane operations (see ScalarOps) and
+// instantiated per instruction set. Only include from the translation units that implement
+// NoiseKernels, each compiled for its own target.
+
+namespace MC { namespace NoiseKernels {
+
+    constexpr U32 PRIME_X = 501125321u;
+    constexpr U32 PRIME_Y = 1136930381u;
+    constexpr U32 PRIME_Z = 1720413743u;
+    constexpr U32 HASH_MULTIPLIER = 0x27d4eb2du;
+
+    template <typename Ops>
+    struct GradientKernel {
+
+        using Float = typename Ops::Float;
+        using Int   = typename Ops::Int;
+        using Mask  = typename Ops::Mask;
+
+        static Int Finalize(Int hash) {
+
+            hash = Ops::Mul(hash, Ops::SetInt(HASH_MULTIPLIER));
+            return Ops::Xor(hash, Ops::ShiftRight(hash, 15));
+        }
+
+        static Int Hash(Int seed, Int x, Int z) {
+
+            Int hash = Ops::Xor(seed, Ops::Mul(x, Ops::SetInt(PRIME_X)));
+            hash = Ops::Xor(hash, Ops::Mul(z, Ops::SetInt(PRIME_Z)));
+
+            return Finalize(hash);
+        }
+
+        static Int Hash(Int seed, Int x, Int y, Int z) {
+
+            Int hash = Ops::Xor(seed, Ops::Mul(x, Ops::SetInt(PRIME_X)));
+            hash = Ops::Xor(hash, Ops::Mul(y, Ops::SetInt(PRIME_Y)));
+            hash = Ops::Xor(hash, Ops::Mul(z, Ops::SetInt(PRIME_Z)));
+
+            return Finalize(hash);
+        }
+
+        static Float Negate(Mask mask, Float value) {
+
+            return Ops::Select(mask, Ops::Sub(Ops::Set(0.0f), value), value);
+        }
+
+        // 8 gradients of the form (+-1, +-2) and (+-2, +-1).
+        static Float Gradient(Int hash, Float x, Float z) {
+
+            Int h = Ops::And(hash, Ops::SetInt(7));
+
+            Mask low = Ops::Less(h, 4);
+            Float u = Ops::Select(low, x, z);
+            Float v = Ops::Select(low, z, x);
+
+            return Ops::Add(Negate(Ops::TestBit(h, 1), u), Negate(Ops::TestBit(h, 2), Ops::Add(v, v)));
+        }
+
+        // Improved Perlin noise gradients, the 12 cube edge directions padded to 16.
+        static Float Gradient(Int hash, Float x, Float y, Float z) {
+
+            Int h = Ops::And(hash, Ops::SetInt(15));
+
+            Float u = Ops::Select(Ops::Less(h, 8), x, y);
+            Float xz = Ops::Select(Ops::Or(Ops::Equal(h, 12), Ops::Equal(h, 14)), x, z);
+            Float v = Ops::Select(Ops::Less(h, 4), y, xz);
+
+            return Ops::Add(Negate(Ops::TestBit(h, 1), u), Negate(Ops::TestBit(h, 2), v));
+        }
+
+        static Float Fade(Float t) {
+
+            Float inner = Ops::Add(Ops::Mul(t, Ops::Sub(Ops::Mul(t, Ops::Set(6.0f)), Ops::Set(15.0f))), Ops::Set(10.0f));
+            return Ops::Mul(Ops::Mul(Ops::Mul(t, t), t), inner);
+        }
+
+        static Float Lerp(Float a, Float b, Float t) {
+
+            return Ops::Add(a, Ops::Mul(t, Ops::Sub(b, a)));
+        }
+
+        static Float Noise(Int seed, Float x, Float z) {
+
+            Float fx = Ops::Floor(x);
+            Float fz = Ops::Floor(z);
+
+            Int x0 = Ops::ToInt(fx);
+            Int z0 = Ops::ToInt(fz);
+            Int x1 = Ops::Add(x0, Ops::SetInt(1));
+            Int z1 = Ops::Add(z0, Ops::SetInt(1));
+
+            Float dx0 = Ops::Sub(x, fx);
+            Float dz0 = Ops::Sub(z, fz);
+            Float dx1 = Ops::Sub(dx0, Ops::Set(1.0f));
+            Float dz1 = Ops::Sub(dz0, Ops::Set(1.0f));
+
+            Float u = Fade(dx0);
+            Float v = Fade(dz0);
+
+            Float n00 = Gradient(Hash(seed, x0, z0), dx0, dz0);
+            Float n10 = Gradient(Hash(seed, x1, z0), dx1, dz0);
+            Float n01 = Gradient(Hash(seed, x0, z1), dx0, dz1);
+            Float n11 = Gradient(Hash(seed, x1, z1), dx1, dz1);
+
+            // Gradients reach length sqrt(5), scale back to roughly [-1, 1].
+            return Ops::Mul(Lerp(Lerp(n00, n10, u), Lerp(n01, n11, u), v), Ops::Set(0.5f));
+        }
+
+        static Float Noise(Int seed, Float x, Float y, Float z) {
+
+            Float fx = Ops::Floor(x);
+            Float fy = Ops::Floor(y);
+            Float fz = Ops::Floor(z);
+
+            Int x0 = Ops::ToInt(fx);
+            Int y0 = Ops::ToInt(fy);
+            Int z0 = Ops::ToInt(fz);
+            Int x1 = Ops::Add(x0, Ops::SetInt(1));
+            Int y1 = Ops::Add(y0, Ops::SetInt(1));
+            Int z1 = Ops::Add(z0, Ops::SetInt(1));
+
+            Float dx0 = Ops::Sub(x, fx);
+            Float dy0 = Ops::Sub(y, fy);
+            Float dz0 = Ops::Sub(z, fz);
+            Float dx1 = Ops::Sub(dx0, Ops::Set(1.0f));
+            Float dy1 = Ops::Sub(dy0, Ops::Set(1.0f));
+            Float dz1 = Ops::Sub(dz0, Ops::Set(1.0f));
+
+            Float u = Fade(dx0);
+            Float v = Fade(dy0);
+            Float w = Fade(dz0);
+
+            Float n000 = Gradient(Hash(seed, x0, y0, z0), dx0, dy0, dz0);
+            Float n100 = Gradient(Hash(seed, x1, y0, z0), dx1, dy0, dz0);
+            Float n010 = Gradient(Hash(seed, x0, y1, z0), dx0, dy1, dz0);
+            Float n110 = Gradient(Hash(seed, x1, y1, z0), dx1, dy1, dz0);
+            Float n001 = Gradient(Hash(seed, x0, y0, z1), dx0, dy0, dz1);
+            Float n101 = Gradient(Hash(seed, x1, y0, z1), dx1, dy0, dz1);
+            Float n011 = Gradient(Hash(seed, x0, y1, z1), dx0, dy1, dz1);
+            Float n111 = Gradient(Hash(seed, x1, y1, z1), dx1, dy1, dz1);
+
+            Float z0Plane = Lerp(Lerp(n000, n100, u), Lerp(n010, n110, u), v);
+            Float z1Plane = Lerp(Lerp(n001, n101, u), Lerp(n011, n111, u), v);
+
+            return Lerp(z0Plane, z1Plane, w);
+        }
+
+        static U32 Accumulate2D(I32 seed, const F32* x, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude) {
+
+            Int seeds = Ops::SetInt((U32)seed);
+            Float frequencies = Ops::Set(frequency);
+            Float amplitudes = Ops::Set(amplitude);
+
+            U32 i = 0;
+
+            for (; i + Ops::Width <= count; i += Ops::Width) {
+
+                Float px = Ops::Mul(Ops::Load(x + i), frequencies);
+                Float pz = Ops::Mul(Ops::Load(z + i), frequencies);
+
+                Float noise = Noise(seeds, px, pz);
+                Ops::Store(out + i, Ops::Add(Ops::Load(out + i), Ops::Mul(noise, amplitudes)));
+            }
+
+            return i;
+        }
+
+        static U32 Accumulate3D(I32 seed, const F32* x, const F32* y, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude) {
+
+            Int seeds = Ops::SetInt((U32)seed);
+            Float frequencies = Ops::Set(frequency);
+            Float amplitudes = Ops::Set(amplitude);
+
+            U32 i = 0;
+
+            for (; i + Ops::Width <= count; i += Ops::Width) {
+
+                Float px = Ops::Mul(Ops::Load(x + i), frequencies);
+                Float py = Ops::Mul(Ops::Load(y + i), frequencies);
+                Float pz = Ops::Mul(Ops::Load(z + i), frequencies);
+
+                Float noise = Noise(seeds, px, py, pz);
+                Ops::Store(out + i, Ops::Add(Ops::Load(out + i), Ops::Mul(noise, amplitudes)));
+            }
+
+            return i;
+        }
+    };
+} }
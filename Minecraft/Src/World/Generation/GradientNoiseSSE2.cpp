@@ -0,0 +1,76 @@
+#include "GradientNoise.h"
+
+#ifdef MC_NOISE_X86
+
+#include <emmintrin.h>
+
+#include "GradientNoiseKernel.h"
+
+namespace MC { namespace NoiseKernels {
+
+    struct SSE2Ops {
+
+        using Float = __m128;
+        using Int   = __m128i;
+        using Mask  = __m128i;
+
+        static constexpr U32 Width = 4;
+
+        static Float Load(const F32* data) { return _mm_loadu_ps(data); }
+        static void Store(F32* data, Float value) { _mm_storeu_ps(data, value); }
+
+        static Float Set(F32 value) { return _mm_set1_ps(value); }
+        static Int SetInt(U32 value) { return _mm_set1_epi32((I32)value); }
+
+        static Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+        static Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+        static Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+
+        // SSE2 has no round instruction, truncate and step down where that rounded up.
+        static Float Floor(Float value) {
+
+            Float truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(value));
+            return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, value), _mm_set1_ps(1.0f)));
+        }
+
+        static Int ToInt(Float value) { return _mm_cvttps_epi32(value); }
+
+        static Int Add(Int a, Int b) { return _mm_add_epi32(a, b); }
+
+        // No 32 bit multiply before SSE4.1, build it from the two 32x32->64 bit lanes.
+        static Int Mul(Int a, Int b) {
+
+            Int even = _mm_mul_epu32(a, b);
+            Int odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+            return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+        }
+
+        static Int Xor(Int a, Int b) { return _mm_xor_si128(a, b); }
+        static Int And(Int a, Int b) { return _mm_and_si128(a, b); }
+        static Int ShiftRight(Int value, I32 bits) { return _mm_srli_epi32(value, bits); }
+
+        static Mask Less(Int value, U32 bound) { return _mm_cmplt_epi32(value, _mm_set1_epi32((I32)bound)); }
+        static Mask Equal(Int value, U32 other) { return _mm_cmpeq_epi32(value, _mm_set1_epi32((I32)other)); }
+        static Mask TestBit(Int value, U32 bit) { return Equal(And(value, SetInt(bit)), bit); }
+        static Mask Or(Mask a, Mask b) { return _mm_or_si128(a, b); }
+
+        static Float Select(Mask mask, Float a, Float b) {
+
+            Float selector = _mm_castsi128_ps(mask);
+            return _mm_or_ps(_mm_and_ps(selector, a), _mm_andnot_ps(selector, b));
+        }
+    };
+
+    U32 Accumulate2DSSE2(I32 seed, const F32* x, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude) {
+
+        return GradientKernel<SSE2Ops>::Accumulate2D(seed, x, z, out, count, frequency, amplitude);
+    }
+
+    U32 Accumulate3DSSE2(I32 seed, const F32* x, const F32* y, const F32* z, F32* out, U32 count, F32 frequency, F32 amplitude) {
+
+        return GradientKernel<SSE2Ops>::Accumulate3D(seed, x, y, z, out, count, frequency, amplitude);
+    }
+} }
+
+#endif
@@ -0,0 +1,151 @@
+#include "TerrainGenerator.h"
+
+namespace MC {
+
+    static U32 HashBlock(U32 seed, I32 x, I32 y, I32 z) {
+
+        U32 hash = seed ^ (U32)x * 73856093u ^ (U32)y * 19349663u ^ (U32)z * 83492791u;
+        hash ^= hash >> 13;
+        hash *= 0x5bd1e995u;
+        hash ^= hash >> 15;
+
+        return hash;
+    }
+
+    TerrainGenerator::TerrainGenerator(const TerrainSettings& settings)
+        : m_Settings(settings), m_SurfaceNoise(settings.Seed), m_CaveNoise(settings.Seed * 0x9E3779B9u + 1) { }
+
+    void TerrainGenerator::Generate(Chunk& chunk) const {
+
+        Heightmap heightmap;
+        GenerateHeightmap(chunk.GetCoordinate(), heightmap);
+
+        BlockType blocks[SECTION_SIZE];
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            if (GenerateSection(chunk.GetCoordinate(), heightmap, section, blocks))
+                chunk.LoadSection(section, blocks);
+            else
+                chunk.FillSection(section, BlockType::Air);
+        }
+    }
+
+    void TerrainGenerator::Generate(const ChunkCoordinate& coordinate, BlockType* blocks) const {
+
+        Heightmap heightmap;
+        GenerateHeightmap(coordinate, heightmap);
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            BlockType* sectionBlocks = blocks + section * (SECTION_SIZE);
+
+            if (!GenerateSection(coordinate, heightmap, section, sectionBlocks))
+                std::fill(sectionBlocks, sectionBlocks + (SECTION_SIZE), BlockType::Air);
+        }
+    }
+
+    void TerrainGenerator::GenerateHeightmap(const ChunkCoordinate& coordinate, Heightmap& heightmap) const {
+
+        constexpr U32 COLUMNS = CHUNK_WIDTH * CHUNK_LENGTH;
+
+        F32 x[COLUMNS];
+        F32 z[COLUMNS];
+        F32 noise[COLUMNS];
+
+        for (U32 i = 0; i < COLUMNS; i++) {
+
+            x[i] = (F32)(coordinate.X * CHUNK_WIDTH + (I32)(i % CHUNK_WIDTH));
+            z[i] = (F32)(coordinate.Z * CHUNK_LENGTH + (I32)(i / CHUNK_WIDTH));
+        }
+
+        m_SurfaceNoise.Fractal2D(x, z, noise, COLUMNS, m_Settings.SurfaceFrequency, m_Settings.SurfaceOctaves);
+
+        heightmap.MinHeight = CHUNK_HEIGHT;
+        heightmap.MaxHeight = 0;
+
+        for (U32 i = 0; i < COLUMNS; i++) {
+
+            I32 height = (I32)std::floor(m_Settings.SurfaceHeight + m_Settings.SurfaceAmplitude * noise[i]);
+            heightmap.Heights[i] = std::clamp(height, 1, CHUNK_HEIGHT - 1);
+            heightmap.MinHeight = std::min(heightmap.MinHeight, heightmap.Heights[i]);
+            heightmap.MaxHeight = std::max(heightmap.MaxHeight, heightmap.Heights[i]);
+        }
+    }
+
+    bool TerrainGenerator::GenerateSection(const ChunkCoordinate& coordinate, const Heightmap& heightmap, U32 section, BlockType* blocks) const {
+
+        constexpr U32 COLUMNS = CHUNK_WIDTH * CHUNK_LENGTH;
+
+        I32 baseY = (I32)(section * SECTION_HEIGHT);
+
+        if (baseY > heightmap.MaxHeight)
+            return false;
+
+        I32 originX = coordinate.X * CHUNK_WIDTH;
+        I32 originZ = coordinate.Z * CHUNK_LENGTH;
+
+        F32 x[SECTION_SIZE];
+        F32 y[SECTION_SIZE];
+        F32 z[SECTION_SIZE];
+        F32 noise[SECTION_SIZE];
+
+        // Coordinates follow BlockStorage::ToIndex, every layer of COLUMNS entries shares the heightmap grid.
+        for (U32 i = 0; i < (SECTION_SIZE); i++) {
+
+            x[i] = (F32)(originX + (I32)(i % CHUNK_WIDTH));
+            z[i] = (F32)(originZ + (I32)((i / CHUNK_WIDTH) % CHUNK_LENGTH));
+            y[i] = (F32)(baseY + (I32)(i / COLUMNS));
+        }
+
+        // Only the layers between the cave floor and the highest column can be carved, skip the density for the rest.
+        I32 caveBegin = std::clamp(heightmap.MinHeight - m_Settings.CaveDepth - baseY, 0, SECTION_HEIGHT);
+        I32 caveEnd = std::clamp(heightmap.MaxHeight + 1 - baseY, 0, SECTION_HEIGHT);
+
+        if (caveBegin < caveEnd) {
+
+            U32 offset = (U32)caveBegin * COLUMNS;
+            U32 count = (U32)(caveEnd - caveBegin) * COLUMNS;
+
+            m_CaveNoise.Fractal3D(x + offset, y + offset, z + offset, noise + offset, count, m_Settings.CaveFrequency, m_Settings.CaveOctaves);
+        }
+
+        for (U32 i = 0; i < (SECTION_SIZE); i++) {
+
+            I32 height = heightmap.Heights[i % COLUMNS];
+            I32 layer = (I32)(i / COLUMNS);
+            I32 blockY = baseY + layer;
+
+            if (blockY > height) {
+
+                blocks[i] = BlockType::Air;
+                continue;
+            }
+
+            bool cave = layer >= caveBegin && layer < caveEnd && blockY > height - m_Settings.CaveDepth;
+
+            if (blockY > 0 && cave && noise[i] > m_Settings.CaveThreshold) {
+
+                blocks[i] = BlockType::Air;
+                continue;
+            }
+
+            if (blockY == height) {
+
+                blocks[i] = BlockType::Grass;
+                continue;
+            }
+
+            U32 ore = HashBlock(m_Settings.Seed, (I32)x[i], blockY, (I32)z[i]) % 256;
+
+            if (ore == 0 && blockY < height / 2)
+                blocks[i] = BlockType::Gold;
+            else if (ore < 4 && blockY < height - 2)
+                blocks[i] = BlockType::Iron;
+            else
+                blocks[i] = BlockType::Dirt;
+        }
+
+        return true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "GradientNoise.h"
+#include "../Chunks/Chunk.h"
+
+namespace MC {
+
+    struct TerrainSettings {
+
+        U32 Seed             = WORLD_SEED;
+
+        F32 SurfaceHeight    = CHUNK_HEIGHT * 0.375f;
+        F32 SurfaceAmplitude = CHUNK_HEIGHT * 0.125f;
+        F32 SurfaceFrequency = 1.0f / 64.0f;
+        U32 SurfaceOctaves   = 4;
+
+        // Blocks where the cave density rises above the threshold are carved out.
+        F32 CaveFrequency    = 1.0f / 16.0f;
+        U32 CaveOctaves      = 2;
+        F32 CaveThreshold    = 0.25f;
+        // Caves stay within this many blocks below the surface, deeper sections skip the density pass.
+        I32 CaveDepth        = 48;
+    };
+
+    // Fills whole chunks from seeded noise: an octave heightmap shapes the surface and 3D density carves caves.
+    // Sections above the highest column are filled with air without evaluating any noise.
+    // Generate is a pure function of the settings and the chunk coordinate: it keeps no state and never reads other chunks,
+    // so one generator can be shared between threads and chunks come out bit identical in any order on any thread.
+    class TerrainGenerator {
+
+    private:
+        TerrainSettings m_Settings;
+        GradientNoise   m_SurfaceNoise;
+        GradientNoise   m_CaveNoise;
+
+    public:
+        TerrainGenerator(const TerrainSettings& settings = TerrainSettings());
+        ~TerrainGenerator() = default;
+
+        void Generate(Chunk& chunk) const;
+
+        // blocks holds SECTION_COUNT sections of SECTION_SIZE entries laid out by BlockStorage::ToIndex.
+        void Generate(const ChunkCoordinate& coordinate, BlockType* blocks) const;
+
+        const TerrainSettings& GetSettings() const { return m_Settings; }
+
+    private:
+        struct Heightmap {
+
+            I32 Heights[CHUNK_WIDTH * CHUNK_LENGTH];
+            I32 MinHeight;
+            I32 MaxHeight;
+        };
+
+        void GenerateHeightmap(const ChunkCoordinate& coordinate, Heightmap& heightmap) const;
+
+        // Returns false and leaves blocks untouched when the whole section is air.
+        bool GenerateSection(const ChunkCoordinate& coordinate, const Heightmap& heightmap, U32 section, BlockType* blocks) const;
+    };
+}
@@ -0,0 +1,442 @@
+#include "LightPropagator.h"
+
+#include "../Blocks/BlockRegistry.h"
+
+#include <algorithm>
+
+namespace MC {
+
+    void LightPropagator::Run(LightingJob& job) {
+
+        if (job.Chunks.empty())
+            return;
+
+        BuildGrid(job);
+
+        // Removals first, they hand the light they could not remove to the add queues.
+        RemoveEdits(job.Edits);
+
+        for (LightChunk& chunk : job.Chunks) {
+
+            if (chunk.Initialize)
+                Initialize(chunk);
+        }
+
+        AddEdits(job.Edits);
+
+        PropagateAdd(Sky);
+        PropagateAdd(Block);
+
+        for (LightChunk& chunk : job.Chunks)
+            chunk.Snapshot.OptimizeLight(chunk.ChangedSections);
+
+        m_Grid.clear();
+    }
+
+    void LightPropagator::BuildGrid(LightingJob& job) {
+
+        ChunkCoordinate min = job.Chunks.front().Snapshot.GetCoordinate();
+        ChunkCoordinate max = min;
+
+        for (const LightChunk& chunk : job.Chunks) {
+
+            const ChunkCoordinate& coordinate = chunk.Snapshot.GetCoordinate();
+
+            min.X = std::min(min.X, coordinate.X);
+            min.Z = std::min(min.Z, coordinate.Z);
+            max.X = std::max(max.X, coordinate.X);
+            max.Z = std::max(max.Z, coordinate.Z);
+        }
+
+        m_GridOrigin = min;
+        m_GridWidth = max.X - min.X + 1;
+        m_GridLength = max.Z - min.Z + 1;
+
+        m_Grid.assign((U64)m_GridWidth * m_GridLength, nullptr);
+
+        for (LightChunk& chunk : job.Chunks) {
+
+            const ChunkCoordinate& coordinate = chunk.Snapshot.GetCoordinate();
+            m_Grid[(coordinate.X - min.X) + (coordinate.Z - min.Z) * m_GridWidth] = &chunk;
+        }
+    }
+
+    static I32 GetColumnHeight(const Chunk& chunk, U32 x, U32 z) {
+
+        for (I32 section = SECTION_COUNT - 1; section >= 0; section--) {
+
+            if (chunk.IsSectionEmpty(section))
+                continue;
+
+            for (I32 y = (section + 1) * SECTION_HEIGHT - 1; y >= section * SECTION_HEIGHT; y--) {
+
+                if (BlockRegistry::IsOpaque(chunk.GetBlockType(x, y, z)))
+                    return y;
+            }
+        }
+
+        return -1;
+    }
+
+    void LightPropagator::Initialize(LightChunk& chunk) {
+
+        constexpr I32 RING_WIDTH = CHUNK_WIDTH + 2;
+        constexpr I32 RING_LENGTH = CHUNK_LENGTH + 2;
+
+        Chunk& snapshot = chunk.Snapshot;
+
+        I32 baseX = (snapshot.GetCoordinate().X - m_GridOrigin.X) * CHUNK_WIDTH;
+        I32 baseZ = (snapshot.GetCoordinate().Z - m_GridOrigin.Z) * CHUNK_LENGTH;
+
+        // Highest opaque block of every column and of the columns right around the chunk, -1 for open columns.
+        I32 heights[RING_WIDTH * RING_LENGTH];
+        I32 maxHeight = -1;
+        I32 ringMaxHeight = -1;
+
+        for (I32 z = -1; z <= CHUNK_LENGTH; z++) {
+
+            for (I32 x = -1; x <= CHUNK_WIDTH; x++) {
+
+                LightChunk* column = GetChunk(baseX + x, baseZ + z);
+                I32 height = column ? GetColumnHeight(column->Snapshot, (baseX + x) % CHUNK_WIDTH, (baseZ + z) % CHUNK_LENGTH) : -1;
+
+                heights[(x + 1) + (z + 1) * RING_WIDTH] = height;
+                ringMaxHeight = std::max(ringMaxHeight, height);
+
+                if (x >= 0 && z >= 0 && x < CHUNK_WIDTH && z < CHUNK_LENGTH)
+                    maxHeight = std::max(maxHeight, height);
+            }
+        }
+
+        auto getHeight = [&heights](I32 x, I32 z) { return heights[(x + 1) + (z + 1) * RING_WIDTH]; };
+
+        // Everything above a column's height sees the sky.
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            I32 sectionY = section * SECTION_HEIGHT;
+
+            if (sectionY > maxHeight) {
+
+                snapshot.FillSectionLight(section, LightStorage::Pack(LIGHT_MAX, 0));
+                continue;
+            }
+
+            snapshot.FillSectionLight(section, 0);
+
+            for (I32 z = 0; z < CHUNK_LENGTH; z++) {
+
+                for (I32 x = 0; x < CHUNK_WIDTH; x++) {
+
+                    for (I32 y = std::max(getHeight(x, z) + 1, sectionY); y < sectionY + SECTION_HEIGHT; y++)
+                        snapshot.SetLight(x, y, z, LightStorage::Pack(LIGHT_MAX, 0));
+                }
+            }
+        }
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            const std::vector<BlockType>& palette = snapshot.GetSection(section).GetPalette();
+
+            if (std::none_of(palette.begin(), palette.end(), [](BlockType type) { return BlockRegistry::GetEmission(type) > 0; }))
+                continue;
+
+            for (I32 y = section * SECTION_HEIGHT; y < (I32)((section + 1) * SECTION_HEIGHT); y++) {
+
+                for (I32 z = 0; z < CHUNK_LENGTH; z++) {
+
+                    for (I32 x = 0; x < CHUNK_WIDTH; x++) {
+
+                        U8 emission = BlockRegistry::GetEmission(snapshot.GetBlockType(x, y, z));
+
+                        if (!emission)
+                            continue;
+
+                        SetLevel(chunk, Block, baseX + x, y, baseZ + z, emission);
+                        m_AddQueues[Block].push_back({ baseX + x, y, baseZ + z, emission });
+                    }
+                }
+            }
+        }
+
+        // Sky light only has to spread sideways below the open air of a taller column next to it.
+        for (I32 z = 0; z < CHUNK_LENGTH; z++) {
+
+            for (I32 x = 0; x < CHUNK_WIDTH; x++) {
+
+                I32 height = getHeight(x, z);
+                I32 neighbourHeight = std::max({ getHeight(x - 1, z), getHeight(x + 1, z), getHeight(x, z - 1), getHeight(x, z + 1) });
+
+                for (I32 y = height + 1; y <= std::min(neighbourHeight, CHUNK_HEIGHT - 1); y++)
+                    m_AddQueues[Sky].push_back({ baseX + x, y, baseZ + z, LIGHT_MAX });
+            }
+        }
+
+        // Light that already reaches the chunk from lit neighbours flows in from their border blocks.
+        for (U32 face = 0; face < 4; face++) {
+
+            I32 dx = FaceNormals[face][0];
+            I32 dz = FaceNormals[face][2];
+
+            LightChunk* neighbour = GetChunk(baseX + (dx > 0 ? CHUNK_WIDTH : dx < 0 ? -1 : 0), baseZ + (dz > 0 ? CHUNK_LENGTH : dz < 0 ? -1 : 0));
+
+            if (!neighbour || neighbour->Initialize)
+                continue;
+
+            for (I32 i = 0; i < (dx ? CHUNK_LENGTH : CHUNK_WIDTH); i++) {
+
+                I32 x = dx ? (dx > 0 ? CHUNK_WIDTH : -1) : i;
+                I32 z = dz ? (dz > 0 ? CHUNK_LENGTH : -1) : i;
+
+                for (I32 y = 0; y < CHUNK_HEIGHT; y++) {
+
+                    U8 sky = GetLevel(*neighbour, Sky, baseX + x, y, baseZ + z);
+                    U8 block = GetLevel(*neighbour, Block, baseX + x, y, baseZ + z);
+
+                    // Above every column around the chunk both sides see the sky already.
+                    if (sky > 1 && y <= ringMaxHeight)
+                        m_AddQueues[Sky].push_back({ baseX + x, y, baseZ + z, sky });
+
+                    if (block > 1)
+                        m_AddQueues[Block].push_back({ baseX + x, y, baseZ + z, block });
+                }
+            }
+        }
+
+        chunk.ChangedSections = SECTION_MASK;
+        chunk.RemeshSections = SECTION_MASK;
+
+        for (U32 face = 0; face < 4; face++)
+            chunk.BorderSections[face] = SECTION_MASK;
+    }
+
+    LightChunk* LightPropagator::GetEditChunk(const LightEdit& edit, I32& x, I32& z) const {
+
+        if (edit.Position.y < 0 || edit.Position.y >= CHUNK_HEIGHT)
+            return nullptr;
+
+        x = edit.Position.x - m_GridOrigin.X * CHUNK_WIDTH;
+        z = edit.Position.z - m_GridOrigin.Z * CHUNK_LENGTH;
+
+        LightChunk* chunk = GetChunk(x, z);
+
+        if (!chunk || chunk->Initialize)
+            return nullptr;
+
+        return chunk;
+    }
+
+    void LightPropagator::RemoveEdits(const std::vector<LightEdit>& edits) {
+
+        for (const LightEdit& edit : edits) {
+
+            I32 x, z;
+            I32 y = edit.Position.y;
+            LightChunk* chunk = GetEditChunk(edit, x, z);
+
+            if (!chunk)
+                continue;
+
+            BlockType current = chunk->Snapshot.GetBlockType(x % CHUNK_WIDTH, y, z % CHUNK_LENGTH);
+
+            if (BlockRegistry::IsOpaque(current) && !BlockRegistry::IsOpaque(edit.Previous)) {
+
+                for (Channel channel : { Sky, Block }) {
+
+                    U8 level = GetLevel(*chunk, channel, x, y, z);
+
+                    if (!level)
+                        continue;
+
+                    SetLevel(*chunk, channel, x, y, z, 0);
+                    m_RemoveQueues[channel].push_back({ x, y, z, level });
+                }
+            }
+            else if (BlockRegistry::GetEmission(edit.Previous) && BlockRegistry::GetEmission(current) != BlockRegistry::GetEmission(edit.Previous)) {
+
+                U8 level = GetLevel(*chunk, Block, x, y, z);
+
+                SetLevel(*chunk, Block, x, y, z, 0);
+                m_RemoveQueues[Block].push_back({ x, y, z, level });
+            }
+        }
+
+        PropagateRemoval(Sky);
+        PropagateRemoval(Block);
+    }
+
+    void LightPropagator::AddEdits(const std::vector<LightEdit>& edits) {
+
+        for (const LightEdit& edit : edits) {
+
+            I32 x, z;
+            I32 y = edit.Position.y;
+            LightChunk* chunk = GetEditChunk(edit, x, z);
+
+            if (!chunk)
+                continue;
+
+            BlockType current = chunk->Snapshot.GetBlockType(x % CHUNK_WIDTH, y, z % CHUNK_LENGTH);
+
+            // An opened block lets the light around it back in.
+            if (!BlockRegistry::IsOpaque(current) && BlockRegistry::IsOpaque(edit.Previous)) {
+
+                for (U32 face = 0; face < 6; face++) {
+
+                    I32 nx = x + FaceNormals[face][0];
+                    I32 ny = y + FaceNormals[face][1];
+                    I32 nz = z + FaceNormals[face][2];
+
+                    LightChunk* neighbour = GetChunk(nx, nz);
+
+                    if (!neighbour || ny < 0 || ny >= CHUNK_HEIGHT)
+                        continue;
+
+                    for (Channel channel : { Sky, Block }) {
+
+                        U8 level = GetLevel(*neighbour, channel, nx, ny, nz);
+
+                        if (level)
+                            m_AddQueues[channel].push_back({ nx, ny, nz, level });
+                    }
+                }
+
+                if (y == CHUNK_HEIGHT - 1) {
+
+                    SetLevel(*chunk, Sky, x, y, z, LIGHT_MAX);
+                    m_AddQueues[Sky].push_back({ x, y, z, LIGHT_MAX });
+                }
+            }
+
+            U8 emission = BlockRegistry::GetEmission(current);
+
+            if (emission > GetLevel(*chunk, Block, x, y, z)) {
+
+                SetLevel(*chunk, Block, x, y, z, emission);
+                m_AddQueues[Block].push_back({ x, y, z, emission });
+            }
+        }
+    }
+
+    void LightPropagator::PropagateRemoval(Channel channel) {
+
+        std::vector<Node>& queue = m_RemoveQueues[channel];
+        std::vector<Node>& addQueue = m_AddQueues[channel];
+
+        // The queue grows while it is walked, nodes are never popped.
+        for (U64 i = 0; i < queue.size(); i++) {
+
+            Node node = queue[i];
+
+            for (U32 face = 0; face < 6; face++) {
+
+                I32 x = node.X + FaceNormals[face][0];
+                I32 y = node.Y + FaceNormals[face][1];
+                I32 z = node.Z + FaceNormals[face][2];
+
+                LightChunk* chunk = GetChunk(x, z);
+
+                if (!chunk || y < 0 || y >= CHUNK_HEIGHT)
+                    continue;
+
+                U8 level = GetLevel(*chunk, channel, x, y, z);
+
+                if (!level)
+                    continue;
+
+                // Full sky light below removed full sky light came from it as well.
+                bool fromNode = level < node.Level || (channel == Sky && face == (U32)BlockFace::Bottom && node.Level == LIGHT_MAX);
+
+                // Emitters keep their own light and spread it again.
+                if (fromNode && channel == Block && BlockRegistry::GetEmission(chunk->Snapshot.GetBlockType(x % CHUNK_WIDTH, y, z % CHUNK_LENGTH)) >= level)
+                    fromNode = false;
+
+                if (fromNode) {
+
+                    SetLevel(*chunk, channel, x, y, z, 0);
+                    queue.push_back({ x, y, z, level });
+                }
+                else {
+
+                    addQueue.push_back({ x, y, z, level });
+                }
+            }
+        }
+
+        queue.clear();
+    }
+
+    void LightPropagator::PropagateAdd(Channel channel) {
+
+        std::vector<Node>& queue = m_AddQueues[channel];
+
+        for (U64 i = 0; i < queue.size(); i++) {
+
+            Node node = queue[i];
+            LightChunk* chunk = GetChunk(node.X, node.Z);
+
+            // Light may have been raised or removed since the node was queued, spread what is there now.
+            U8 level = GetLevel(*chunk, channel, node.X, node.Y, node.Z);
+
+            if (level <= 1)
+                continue;
+
+            for (U32 face = 0; face < 6; face++) {
+
+                I32 x = node.X + FaceNormals[face][0];
+                I32 y = node.Y + FaceNormals[face][1];
+                I32 z = node.Z + FaceNormals[face][2];
+
+                LightChunk* neighbour = GetChunk(x, z);
+
+                if (!neighbour || y < 0 || y >= CHUNK_HEIGHT)
+                    continue;
+
+                if (BlockRegistry::IsOpaque(neighbour->Snapshot.GetBlockType(x % CHUNK_WIDTH, y, z % CHUNK_LENGTH)))
+                    continue;
+
+                U8 spread = channel == Sky && face == (U32)BlockFace::Bottom && level == LIGHT_MAX ? LIGHT_MAX : level - 1;
+
+                if (GetLevel(*neighbour, channel, x, y, z) >= spread)
+                    continue;
+
+                SetLevel(*neighbour, channel, x, y, z, spread);
+                queue.push_back({ x, y, z, spread });
+            }
+        }
+
+        queue.clear();
+    }
+
+    void LightPropagator::SetLevel(LightChunk& chunk, Channel channel, I32 x, I32 y, I32 z, U8 level) {
+
+        U32 localX = x % CHUNK_WIDTH;
+        U32 localZ = z % CHUNK_LENGTH;
+
+        U8 light = chunk.Snapshot.GetLight(localX, y, localZ);
+        light = channel == Sky ? LightStorage::Pack(level, light & 15) : LightStorage::Pack(light >> 4, level);
+
+        chunk.Snapshot.SetLight(localX, y, localZ, light);
+
+        U32 section = y / SECTION_HEIGHT;
+        U32 sectionBit = 1u << section;
+
+        chunk.ChangedSections |= sectionBit;
+        chunk.RemeshSections |= sectionBit;
+
+        // Faces of the section next to a boundary block are lit by it.
+        if (y % SECTION_HEIGHT == 0 && section > 0)
+            chunk.RemeshSections |= sectionBit >> 1;
+        else if (y % SECTION_HEIGHT == SECTION_HEIGHT - 1 && section < SECTION_COUNT - 1)
+            chunk.RemeshSections |= sectionBit << 1;
+
+        if (localZ == CHUNK_LENGTH - 1)
+            chunk.BorderSections[(U32)BlockFace::Front] |= sectionBit;
+        else if (localZ == 0)
+            chunk.BorderSections[(U32)BlockFace::Back] |= sectionBit;
+
+        if (localX == 0)
+            chunk.BorderSections[(U32)BlockFace::Left] |= sectionBit;
+        else if (localX == CHUNK_WIDTH - 1)
+            chunk.BorderSections[(U32)BlockFace::Right] |= sectionBit;
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../Chunks/Chunk.h"
+
+namespace MC {
+
+    // A block that changed since the chunk was last lit, its new type is read from the snapshot.
+    struct LightEdit {
+
+        glm::ivec3 Position;
+        BlockType  Previous;
+    };
+
+    // Snapshot of a chunk a lighting job reads or writes. Light sections are copied on first write,
+    // the World takes the changed ones over once the job is done.
+    struct LightChunk {
+
+        std::weak_ptr<Chunk> Owner;
+        Chunk                Snapshot;
+        // The chunk has no light yet and is lit from scratch, edits inside it are already part of its blocks.
+        bool                 Initialize = false;
+
+        // Sections whose light changed, sections whose mesh sees the change and per horizontal BlockFace
+        // the sections that changed along that border, whose neighbour has to be remeshed as well.
+        U32                  ChangedSections = 0;
+        U32                  RemeshSections = 0;
+        U32                  BorderSections[4] = {};
+    };
+
+    struct LightingJob {
+
+        std::vector<LightChunk> Chunks;
+        std::vector<LightEdit>  Edits;
+    };
+
+    // Flood fill lighting over the chunks of one job. Sky light enters from above the world and travels down
+    // through air without fading, block light starts at emitting blocks, both lose a level per block otherwise.
+    // New chunks are lit from scratch, edits run a removal pass followed by an add pass so only the area an edit
+    // can reach is touched. Light never spreads further than LIGHT_MAX blocks sideways, so an edit or a new chunk
+    // needs its 8 neighbours in the job and nothing more.
+    class LightPropagator {
+
+    private:
+        struct Node {
+
+            I32 X, Y, Z;
+            U8  Level;
+        };
+
+        enum Channel { Sky = 0, Block = 1 };
+
+        // Job chunks on a grid, local block coordinates start at the grid's lowest corner.
+        std::vector<LightChunk*> m_Grid;
+        ChunkCoordinate          m_GridOrigin;
+        I32                      m_GridWidth;
+        I32                      m_GridLength;
+
+        std::vector<Node>        m_AddQueues[2];
+        std::vector<Node>        m_RemoveQueues[2];
+
+    public:
+        LightPropagator() = default;
+        ~LightPropagator() = default;
+
+        void Run(LightingJob& job);
+
+    private:
+        void BuildGrid(LightingJob& job);
+
+        void Initialize(LightChunk& chunk);
+        void RemoveEdits(const std::vector<LightEdit>& edits);
+        void AddEdits(const std::vector<LightEdit>& edits);
+
+        void PropagateRemoval(Channel channel);
+        void PropagateAdd(Channel channel);
+
+        LightChunk* GetChunk(I32 x, I32 z) const {
+
+            if (x < 0 || z < 0 || x >= m_GridWidth * CHUNK_WIDTH || z >= m_GridLength * CHUNK_LENGTH)
+                return nullptr;
+
+            return m_Grid[(x / CHUNK_WIDTH) + (z / CHUNK_LENGTH) * m_GridWidth];
+        }
+
+        // Edited chunks that were never lit are lit from scratch later, their edits are dropped.
+        LightChunk* GetEditChunk(const LightEdit& edit, I32& x, I32& z) const;
+
+        U8 GetLevel(const LightChunk& chunk, Channel channel, I32 x, I32 y, I32 z) const {
+
+            U8 light = chunk.Snapshot.GetLight(x % CHUNK_WIDTH, y, z % CHUNK_LENGTH);
+
+            return channel == Sky ? light >> 4 : light & 15;
+        }
+
+        void SetLevel(LightChunk& chunk, Channel channel, I32 x, I32 y, I32 z, U8 level);
+    };
+}
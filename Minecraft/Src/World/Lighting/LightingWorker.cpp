@@ -0,0 +1,83 @@
+#include "LightingWorker.h"
+
+namespace MC {
+
+    LightingWorker::LightingWorker()
+        : m_Running(false) { }
+
+    LightingWorker::~LightingWorker() {
+
+        Shutdown();
+    }
+
+    void LightingWorker::Init() {
+
+        BRQ_ASSERT(!m_Running);
+
+        m_Running = true;
+        m_Thread = std::thread(&LightingWorker::WorkerLoop, this);
+    }
+
+    void LightingWorker::Shutdown() {
+
+        {
+            std::lock_guard<std::mutex> lock(m_JobMutex);
+
+            if (!m_Running)
+                return;
+
+            m_Running = false;
+            m_Jobs.clear();
+        }
+
+        m_JobAvailable.notify_all();
+        m_Thread.join();
+
+        std::lock_guard<std::mutex> lock(m_CompletedMutex);
+        m_Completed.clear();
+    }
+
+    void LightingWorker::Submit(LightingJob&& job) {
+
+        {
+            std::lock_guard<std::mutex> lock(m_JobMutex);
+            m_Jobs.push_back(std::move(job));
+        }
+
+        m_JobAvailable.notify_one();
+    }
+
+    void LightingWorker::PollCompleted(std::vector<LightingJob>& results) {
+
+        std::lock_guard<std::mutex> lock(m_CompletedMutex);
+
+        for (auto& result : m_Completed)
+            results.push_back(std::move(result));
+
+        m_Completed.clear();
+    }
+
+    void LightingWorker::WorkerLoop() {
+
+        while (true) {
+
+            LightingJob job;
+
+            {
+                std::unique_lock<std::mutex> lock(m_JobMutex);
+                m_JobAvailable.wait(lock, [this]() { return !m_Running || !m_Jobs.empty(); });
+
+                if (!m_Running)
+                    return;
+
+                job = std::move(m_Jobs.front());
+                m_Jobs.erase(m_Jobs.begin());
+            }
+
+            m_Propagator.Run(job);
+
+            std::lock_guard<std::mutex> lock(m_CompletedMutex);
+            m_Completed.push_back(std::move(job));
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "LightPropagator.h"
+
+namespace MC {
+
+    // Runs lighting jobs on a background thread, one at a time. Jobs overlap in the chunks they touch,
+    // so the World keeps at most one in flight and builds the next one after applying the last.
+    class LightingWorker {
+
+    private:
+        std::thread              m_Thread;
+
+        std::vector<LightingJob> m_Jobs;
+        std::mutex               m_JobMutex;
+        std::condition_variable  m_JobAvailable;
+
+        std::vector<LightingJob> m_Completed;
+        std::mutex               m_CompletedMutex;
+
+        LightPropagator          m_Propagator;
+        bool                     m_Running;
+
+    public:
+        LightingWorker();
+        ~LightingWorker();
+
+        LightingWorker(const LightingWorker&) = delete;
+        LightingWorker& operator=(const LightingWorker&) = delete;
+
+        void Init();
+        void Shutdown();
+
+        void Submit(LightingJob&& job);
+
+        // Moves every finished job into results, never blocks on the worker.
+        void PollCompleted(std::vector<LightingJob>& results);
+
+    private:
+        void WorkerLoop();
+    };
+}
@@ -0,0 +1,194 @@
+#include "BinaryMesher.h"
+
+#include "../Blocks/BlockRegistry.h"
+
+#include <bit>
+
+namespace MC {
+
+    static_assert(CHUNK_WIDTH <= 62 && SECTION_HEIGHT <= 62 && CHUNK_LENGTH <= 62, "Section dimensions plus border must fit in a 64-bit column!");
+
+    static const I32 s_Dimensions[3] = { CHUNK_WIDTH, SECTION_HEIGHT, CHUNK_LENGTH };
+
+    static constexpr U32 s_MaxDimension = std::max(CHUNK_WIDTH, std::max(SECTION_HEIGHT, CHUNK_LENGTH));
+
+    // Solid columns mark blocks that have faces, opaque columns the ones that hide their neighbours' faces.
+    // Only opaque columns carry the neighbouring sections' border blocks.
+    static void BuildColumns(const BlockType* blocks, const SectionNeighbours& neighbours, U64 solidColumns[3][s_MaxDimension * s_MaxDimension], U64 columns[3][s_MaxDimension * s_MaxDimension]) {
+
+        memset(solidColumns, 0, sizeof(U64) * 3 * s_MaxDimension * s_MaxDimension);
+        memset(columns, 0, sizeof(U64) * 3 * s_MaxDimension * s_MaxDimension);
+
+        for (I32 y = 0; y < SECTION_HEIGHT; y++) {
+
+            for (I32 z = 0; z < CHUNK_LENGTH; z++) {
+
+                for (I32 x = 0; x < CHUNK_WIDTH; x++) {
+
+                    BlockType type = blocks[BlockStorage::ToIndex(x, y, z)];
+
+                    U64 solid = BlockRegistry::IsMeshed(type);
+                    U64 opaque = BlockRegistry::IsOpaque(type);
+
+                    solidColumns[0][z + y * CHUNK_LENGTH] |= solid << (x + 1);
+                    solidColumns[1][x + z * CHUNK_WIDTH] |= solid << (y + 1);
+                    solidColumns[2][x + y * CHUNK_WIDTH] |= solid << (z + 1);
+
+                    columns[0][z + y * CHUNK_LENGTH] |= opaque << (x + 1);
+                    columns[1][x + z * CHUNK_WIDTH] |= opaque << (y + 1);
+                    columns[2][x + y * CHUNK_WIDTH] |= opaque << (z + 1);
+                }
+            }
+        }
+
+        for (U32 face = 0; face < (U32)BlockFace::BlockFaceMaxEnumerations; face++) {
+
+            const BlockStorage* neighbour = neighbours.Sections[face];
+
+            if (!neighbour)
+                continue;
+
+            const BlockStorage& storage = *neighbour;
+
+            if (storage.IsUniform() && !BlockRegistry::IsOpaque(storage.GetPalette()[0]))
+                continue;
+
+            const FaceAxes& axes = BlockFaceAxes[face];
+
+            I32 sizeU = s_Dimensions[axes.U];
+            I32 sizeV = s_Dimensions[axes.V];
+
+            U64 bit = axes.NormalSign > 0 ? 1ULL << (s_Dimensions[axes.Normal] + 1) : 1ULL;
+
+            I32 position[3];
+            position[axes.Normal] = axes.NormalSign > 0 ? 0 : s_Dimensions[axes.Normal] - 1;
+
+            for (I32 v = 0; v < sizeV; v++) {
+
+                position[axes.V] = v;
+
+                for (I32 u = 0; u < sizeU; u++) {
+
+                    position[axes.U] = u;
+
+                    if (BlockRegistry::IsOpaque(storage.Get(BlockStorage::ToIndex(position[0], position[1], position[2]))))
+                        columns[axes.Normal][u + v * sizeU] |= bit;
+                }
+            }
+        }
+    }
+
+    void BinaryMesher::MeshGreedy(const BlockType* blocks, const U8* opaque, const SectionNeighbours& neighbours, const LightStorage* light, BRQ::VoxelMeshData& meshData) {
+
+        U64 solidColumns[3][s_MaxDimension * s_MaxDimension];
+        U64 columns[3][s_MaxDimension * s_MaxDimension];
+        U64 rows[s_MaxDimension][s_MaxDimension];
+        U32 keys[s_MaxDimension * s_MaxDimension];
+
+        BuildColumns(blocks, neighbours, solidColumns, columns);
+
+        for (U32 face = 0; face < (U32)BlockFace::BlockFaceMaxEnumerations; face++) {
+
+            const FaceAxes& axes = BlockFaceAxes[face];
+
+            I32 size = s_Dimensions[axes.Normal];
+            I32 sizeU = s_Dimensions[axes.U];
+            I32 sizeV = s_Dimensions[axes.V];
+
+            const U64* axisSolidColumns = solidColumns[axes.Normal];
+            const U64* axisColumns = columns[axes.Normal];
+            U64 sizeMask = (1ULL << size) - 1;
+
+            memset(rows, 0, sizeof(rows));
+
+            // Cull whole columns at once, then scatter the visible faces into per slice rows.
+            for (I32 v = 0; v < sizeV; v++) {
+
+                for (I32 u = 0; u < sizeU; u++) {
+
+                    U64 solid = axisSolidColumns[u + v * sizeU];
+                    U64 opaque = axisColumns[u + v * sizeU];
+                    U64 visible = axes.NormalSign > 0 ? solid & ~(opaque >> 1) : solid & ~(opaque << 1);
+                    visible = (visible >> 1) & sizeMask;
+
+                    while (visible) {
+
+                        I32 slice = std::countr_zero(visible);
+                        rows[slice][v] |= 1ULL << u;
+                        visible &= visible - 1;
+                    }
+                }
+            }
+
+            for (I32 slice = 0; slice < size; slice++) {
+
+                I32 position[3];
+                position[axes.Normal] = slice;
+
+                U64* sliceRows = rows[slice];
+
+                // Faces merge when their block type, light and corner occlusion match. Keys are looked up once
+                // per visible face, merging compares them several times.
+                for (I32 v = 0; v < sizeV; v++) {
+
+                    for (U64 row = sliceRows[v]; row; row &= row - 1) {
+
+                        I32 u = std::countr_zero(row);
+
+                        position[axes.U] = u;
+                        position[axes.V] = v;
+
+                        BlockType type = blocks[BlockStorage::ToIndex(position[0], position[1], position[2])];
+                        U8 faceLight = ChunkMesher::GetFaceLight(light, neighbours, position[0], position[1], position[2], (BlockFace)face);
+                        U8 occlusion = ChunkMesher::GetAmbientOcclusion(opaque, position[0], position[1], position[2], (BlockFace)face);
+
+                        keys[u + v * sizeU] = (U32)type | (U32)faceLight << 8 | (U32)occlusion << 16;
+                    }
+                }
+
+                for (I32 v = 0; v < sizeV; v++) {
+
+                    while (sliceRows[v]) {
+
+                        I32 u = std::countr_zero(sliceRows[v]);
+                        U32 key = keys[u + v * sizeU];
+
+                        I32 width = 1;
+
+                        while (u + width < sizeU && (sliceRows[v] >> (u + width)) & 1 && keys[u + width + v * sizeU] == key)
+                            width++;
+
+                        U64 runMask = ((1ULL << width) - 1) << u;
+
+                        I32 height = 1;
+
+                        for (; v + height < sizeV; height++) {
+
+                            if ((sliceRows[v + height] & runMask) != runMask)
+                                break;
+
+                            bool rowMatches = true;
+
+                            for (I32 i = 0; i < width; i++) {
+
+                                if (keys[u + i + (v + height) * sizeU] != key) {
+
+                                    rowMatches = false;
+                                    break;
+                                }
+                            }
+
+                            if (!rowMatches)
+                                break;
+                        }
+
+                        for (I32 j = 0; j < height; j++)
+                            sliceRows[v + j] &= ~runMask;
+
+                        ChunkMesher::PushQuad(meshData, (BlockFace)face, (BlockType)(key & 0xFF), (U8)(key >> 8), (U8)(key >> 16), slice, u, v, width, height);
+                    }
+                }
+            }
+        }
+    }
+}
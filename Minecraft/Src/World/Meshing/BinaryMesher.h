@@ -0,0 +1,16 @@
+#pragma once
+
+#include "ChunkMesher.h"
+
+namespace MC {
+
+    // Greedy mesher backend working on bitmasks instead of single voxels. Solidity and opacity are
+    // packed into 64-bit columns per axis, padded with the neighbouring sections' border blocks at
+    // bit 0 and bit size + 1, so a whole column of faces is culled with a shift and an AND.
+    // Produces exactly the same MeshData as the reference greedy mesher.
+    class BinaryMesher {
+
+    public:
+        static void MeshGreedy(const BlockType* blocks, const U8* opaque, const SectionNeighbours& neighbours, const LightStorage* light, BRQ::VoxelMeshData& meshData);
+    };
+}
@@ -0,0 +1,443 @@
+#include "ChunkMesher.h"
+#include "BinaryMesher.h"
+
+#include "../Blocks/BlockRegistry.h"
+
+#include <array>
+
+namespace MC {
+
+    static const I32 s_Dimensions[3] = { CHUNK_WIDTH, SECTION_HEIGHT, CHUNK_LENGTH };
+
+    static const U32 s_QuadIndices[6] = { 0, 2, 1, 2, 3, 1 };
+    // The same quad split along its other diagonal.
+    static const U32 s_FlippedQuadIndices[6] = { 0, 2, 3, 0, 3, 1 };
+
+    static const U8 s_OpenSkyLight = LightStorage::Pack(LIGHT_MAX, 0);
+
+    static const I32 s_PaddedStrides[3] = { 1, (CHUNK_WIDTH + 2) * (CHUNK_LENGTH + 2), CHUNK_WIDTH + 2 };
+
+    static I32 ToPaddedIndex(I32 x, I32 y, I32 z) {
+
+        return (x + 1) * s_PaddedStrides[0] + (y + 1) * s_PaddedStrides[1] + (z + 1) * s_PaddedStrides[2];
+    }
+
+    // Padded index offsets of the block in front of a face and, per corner, of the two blocks beside that
+    // block along U and V and of the block diagonally between them.
+    struct OcclusionSamples {
+
+        I32 Normal;
+        I32 Corners[4][3];
+    };
+
+    static const std::array<OcclusionSamples, 6> s_OcclusionSamples = []() {
+
+        std::array<OcclusionSamples, 6> samples;
+
+        for (U32 face = 0; face < 6; face++) {
+
+            const FaceAxes& axes = BlockFaceAxes[face];
+
+            samples[face].Normal = axes.NormalSign * s_PaddedStrides[axes.Normal];
+
+            for (I32 corner = 0; corner < 4; corner++) {
+
+                // Same corner order as PushQuad.
+                I32 sideU = ((corner >> 1) * 2 - 1) * axes.USign * s_PaddedStrides[axes.U];
+                I32 sideV = ((corner & 1) * 2 - 1) * axes.VSign * s_PaddedStrides[axes.V];
+
+                samples[face].Corners[corner][0] = sideU;
+                samples[face].Corners[corner][1] = sideV;
+                samples[face].Corners[corner][2] = sideU + sideV;
+            }
+        }
+
+        return samples;
+    }();
+
+    static BRQ::VoxelVertex PackVertex(I32 x, I32 y, I32 z, BlockFace face, U16 layer, U8 light, U8 occlusion) {
+
+        BRQ::VoxelVertex vertex;
+        vertex.PositionAndFace = (U32)x | (U32)y << 6 | (U32)z << 12 | (U32)face << 18 | (U32)occlusion << 21;
+        vertex.Material = (U32)layer | (U32)(light >> 4) << 16 | (U32)(light & 15) << 20;
+
+        return vertex;
+    }
+
+    MeshingBackend ChunkMesher::s_Backend = MeshingBackend::Binary;
+
+    static bool IsFaceVisible(const U8* opaque, I32 x, I32 y, I32 z, BlockFace face) {
+
+        return !opaque[ToPaddedIndex(x, y, z) + s_OcclusionSamples[(U32)face].Normal];
+    }
+
+    U8 ChunkMesher::GetFaceLight(const LightStorage* light, const SectionNeighbours& neighbours, I32 x, I32 y, I32 z, BlockFace face) {
+
+        const I32* normal = FaceNormals[(U32)face];
+
+        I32 nx = x + normal[0];
+        I32 ny = y + normal[1];
+        I32 nz = z + normal[2];
+
+        if (nx < 0 || ny < 0 || nz < 0 || nx >= CHUNK_WIDTH || ny >= SECTION_HEIGHT || nz >= CHUNK_LENGTH) {
+
+            light = neighbours.Light[(U32)face];
+
+            nx = (nx + CHUNK_WIDTH) % CHUNK_WIDTH;
+            ny = (ny + SECTION_HEIGHT) % SECTION_HEIGHT;
+            nz = (nz + CHUNK_LENGTH) % CHUNK_LENGTH;
+        }
+
+        return light ? light->Get(BlockStorage::ToIndex(nx, ny, nz)) : s_OpenSkyLight;
+    }
+
+    U8 ChunkMesher::GetAmbientOcclusion(const U8* opaque, I32 x, I32 y, I32 z, BlockFace face) {
+
+        const OcclusionSamples& samples = s_OcclusionSamples[(U32)face];
+        const U8* front = opaque + ToPaddedIndex(x, y, z) + samples.Normal;
+
+        U8 occlusion = 0;
+
+        for (U32 corner = 0; corner < 4; corner++) {
+
+            U32 sideU = front[samples.Corners[corner][0]];
+            U32 sideV = front[samples.Corners[corner][1]];
+            // Two solid sides already hide the corner completely, counting the diagonal block as solid then gives 0.
+            U32 diagonal = front[samples.Corners[corner][2]] | (sideU & sideV);
+
+            occlusion |= (U8)((3 - sideU - sideV - diagonal) << (corner * 2));
+        }
+
+        return occlusion;
+    }
+
+    void ChunkMesher::BuildOpacity(const BlockType* blocks, const SectionNeighbours& neighbours, U8* opaque) {
+
+        memset(opaque, 0, PADDED_SECTION_SIZE);
+
+        for (I32 y = 0; y < SECTION_HEIGHT; y++)
+            for (I32 z = 0; z < CHUNK_LENGTH; z++)
+                for (I32 x = 0; x < CHUNK_WIDTH; x++)
+                    opaque[ToPaddedIndex(x, y, z)] = BlockRegistry::IsOpaque(blocks[BlockStorage::ToIndex(x, y, z)]);
+
+        // The border is one layer, edge or corner of each of the 26 sections around.
+        for (I32 dy = -1; dy <= 1; dy++) {
+
+            for (I32 dz = -1; dz <= 1; dz++) {
+
+                for (I32 dx = -1; dx <= 1; dx++) {
+
+                    I32 offset[3] = { dx, dy, dz };
+                    I32 axes = (dx != 0) + (dy != 0) + (dz != 0);
+
+                    if (!axes)
+                        continue;
+
+                    const BlockStorage* storage = neighbours.Diagonals[(dx + 1) + (dz + 1) * 3 + (dy + 1) * 9];
+
+                    if (axes == 1) {
+
+                        for (U32 face = 0; face < (U32)BlockFace::BlockFaceMaxEnumerations; face++) {
+
+                            if (FaceNormals[face][0] == dx && FaceNormals[face][1] == dy && FaceNormals[face][2] == dz)
+                                storage = neighbours.Sections[face];
+                        }
+                    }
+
+                    if (!storage || (storage->IsUniform() && storage->GetPalette()[0] == BlockType::Air))
+                        continue;
+
+                    I32 begin[3];
+                    I32 end[3];
+
+                    for (U32 axis = 0; axis < 3; axis++) {
+
+                        begin[axis] = offset[axis] < 0 ? s_Dimensions[axis] - 1 : 0;
+                        end[axis] = offset[axis] > 0 ? 1 : s_Dimensions[axis];
+                    }
+
+                    for (I32 y = begin[1]; y < end[1]; y++)
+                        for (I32 z = begin[2]; z < end[2]; z++)
+                            for (I32 x = begin[0]; x < end[0]; x++)
+                                opaque[ToPaddedIndex(x + dx * CHUNK_WIDTH, y + dy * SECTION_HEIGHT, z + dz * CHUNK_LENGTH)] = BlockRegistry::IsOpaque(storage->Get(BlockStorage::ToIndex(x, y, z)));
+                }
+            }
+        }
+    }
+
+    BRQ::VoxelMeshData ChunkMesher::Mesh(const BlockStorage& storage, MeshingMode mode, const SectionNeighbours& neighbours, const LightStorage* light) {
+
+        BRQ::VoxelMeshData meshData;
+
+        if (storage.IsUniform() && storage.GetPalette()[0] == BlockType::Air)
+            return meshData;
+
+        BlockType blocks[SECTION_SIZE];
+
+        for (U32 i = 0; i < (SECTION_SIZE); i++)
+            blocks[i] = storage.Get(i);
+
+        U8 opaque[PADDED_SECTION_SIZE];
+        BuildOpacity(blocks, neighbours, opaque);
+
+        switch (mode) {
+
+        case MeshingMode::Culled:
+            MeshCulled(blocks, opaque, neighbours, light, meshData);
+            break;
+        case MeshingMode::Greedy:
+            if (s_Backend == MeshingBackend::Binary)
+                BinaryMesher::MeshGreedy(blocks, opaque, neighbours, light, meshData);
+            else
+                MeshGreedy(blocks, opaque, neighbours, light, meshData);
+            break;
+        }
+
+        return meshData;
+    }
+
+    void ChunkMesher::Mesh(const Chunk& chunk, U32 sectionMask, MeshingMode mode, const ChunkNeighbours& neighbours, BRQ::VoxelMeshData* sectionMeshes) {
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            if (!(sectionMask & (1u << section)) || chunk.IsSectionEmpty(section))
+                continue;
+
+            SectionNeighbours sectionNeighbours = GetSectionNeighbours(chunk, section, neighbours);
+
+            if (IsSectionHidden(chunk.GetSection(section), sectionNeighbours))
+                continue;
+
+            sectionMeshes[section] = Mesh(chunk.GetSection(section), mode, sectionNeighbours, &chunk.GetSectionLight(section));
+        }
+    }
+
+    SectionNeighbours ChunkMesher::GetSectionNeighbours(const Chunk& chunk, U32 section, const ChunkNeighbours& neighbours) {
+
+        SectionNeighbours sectionNeighbours;
+
+        for (U32 face = 0; face < (U32)BlockFace::BlockFaceMaxEnumerations; face++) {
+
+            if (!neighbours.Chunks[face])
+                continue;
+
+            sectionNeighbours.Sections[face] = &neighbours.Chunks[face]->GetSection(section);
+            sectionNeighbours.Light[face] = &neighbours.Chunks[face]->GetSectionLight(section);
+        }
+
+        // Above and below are sections of the same chunk, the world ends past the first and last one.
+        sectionNeighbours.Sections[(U32)BlockFace::Top] = section + 1 < SECTION_COUNT ? &chunk.GetSection(section + 1) : nullptr;
+        sectionNeighbours.Sections[(U32)BlockFace::Bottom] = section > 0 ? &chunk.GetSection(section - 1) : nullptr;
+        sectionNeighbours.Light[(U32)BlockFace::Top] = section + 1 < SECTION_COUNT ? &chunk.GetSectionLight(section + 1) : nullptr;
+        sectionNeighbours.Light[(U32)BlockFace::Bottom] = section > 0 ? &chunk.GetSectionLight(section - 1) : nullptr;
+
+        for (I32 dy = -1; dy <= 1; dy++) {
+
+            I32 diagonalSection = (I32)section + dy;
+
+            if (diagonalSection < 0 || diagonalSection >= SECTION_COUNT)
+                continue;
+
+            for (I32 dz = -1; dz <= 1; dz++) {
+
+                for (I32 dx = -1; dx <= 1; dx++) {
+
+                    if ((dx != 0) + (dy != 0) + (dz != 0) < 2)
+                        continue;
+
+                    const Chunk* diagonalChunk = nullptr;
+
+                    if (dx && dz)
+                        diagonalChunk = neighbours.Corners[(dx + 1) / 2 + (dz + 1)];
+                    else if (dx)
+                        diagonalChunk = neighbours.Chunks[(U32)(dx < 0 ? BlockFace::Left : BlockFace::Right)];
+                    else if (dz)
+                        diagonalChunk = neighbours.Chunks[(U32)(dz < 0 ? BlockFace::Back : BlockFace::Front)];
+
+                    if (diagonalChunk)
+                        sectionNeighbours.Diagonals[(dx + 1) + (dz + 1) * 3 + (dy + 1) * 9] = &diagonalChunk->GetSection(diagonalSection);
+                }
+            }
+        }
+
+        return sectionNeighbours;
+    }
+
+    bool ChunkMesher::IsSectionHidden(const BlockStorage& section, const SectionNeighbours& neighbours) {
+
+        // Every face of an opaque section touches an opaque block unless a neighbour has a see through block somewhere.
+        if (!section.IsOpaque())
+            return false;
+
+        for (const BlockStorage* neighbour : neighbours.Sections) {
+
+            if (!neighbour || !neighbour->IsOpaque())
+                return false;
+        }
+
+        return true;
+    }
+
+    MeshingStatistics ChunkMesher::GetStatistics(const BRQ::VoxelMeshData& meshData) {
+
+        MeshingStatistics statistics;
+        statistics.VertexCount = meshData.Verticies.size();
+        statistics.TriangleCount = meshData.Indicies.size() / 3;
+
+        return statistics;
+    }
+
+    void ChunkMesher::MeshCulled(const BlockType* blocks, const U8* opaque, const SectionNeighbours& neighbours, const LightStorage* light, BRQ::VoxelMeshData& meshData) {
+
+        for (I32 y = 0; y < SECTION_HEIGHT; y++) {
+
+            for (I32 z = 0; z < CHUNK_LENGTH; z++) {
+
+                for (I32 x = 0; x < CHUNK_WIDTH; x++) {
+
+                    BlockType type = blocks[BlockStorage::ToIndex(x, y, z)];
+
+                    if (!BlockRegistry::IsMeshed(type))
+                        continue;
+
+                    for (U32 face = 0; face < (U32)BlockFace::BlockFaceMaxEnumerations; face++) {
+
+                        if (!IsFaceVisible(opaque, x, y, z, (BlockFace)face))
+                            continue;
+
+                        const FaceAxes& axes = BlockFaceAxes[face];
+                        I32 position[3] = { x, y, z };
+
+                        U8 faceLight = GetFaceLight(light, neighbours, x, y, z, (BlockFace)face);
+                        U8 occlusion = GetAmbientOcclusion(opaque, x, y, z, (BlockFace)face);
+
+                        PushQuad(meshData, (BlockFace)face, type, faceLight, occlusion, position[axes.Normal], position[axes.U], position[axes.V], 1, 1);
+                    }
+                }
+            }
+        }
+    }
+
+    void ChunkMesher::MeshGreedy(const BlockType* blocks, const U8* opaque, const SectionNeighbours& neighbours, const LightStorage* light, BRQ::VoxelMeshData& meshData) {
+
+        // Block type, face light and corner occlusion in one byte each, only faces matching in all three are merged.
+        U32 mask[CHUNK_WIDTH * CHUNK_LENGTH > CHUNK_WIDTH * SECTION_HEIGHT ? CHUNK_WIDTH * CHUNK_LENGTH : CHUNK_WIDTH * SECTION_HEIGHT];
+
+        for (U32 face = 0; face < (U32)BlockFace::BlockFaceMaxEnumerations; face++) {
+
+            const FaceAxes& axes = BlockFaceAxes[face];
+
+            I32 sizeU = s_Dimensions[axes.U];
+            I32 sizeV = s_Dimensions[axes.V];
+
+            for (I32 slice = 0; slice < s_Dimensions[axes.Normal]; slice++) {
+
+                I32 position[3];
+                position[axes.Normal] = slice;
+
+                for (I32 v = 0; v < sizeV; v++) {
+
+                    position[axes.V] = v;
+
+                    for (I32 u = 0; u < sizeU; u++) {
+
+                        position[axes.U] = u;
+
+                        BlockType type = blocks[BlockStorage::ToIndex(position[0], position[1], position[2])];
+                        U32 key = 0;
+
+                        if (BlockRegistry::IsMeshed(type) && IsFaceVisible(opaque, position[0], position[1], position[2], (BlockFace)face)) {
+
+                            key = (U32)type;
+                            key |= (U32)GetFaceLight(light, neighbours, position[0], position[1], position[2], (BlockFace)face) << 8;
+                            key |= (U32)GetAmbientOcclusion(opaque, position[0], position[1], position[2], (BlockFace)face) << 16;
+                        }
+
+                        mask[u + v * sizeU] = key;
+                    }
+                }
+
+                for (I32 v = 0; v < sizeV; v++) {
+
+                    for (I32 u = 0; u < sizeU; ) {
+
+                        U32 key = mask[u + v * sizeU];
+
+                        if (!key) {
+
+                            u++;
+                            continue;
+                        }
+
+                        I32 width = 1;
+
+                        while (u + width < sizeU && mask[u + width + v * sizeU] == key)
+                            width++;
+
+                        I32 height = 1;
+
+                        for (; v + height < sizeV; height++) {
+
+                            bool rowMatches = true;
+
+                            for (I32 i = 0; i < width; i++) {
+
+                                if (mask[u + i + (v + height) * sizeU] != key) {
+
+                                    rowMatches = false;
+                                    break;
+                                }
+                            }
+
+                            if (!rowMatches)
+                                break;
+                        }
+
+                        for (I32 j = 0; j < height; j++)
+                            for (I32 i = 0; i < width; i++)
+                                mask[u + i + (v + j) * sizeU] = 0;
+
+                        PushQuad(meshData, (BlockFace)face, (BlockType)(key & 0xFF), (U8)(key >> 8), (U8)(key >> 16), slice, u, v, width, height);
+
+                        u += width;
+                    }
+                }
+            }
+        }
+    }
+
+    void ChunkMesher::PushQuad(BRQ::VoxelMeshData& meshData, BlockFace face, BlockType type, U8 light, U8 occlusion, I32 slice, I32 u, I32 v, I32 width, I32 height) {
+
+        const FaceAxes& axes = BlockFaceAxes[(U32)face];
+
+        I32 startU = axes.USign > 0 ? u : u + width;
+        I32 startV = axes.VSign > 0 ? v : v + height;
+
+        U32 offset = (U32)meshData.Verticies.size();
+        U16 layer = BlockRegistry::GetTextureLayer(type, face);
+
+        for (I32 corner = 0; corner < 4; corner++) {
+
+            I32 cornerU = corner >> 1;
+            I32 cornerV = corner & 1;
+
+            I32 position[3];
+            position[axes.Normal] = slice + (axes.NormalSign > 0 ? 1 : 0);
+            position[axes.U] = startU + axes.USign * cornerU * width;
+            position[axes.V] = startV + axes.VSign * cornerV * height;
+
+            meshData.Verticies.push_back(PackVertex(position[0], position[1], position[2], face, layer, light, (occlusion >> (corner * 2)) & 3));
+        }
+
+        // Split the quad along its brighter diagonal, otherwise occlusion interpolates differently depending on the quad's orientation.
+        U32 occlusion0 = occlusion & 3;
+        U32 occlusion1 = (occlusion >> 2) & 3;
+        U32 occlusion2 = (occlusion >> 4) & 3;
+        U32 occlusion3 = (occlusion >> 6) & 3;
+
+        const U32* indices = occlusion0 + occlusion3 > occlusion1 + occlusion2 ? s_FlippedQuadIndices : s_QuadIndices;
+
+        for (U32 i = 0; i < 6; i++)
+            meshData.Indicies.push_back(offset + indices[i]);
+    }
+}
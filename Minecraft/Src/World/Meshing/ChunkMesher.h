@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Engine.h>
+
+#include "../Chunks/Chunk.h"
+#include "../Blocks/BlockData.h"
+
+namespace MC {
+
+    enum class MeshingMode {
+
+        Culled = 0, // One quad per visible block face.
+        Greedy,     // Coplanar faces of the same block type merged into maximal rectangles.
+    };
+
+    enum class MeshingBackend {
+
+        Reference = 0,  // Per voxel neighbour lookups.
+        Binary,         // Face culling on 64-bit solidity columns, see BinaryMesher.
+    };
+
+    // Sections padded by one block on every side, laid out like BlockStorage::ToIndex.
+    #define PADDED_SECTION_SIZE ((CHUNK_WIDTH + 2) * (SECTION_HEIGHT + 2) * (CHUNK_LENGTH + 2))
+
+    // Chunks across each face of the meshed chunk, indexed by BlockFace, and the chunks diagonally
+    // across its corners, indexed by (dx + 1) / 2 + (dz + 1). Missing neighbours are treated as air.
+    struct ChunkNeighbours {
+
+        const Chunk* Chunks[(U32)BlockFace::BlockFaceMaxEnumerations] = {};
+        const Chunk* Corners[4] = {};
+    };
+
+    // Sections across each face of the meshed section, indexed by BlockFace.
+    // Missing neighbours are treated as air, missing light as open sky.
+    struct SectionNeighbours {
+
+        const BlockStorage* Sections[(U32)BlockFace::BlockFaceMaxEnumerations] = {};
+        const LightStorage* Light[(U32)BlockFace::BlockFaceMaxEnumerations] = {};
+        // Sections sharing only an edge or a corner with the meshed one, indexed by (dx + 1) + (dz + 1) * 3 + (dy + 1) * 9.
+        // Only ambient occlusion reads them.
+        const BlockStorage* Diagonals[27] = {};
+    };
+
+    struct MeshingStatistics {
+
+        U64 VertexCount = 0;
+        U64 TriangleCount = 0;
+    };
+
+    class ChunkMesher {
+
+        friend class BinaryMesher;
+        friend class LodMesher;
+
+    private:
+        static MeshingBackend s_Backend;
+
+    public:
+        // Faces are lit by the block in front of them, a section without light is meshed as if it were open sky.
+        static BRQ::VoxelMeshData Mesh(const BlockStorage& section, MeshingMode mode = MeshingMode::Greedy, const SectionNeighbours& neighbours = {}, const LightStorage* light = nullptr);
+
+        // Meshes the sections of chunk in sectionMask into sectionMeshes, indexed by section. Empty sections and
+        // solid sections buried on every side produce no geometry and are skipped without reading their blocks.
+        static void Mesh(const Chunk& chunk, U32 sectionMask, MeshingMode mode, const ChunkNeighbours& neighbours, BRQ::VoxelMeshData* sectionMeshes);
+
+        static SectionNeighbours GetSectionNeighbours(const Chunk& chunk, U32 section, const ChunkNeighbours& neighbours);
+        static bool IsSectionHidden(const BlockStorage& section, const SectionNeighbours& neighbours);
+
+        static MeshingStatistics GetStatistics(const BRQ::VoxelMeshData& meshData);
+
+        // The backend only changes how visible faces are found, greedy output is identical for both.
+        static void SetBackend(MeshingBackend backend) { s_Backend = backend; }
+        static MeshingBackend GetBackend() { return s_Backend; }
+
+    private:
+        static void MeshCulled(const BlockType* blocks, const U8* opaque, const SectionNeighbours& neighbours, const LightStorage* light, BRQ::VoxelMeshData& meshData);
+        static void MeshGreedy(const BlockType* blocks, const U8* opaque, const SectionNeighbours& neighbours, const LightStorage* light, BRQ::VoxelMeshData& meshData);
+
+        // Copies which blocks of the section and of the blocks right around it are solid into PADDED_SECTION_SIZE bytes.
+        static void BuildOpacity(const BlockType* blocks, const SectionNeighbours& neighbours, U8* opaque);
+
+        // Light of the block across face of the block at x, y, z.
+        static U8 GetFaceLight(const LightStorage* light, const SectionNeighbours& neighbours, I32 x, I32 y, I32 z, BlockFace face);
+
+        // Ambient occlusion of the 4 corners of a face, 2 bits each in PushQuad corner order, 3 is unoccluded.
+        static U8 GetAmbientOcclusion(const U8* opaque, I32 x, I32 y, I32 z, BlockFace face);
+
+        static void PushQuad(BRQ::VoxelMeshData& meshData, BlockFace face, BlockType type, U8 light, U8 occlusion, I32 slice, I32 u, I32 v, I32 width, I32 height);
+    };
+}
@@ -0,0 +1,295 @@
+#include "LodMesher.h"
+
+#include "../Blocks/BlockRegistry.h"
+
+#include <vector>
+
+namespace MC {
+
+    static const U8 s_OpenSkyLight = LightStorage::Pack(LIGHT_MAX, 0);
+    // Coarse cells are too large for per corner occlusion to look right, every corner is left unoccluded.
+    static const U8 s_NoOcclusion = 0xFF;
+    // Skirt below the border column when the chunk across the border is not loaded, in blocks.
+    static const I32 s_DefaultSkirtDepth = 16;
+
+    struct CoarseGrid {
+
+        I32                    Scale;
+        I32                    Size[3];
+        std::vector<BlockType> Cells;
+
+        BlockType Get(I32 x, I32 y, I32 z) const { return Cells[x + Size[0] * (z + Size[2] * y)]; }
+        void Set(I32 x, I32 y, I32 z, BlockType type) { Cells[x + Size[0] * (z + Size[2] * y)] = type; }
+    };
+
+    // One above the topmost solid block of a column, 0 for a column of air.
+    static I32 GetSurfaceHeight(const Chunk& chunk, U32 x, U32 z) {
+
+        for (I32 section = SECTION_COUNT - 1; section >= 0; section--) {
+
+            if (chunk.IsSectionEmpty(section))
+                continue;
+
+            for (I32 y = (section + 1) * SECTION_HEIGHT - 1; y >= section * SECTION_HEIGHT; y--) {
+
+                if (BlockRegistry::IsMeshed(chunk.GetBlockType(x, (U32)y, z)))
+                    return y + 1;
+            }
+        }
+
+        return 0;
+    }
+
+    // Type of the topmost solid block in the scale sized cube at x, y, z of a section, air when it has none.
+    static BlockType GetTopmostBlock(const BlockStorage& storage, I32 x, I32 y, I32 z, I32 scale) {
+
+        for (I32 dy = scale - 1; dy >= 0; dy--) {
+
+            for (I32 dz = 0; dz < scale; dz++) {
+
+                for (I32 dx = 0; dx < scale; dx++) {
+
+                    BlockType type = storage.Get(BlockStorage::ToIndex(x + dx, y + dy, z + dz));
+
+                    if (BlockRegistry::IsMeshed(type))
+                        return type;
+                }
+            }
+        }
+
+        return BlockType::Air;
+    }
+
+    static void Downsample(const Chunk& chunk, CoarseGrid& grid) {
+
+        const I32 scale = grid.Scale;
+        const I32 cellsPerSection = SECTION_HEIGHT / scale;
+
+        for (I32 section = 0; section < SECTION_COUNT; section++) {
+
+            if (chunk.IsSectionEmpty(section))
+                continue;
+
+            const BlockStorage& storage = chunk.GetSection(section);
+
+            for (I32 y = 0; y < cellsPerSection; y++) {
+
+                for (I32 z = 0; z < grid.Size[2]; z++) {
+
+                    for (I32 x = 0; x < grid.Size[0]; x++) {
+
+                        BlockType type = storage.IsUniform() ? storage.GetPalette()[0] : GetTopmostBlock(storage, x * scale, y * scale, z * scale, scale);
+                        grid.Set(x, section * cellsPerSection + y, z, type);
+                    }
+                }
+            }
+        }
+    }
+
+    // Brightest light in front of the face of a coarse cell. Cells are solid when any of their blocks is,
+    // so some of the blocks in front of a face may be solid and dark.
+    static U8 GetCellFaceLight(const Chunk& chunk, I32 scale, const I32* cell, BlockFace face) {
+
+        const FaceAxes& axes = BlockFaceAxes[(U32)face];
+
+        I32 position[3] = { cell[0] * scale, cell[1] * scale, cell[2] * scale };
+        position[axes.Normal] += axes.NormalSign > 0 ? scale : -1;
+
+        if (position[0] < 0 || position[2] < 0 || position[0] >= CHUNK_WIDTH || position[2] >= CHUNK_LENGTH || position[1] >= CHUNK_HEIGHT)
+            return s_OpenSkyLight;
+
+        if (position[1] < 0)
+            return 0;
+
+        I32 step = std::max(scale / 4, 1);
+        U8 sky = 0;
+        U8 block = 0;
+
+        for (I32 v = 0; v < scale; v += step) {
+
+            for (I32 u = 0; u < scale; u += step) {
+
+                I32 sample[3] = { position[0], position[1], position[2] };
+                sample[axes.U] += u;
+                sample[axes.V] += v;
+
+                U8 light = chunk.GetLight((U32)sample[0], (U32)sample[1], (U32)sample[2]);
+
+                sky = std::max<U8>(sky, light >> 4);
+                block = std::max<U8>(block, light & 15);
+            }
+        }
+
+        return LightStorage::Pack(sky, block);
+    }
+
+    void LodMesher::Mesh(const Chunk& chunk, U32 lod, const ChunkNeighbours& neighbours, BRQ::VoxelMeshData* sectionMeshes) {
+
+        const I32 scale = GetScale(lod);
+
+        BRQ_ASSERT(lod > 0 && SECTION_HEIGHT % scale == 0 && CHUNK_WIDTH % scale == 0 && CHUNK_LENGTH % scale == 0);
+
+        CoarseGrid grid;
+        grid.Scale = scale;
+        grid.Size[0] = CHUNK_WIDTH / scale;
+        grid.Size[1] = CHUNK_HEIGHT / scale;
+        grid.Size[2] = CHUNK_LENGTH / scale;
+        grid.Cells.assign((U64)grid.Size[0] * grid.Size[1] * grid.Size[2], BlockType::Air);
+
+        Downsample(chunk, grid);
+
+        // Lowest surface across each horizontal border per coarse cell along it, in blocks. Border faces above it are the skirt.
+        std::vector<I32> skirtBottoms[4];
+
+        for (U32 face = 0; face < 4; face++) {
+
+            const FaceAxes& axes = BlockFaceAxes[face];
+            const Chunk* neighbour = neighbours.Chunks[face];
+
+            I32 borderSize = axes.Normal == 0 ? CHUNK_WIDTH : CHUNK_LENGTH;
+
+            skirtBottoms[face].resize(grid.Size[axes.U]);
+
+            for (I32 i = 0; i < grid.Size[axes.U]; i++) {
+
+                I32 bottom = CHUNK_HEIGHT;
+
+                for (I32 j = 0; j < scale; j++) {
+
+                    I32 column[3] = {};
+                    column[axes.U] = i * scale + j;
+                    column[axes.Normal] = axes.NormalSign > 0 ? borderSize - 1 : 0;
+
+                    if (neighbour) {
+
+                        column[axes.Normal] = borderSize - 1 - column[axes.Normal];
+                        bottom = std::min(bottom, GetSurfaceHeight(*neighbour, (U32)column[0], (U32)column[2]));
+                    }
+                    else {
+
+                        bottom = std::min(bottom, GetSurfaceHeight(chunk, (U32)column[0], (U32)column[2]) - s_DefaultSkirtDepth);
+                    }
+                }
+
+                skirtBottoms[face][i] = bottom;
+            }
+        }
+
+        auto isFaceVisible = [&grid, &skirtBottoms, scale](const I32* cell, U32 face) {
+
+            const I32* normal = FaceNormals[face];
+            I32 next[3] = { cell[0] + normal[0], cell[1] + normal[1], cell[2] + normal[2] };
+
+            if (next[1] >= grid.Size[1])
+                return true;
+
+            // Nothing looks at the bottom of the world from far away.
+            if (next[1] < 0)
+                return false;
+
+            if (next[0] < 0 || next[2] < 0 || next[0] >= grid.Size[0] || next[2] >= grid.Size[2])
+                return (cell[1] + 1) * scale > skirtBottoms[face][cell[BlockFaceAxes[face].U]];
+
+            return !BlockRegistry::IsOpaque(grid.Get(next[0], next[1], next[2]));
+        };
+
+        const I32 cellsPerSection = SECTION_HEIGHT / scale;
+        const I32 dimensions[3] = { grid.Size[0], cellsPerSection, grid.Size[2] };
+
+        // Block type and face light, faces are merged like ChunkMesher::MeshGreedy merges blocks.
+        std::vector<U32> mask;
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            if (chunk.IsSectionEmpty(section))
+                continue;
+
+            BRQ::VoxelMeshData& meshData = sectionMeshes[section];
+
+            for (U32 face = 0; face < (U32)BlockFace::BlockFaceMaxEnumerations; face++) {
+
+                const FaceAxes& axes = BlockFaceAxes[face];
+
+                I32 sizeU = dimensions[axes.U];
+                I32 sizeV = dimensions[axes.V];
+
+                mask.resize((U64)sizeU * sizeV);
+
+                for (I32 slice = 0; slice < dimensions[axes.Normal]; slice++) {
+
+                    I32 position[3];
+                    position[axes.Normal] = slice;
+
+                    for (I32 v = 0; v < sizeV; v++) {
+
+                        position[axes.V] = v;
+
+                        for (I32 u = 0; u < sizeU; u++) {
+
+                            position[axes.U] = u;
+
+                            I32 cell[3] = { position[0], position[1] + (I32)section * cellsPerSection, position[2] };
+                            BlockType type = grid.Get(cell[0], cell[1], cell[2]);
+                            U32 key = 0;
+
+                            if (BlockRegistry::IsMeshed(type) && isFaceVisible(cell, face))
+                                key = (U32)type | (U32)GetCellFaceLight(chunk, scale, cell, (BlockFace)face) << 8;
+
+                            mask[u + v * sizeU] = key;
+                        }
+                    }
+
+                    for (I32 v = 0; v < sizeV; v++) {
+
+                        for (I32 u = 0; u < sizeU; ) {
+
+                            U32 key = mask[u + v * sizeU];
+
+                            if (!key) {
+
+                                u++;
+                                continue;
+                            }
+
+                            I32 width = 1;
+
+                            while (u + width < sizeU && mask[u + width + v * sizeU] == key)
+                                width++;
+
+                            I32 height = 1;
+
+                            for (; v + height < sizeV; height++) {
+
+                                bool rowMatches = true;
+
+                                for (I32 i = 0; i < width; i++) {
+
+                                    if (mask[u + i + (v + height) * sizeU] != key) {
+
+                                        rowMatches = false;
+                                        break;
+                                    }
+                                }
+
+                                if (!rowMatches)
+                                    break;
+                            }
+
+                            for (I32 j = 0; j < height; j++)
+                                for (I32 i = 0; i < width; i++)
+                                    mask[u + i + (v + j) * sizeU] = 0;
+
+                            // PushQuad works in blocks, a positive face sits on the last block of its cell.
+                            I32 blockSlice = slice * scale + (axes.NormalSign > 0 ? scale - 1 : 0);
+
+                            ChunkMesher::PushQuad(meshData, (BlockFace)face, (BlockType)(key & 0xFF), (U8)(key >> 8), s_NoOcclusion,
+                                                  blockSlice, u * scale, v * scale, width * scale, height * scale);
+
+                            u += width;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <Engine.h>
+
+#include "ChunkMesher.h"
+
+namespace MC {
+
+    // Meshes distant chunks from block grids downsampled 2x, 4x or 8x per LOD level.
+    // A coarse cell is solid when any of its blocks is, so coarse terrain never sits below the terrain of a finer neighbour,
+    // and takes the type of its topmost block so surfaces keep their grass, sand or snow.
+    // Faces on the chunk border are not culled against the neighbours, which may be meshed at another level. They are kept as
+    // a skirt from the top of the border column down to the lowest surface across the border, which closes the seams between rings.
+    class LodMesher {
+
+    public:
+        // Meshes every section of chunk into sectionMeshes, indexed by section. lod 0 is full detail, see ChunkMesher.
+        static void Mesh(const Chunk& chunk, U32 lod, const ChunkNeighbours& neighbours, BRQ::VoxelMeshData* sectionMeshes);
+
+        // Blocks per side of a coarse cell.
+        static I32 GetScale(U32 lod) { return 1 << lod; }
+    };
+}
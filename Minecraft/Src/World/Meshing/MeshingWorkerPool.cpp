@@ -0,0 +1,124 @@
+#include "MeshingWorkerPool.h"
+
+namespace MC {
+
+    MeshingWorkerPool::MeshingWorkerPool()
+        : m_Mode(MeshingMode::Greedy), m_Running(false) { }
+
+    MeshingWorkerPool::~MeshingWorkerPool() {
+
+        Shutdown();
+    }
+
+    void MeshingWorkerPool::Init(U32 threadCount, MeshingMode mode) {
+
+        BRQ_ASSERT(!m_Running);
+
+        if (threadCount == 0) {
+
+            U32 hardwareThreads = std::thread::hardware_concurrency();
+            threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        m_Mode = mode;
+        m_Running = true;
+
+        m_Workers.reserve(threadCount);
+
+        for (U32 i = 0; i < threadCount; i++)
+            m_Workers.emplace_back(&MeshingWorkerPool::WorkerLoop, this);
+    }
+
+    void MeshingWorkerPool::Shutdown() {
+
+        {
+            std::lock_guard<std::mutex> lock(m_JobMutex);
+
+            if (!m_Running)
+                return;
+
+            m_Running = false;
+            m_Jobs.clear();
+        }
+
+        m_JobAvailable.notify_all();
+
+        for (auto& worker : m_Workers)
+            worker.join();
+
+        m_Workers.clear();
+
+        std::lock_guard<std::mutex> lock(m_CompletedMutex);
+        m_Completed.clear();
+    }
+
+    void MeshingWorkerPool::Submit(MeshingJob&& job) {
+
+        {
+            std::lock_guard<std::mutex> lock(m_JobMutex);
+            m_Jobs.push_back(std::move(job));
+        }
+
+        m_JobAvailable.notify_one();
+    }
+
+    void MeshingWorkerPool::PollCompleted(std::vector<MeshingResult>& results) {
+
+        std::lock_guard<std::mutex> lock(m_CompletedMutex);
+
+        for (auto& result : m_Completed)
+            results.push_back(std::move(result));
+
+        m_Completed.clear();
+    }
+
+    U64 MeshingWorkerPool::GetQueuedJobCount() {
+
+        std::lock_guard<std::mutex> lock(m_JobMutex);
+
+        return m_Jobs.size();
+    }
+
+    void MeshingWorkerPool::WorkerLoop() {
+
+        while (true) {
+
+            MeshingJob job;
+
+            {
+                std::unique_lock<std::mutex> lock(m_JobMutex);
+                m_JobAvailable.wait(lock, [this]() { return !m_Running || !m_Jobs.empty(); });
+
+                if (!m_Running)
+                    return;
+
+                job = std::move(m_Jobs.front());
+                m_Jobs.pop_front();
+            }
+
+            ChunkNeighbours neighbours;
+
+            for (U32 i = 0; i < 6; i++)
+                neighbours.Chunks[i] = job.HasNeighbour[i] ? &job.Neighbours[i] : nullptr;
+
+            for (U32 i = 0; i < 4; i++)
+                neighbours.Corners[i] = job.HasCorner[i] ? &job.Corners[i] : nullptr;
+
+            MeshingResult result;
+            result.Owner = job.Owner;
+            result.Coordinate = job.Coordinate;
+            result.Revision = job.Revision;
+            result.SectionMask = job.SectionMask;
+
+            if (job.Lod)
+                LodMesher::Mesh(job.Center, job.Lod, neighbours, result.SectionMeshes);
+            else
+                ChunkMesher::Mesh(job.Center, job.SectionMask, m_Mode, neighbours, result.SectionMeshes);
+
+            SectionVisibility::Compute(job.Center, job.SectionMask, result.Visibility);
+
+            std::lock_guard<std::mutex> lock(m_CompletedMutex);
+            m_Completed.push_back(std::move(result));
+        }
+    }
+}
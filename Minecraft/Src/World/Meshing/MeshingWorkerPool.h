@@ -0,0 +1,81 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+#include "ChunkMesher.h"
+#include "LodMesher.h"
+#include "../Culling/SectionVisibility.h"
+#include "../Chunks/Chunk.h"
+
+namespace MC {
+
+    // Snapshot of a chunk and the chunks around it. Sections are copy on write, so workers never see later edits to live world data.
+    struct MeshingJob {
+
+        std::weak_ptr<Chunk> Owner;
+        ChunkCoordinate      Coordinate;
+        U32                  Revision = 0;
+        // Sections of Center to mesh, the rest keep their current meshes.
+        U32                  SectionMask = SECTION_MASK;
+        // Chunks above level 0 are meshed whole by LodMesher.
+        U32                  Lod = 0;
+        Chunk                Center;
+        Chunk                Neighbours[6];
+        bool                 HasNeighbour[6] = {};
+        // Diagonal chunks, only their corner columns are read for ambient occlusion.
+        Chunk                Corners[4];
+        bool                 HasCorner[4] = {};
+    };
+
+    struct MeshingResult {
+
+        // Expires when the chunk is unloaded before its mesh is uploaded.
+        std::weak_ptr<Chunk> Owner;
+        ChunkCoordinate      Coordinate;
+        U32                  Revision = 0;
+        U32                  SectionMask = 0;
+        BRQ::VoxelMeshData   SectionMeshes[SECTION_COUNT];
+        U16                  Visibility[SECTION_COUNT] = {};
+    };
+
+    class MeshingWorkerPool {
+
+    private:
+        std::vector<std::thread>   m_Workers;
+
+        std::deque<MeshingJob>     m_Jobs;
+        std::mutex                 m_JobMutex;
+        std::condition_variable    m_JobAvailable;
+
+        std::vector<MeshingResult> m_Completed;
+        std::mutex                 m_CompletedMutex;
+
+        MeshingMode                m_Mode;
+        bool                       m_Running;
+
+    public:
+        MeshingWorkerPool();
+        ~MeshingWorkerPool();
+
+        MeshingWorkerPool(const MeshingWorkerPool&) = delete;
+        MeshingWorkerPool& operator=(const MeshingWorkerPool&) = delete;
+
+        // threadCount 0 uses every hardware thread except the one running the frame loop.
+        void Init(U32 threadCount = 0, MeshingMode mode = MeshingMode::Greedy);
+        void Shutdown();
+
+        void Submit(MeshingJob&& job);
+
+        // Moves every finished mesh into results, never blocks on the workers.
+        void PollCompleted(std::vector<MeshingResult>& results);
+
+        U32 GetThreadCount() const { return (U32)m_Workers.size(); }
+        U64 GetQueuedJobCount();
+
+    private:
+        void WorkerLoop();
+    };
+}
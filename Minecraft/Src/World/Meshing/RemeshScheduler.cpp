@@ -0,0 +1,64 @@
+#include "RemeshScheduler.h"
+
+#include <algorithm>
+
+namespace MC {
+
+    void RemeshScheduler::Schedule(const ChunkCoordinate& coordinate, bool urgent) {
+
+        m_Scheduled.insert(coordinate);
+
+        if (urgent)
+            m_Urgent.insert(coordinate);
+    }
+
+    void RemeshScheduler::Remove(const ChunkCoordinate& coordinate) {
+
+        m_Scheduled.erase(coordinate);
+        m_Urgent.erase(coordinate);
+    }
+
+    void RemeshScheduler::Clear() {
+
+        m_Scheduled.clear();
+        m_Urgent.clear();
+    }
+
+    void RemeshScheduler::Take(const ChunkCoordinate& center, U32 count, std::vector<ChunkCoordinate>& chunks) {
+
+        TakeNearest(m_Scheduled, center, count, chunks);
+    }
+
+    void RemeshScheduler::TakeUrgent(const ChunkCoordinate& center, U32 count, std::vector<ChunkCoordinate>& chunks) {
+
+        TakeNearest(m_Urgent, center, count, chunks);
+    }
+
+    void RemeshScheduler::TakeNearest(const CoordinateSet& candidates, const ChunkCoordinate& center, U32 count, std::vector<ChunkCoordinate>& chunks) {
+
+        U64 first = chunks.size();
+
+        std::vector<std::pair<I32, ChunkCoordinate>> sorted;
+        sorted.reserve(candidates.size());
+
+        for (const ChunkCoordinate& coordinate : candidates) {
+
+            I32 dx = coordinate.X - center.X;
+            I32 dz = coordinate.Z - center.Z;
+
+            sorted.push_back({ dx * dx + dz * dz, coordinate });
+        }
+
+        count = std::min(count, (U32)sorted.size());
+
+        std::partial_sort(sorted.begin(), sorted.begin() + count, sorted.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        for (U32 i = 0; i < count; i++)
+            chunks.push_back(sorted[i].second);
+
+        // candidates may be m_Urgent itself, erase only after reading it.
+        for (U64 i = first; i < chunks.size(); i++)
+            Remove(chunks[i]);
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <unordered_set>
+#include <vector>
+
+#include "../Chunks/ChunkCoordinate.h"
+
+namespace MC {
+
+    // Set of chunks waiting for a (re)mesh. Scheduling a chunk again before it is taken is free,
+    // so any number of edits, light updates or neighbour loads in a frame cost one remesh.
+    class RemeshScheduler {
+
+    private:
+        using CoordinateSet = std::unordered_set<ChunkCoordinate, ChunkCoordinateHash>;
+
+        CoordinateSet m_Scheduled;
+        // Subset of m_Scheduled the player is waiting on, meshed in the frame they were scheduled when possible.
+        CoordinateSet m_Urgent;
+
+    public:
+        RemeshScheduler() = default;
+        ~RemeshScheduler() = default;
+
+        void Schedule(const ChunkCoordinate& coordinate, bool urgent = false);
+        void Remove(const ChunkCoordinate& coordinate);
+        void Clear();
+
+        // Moves up to count scheduled chunks into chunks, nearest to center first.
+        void Take(const ChunkCoordinate& center, U32 count, std::vector<ChunkCoordinate>& chunks);
+        void TakeUrgent(const ChunkCoordinate& center, U32 count, std::vector<ChunkCoordinate>& chunks);
+
+        bool IsScheduled(const ChunkCoordinate& coordinate) const { return m_Scheduled.count(coordinate) != 0; }
+        U64 GetScheduledCount() const { return m_Scheduled.size(); }
+        U64 GetUrgentCount() const { return m_Urgent.size(); }
+
+    private:
+        void TakeNearest(const CoordinateSet& candidates, const ChunkCoordinate& center, U32 count, std::vector<ChunkCoordinate>& chunks);
+    };
+}
@@ -0,0 +1,90 @@
+#include "BlockRegion.h"
+
+#include "../Blocks/BlockRegistry.h"
+
+namespace MC {
+
+    BlockRegion::BlockRegion()
+        : m_Min(0), m_Max(-1), m_ChunkCountX(0), m_ChunkCountZ(0) { }
+
+    void BlockRegion::Build(const glm::ivec3& min, const glm::ivec3& max, const ChunkLookupFunction& lookup) {
+
+        m_Min = min;
+        m_Max = max;
+
+        m_FirstChunk = ChunkCoordinate::FromBlock(min.x, min.z);
+        ChunkCoordinate lastChunk = ChunkCoordinate::FromBlock(max.x, max.z);
+
+        m_ChunkCountX = lastChunk.X - m_FirstChunk.X + 1;
+        m_ChunkCountZ = lastChunk.Z - m_FirstChunk.Z + 1;
+
+        m_Chunks.resize((U64)m_ChunkCountX * m_ChunkCountZ);
+
+        for (I32 z = 0; z < m_ChunkCountZ; z++)
+            for (I32 x = 0; x < m_ChunkCountX; x++)
+                m_Chunks[x + z * m_ChunkCountX] = lookup({ m_FirstChunk.X + x, m_FirstChunk.Z + z });
+    }
+
+    void BlockRegion::GatherSolidBlocks(std::vector<glm::ivec3>& blocks, bool unloadedSolid) const {
+
+        I32 minY = std::max(m_Min.y, 0);
+        I32 maxY = std::min(m_Max.y, CHUNK_HEIGHT - 1);
+
+        if (minY > maxY)
+            return;
+
+        for (I32 chunkZ = m_FirstChunk.Z; chunkZ < m_FirstChunk.Z + m_ChunkCountZ; chunkZ++) {
+
+            for (I32 chunkX = m_FirstChunk.X; chunkX < m_FirstChunk.X + m_ChunkCountX; chunkX++) {
+
+                const Chunk* chunk = GetChunk(chunkX, chunkZ);
+
+                I32 originX = chunkX * CHUNK_WIDTH;
+                I32 originZ = chunkZ * CHUNK_LENGTH;
+
+                // The part of the region inside this chunk, in chunk local coordinates.
+                I32 minX = std::max(m_Min.x, originX) - originX;
+                I32 maxX = std::min(m_Max.x, originX + CHUNK_WIDTH - 1) - originX;
+                I32 minZ = std::max(m_Min.z, originZ) - originZ;
+                I32 maxZ = std::min(m_Max.z, originZ + CHUNK_LENGTH - 1) - originZ;
+
+                if (!chunk) {
+
+                    if (!unloadedSolid)
+                        continue;
+
+                    for (I32 y = minY; y <= maxY; y++)
+                        for (I32 z = minZ; z <= maxZ; z++)
+                            for (I32 x = minX; x <= maxX; x++)
+                                blocks.push_back({ originX + x, y, originZ + z });
+
+                    continue;
+                }
+
+                for (U32 section = (U32)minY / SECTION_HEIGHT; section <= (U32)maxY / SECTION_HEIGHT; section++) {
+
+                    if (chunk->IsSectionEmpty(section))
+                        continue;
+
+                    const BlockStorage& storage = chunk->GetSection(section);
+
+                    I32 sectionY = (I32)section * SECTION_HEIGHT;
+                    I32 firstY = std::max(minY, sectionY);
+                    I32 lastY = std::min(maxY, sectionY + SECTION_HEIGHT - 1);
+
+                    for (I32 y = firstY; y <= lastY; y++) {
+
+                        for (I32 z = minZ; z <= maxZ; z++) {
+
+                            for (I32 x = minX; x <= maxX; x++) {
+
+                                if (BlockRegistry::HasCollision(storage.Get(BlockStorage::ToIndex((U32)x, (U32)(y - sectionY), (U32)z))))
+                                    blocks.push_back({ originX + x, y, originZ + z });
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
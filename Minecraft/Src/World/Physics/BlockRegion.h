@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Engine.h>
+
+#include "../Chunks/Chunk.h"
+
+namespace MC {
+
+    // Returns the loaded chunk at a coordinate, nullptr when it isn't loaded.
+    using ChunkLookupFunction = std::function<const Chunk*(const ChunkCoordinate&)>;
+
+    // Read access to a box of blocks. The chunks overlapping the box are looked up once when building the region,
+    // blocks then come straight from their section storage instead of a chunk lookup per block.
+    class BlockRegion {
+
+    private:
+        std::vector<const Chunk*> m_Chunks;
+        glm::ivec3                m_Min;
+        glm::ivec3                m_Max;
+        ChunkCoordinate           m_FirstChunk;
+        I32                       m_ChunkCountX;
+        I32                       m_ChunkCountZ;
+
+    public:
+        BlockRegion();
+        ~BlockRegion() = default;
+
+        // Covers the blocks from min to max, both inclusive.
+        void Build(const glm::ivec3& min, const glm::ivec3& max, const ChunkLookupFunction& lookup);
+
+        // Appends every non air block of the region. Each chunk is walked in storage order and empty sections are skipped.
+        // Heights outside the world are empty, unloaded chunks are solid only with unloadedSolid.
+        void GatherSolidBlocks(std::vector<glm::ivec3>& blocks, bool unloadedSolid) const;
+
+    private:
+        const Chunk* GetChunk(I32 chunkX, I32 chunkZ) const { return m_Chunks[(chunkX - m_FirstChunk.X) + (chunkZ - m_FirstChunk.Z) * m_ChunkCountX]; }
+    };
+}
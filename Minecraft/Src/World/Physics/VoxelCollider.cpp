@@ -0,0 +1,165 @@
+#include "VoxelCollider.h"
+
+#include "../World.h"
+
+namespace MC {
+
+    // Boxes closer than this count as touching, so float error never lets a box sink into a block or snag on the one
+    // it slides along.
+    static const F32 s_Skin = 1.0e-4f;
+    // How far under a box the ground is looked for.
+    static const F32 s_GroundProbe = 0.01f;
+
+    bool CollisionBox::Intersects(const CollisionBox& other) const {
+
+        return glm::all(glm::greaterThan(Max, other.Min + s_Skin)) && glm::all(glm::lessThan(Min, other.Max - s_Skin));
+    }
+
+    CollisionBox CollisionBox::FromEye(const glm::vec3& eye, F32 width, F32 height, F32 eyeHeight) {
+
+        glm::vec3 min(eye.x - width * 0.5f, eye.y - eyeHeight, eye.z - width * 0.5f);
+
+        return { min, min + glm::vec3(width, height, width) };
+    }
+
+    VoxelCollider::VoxelCollider(const World& world)
+        : m_Lookup([&world](const ChunkCoordinate& coordinate) { return world.GetChunk(coordinate); }), m_UnloadedSolid(false) { }
+
+    VoxelCollider::VoxelCollider(const ChunkLookupFunction& lookup)
+        : m_Lookup(lookup), m_UnloadedSolid(false) { }
+
+    CollisionResult VoxelCollider::Move(const CollisionBox& box, const glm::vec3& displacement, F32 stepHeight) {
+
+        CollisionBox target = box.Offset(displacement);
+
+        // Everything the move and a step up could touch, and the ground under both ends.
+        CollisionBox bounds = { glm::min(box.Min, target.Min), glm::max(box.Max, target.Max) };
+        bounds.Min.y -= s_GroundProbe;
+        bounds.Max.y += stepHeight;
+
+        GatherBlocks(bounds);
+
+        CollisionResult result = {};
+        CollisionBox moved = box;
+
+        result.Displacement = Sweep(moved, displacement, result.Collided);
+
+        bool blocked = result.Collided.x || result.Collided.z;
+        bool grounded = (result.Collided.y && displacement.y < 0.0f) || IsOnBlock(box);
+
+        if (stepHeight > 0.0f && blocked && grounded) {
+
+            CollisionBox stepped = box;
+            glm::bvec3 collided;
+
+            F32 up = Clip(stepped, 1, stepHeight);
+            stepped = stepped.Offset(glm::vec3(0.0f, up, 0.0f));
+
+            glm::vec3 horizontal = Sweep(stepped, glm::vec3(displacement.x, 0.0f, displacement.z), collided);
+
+            // Back down onto whatever the step landed on, and on along a falling move.
+            F32 down = Clip(stepped, 1, std::min(displacement.y, 0.0f) - up);
+            stepped = stepped.Offset(glm::vec3(0.0f, down, 0.0f));
+
+            F32 steppedDistance = horizontal.x * horizontal.x + horizontal.z * horizontal.z;
+            F32 distance = result.Displacement.x * result.Displacement.x + result.Displacement.z * result.Displacement.z;
+
+            if (steppedDistance > distance + s_Skin) {
+
+                result.Displacement = glm::vec3(horizontal.x, up + down, horizontal.z);
+                result.Collided = glm::bvec3(collided.x, result.Collided.y, collided.z);
+                result.SteppedUp = true;
+
+                moved = stepped;
+            }
+        }
+
+        result.Grounded = IsOnBlock(moved);
+
+        return result;
+    }
+
+    bool VoxelCollider::IsGrounded(const CollisionBox& box) {
+
+        CollisionBox bounds = box;
+        bounds.Min.y -= s_GroundProbe;
+
+        GatherBlocks(bounds);
+
+        return IsOnBlock(box);
+    }
+
+    bool VoxelCollider::Overlaps(const CollisionBox& box) {
+
+        GatherBlocks(box);
+
+        for (const glm::ivec3& block : m_Blocks) {
+
+            if (box.Intersects(CollisionBox::FromBlock(block)))
+                return true;
+        }
+
+        return false;
+    }
+
+    void VoxelCollider::GatherBlocks(const CollisionBox& bounds) {
+
+        m_Blocks.clear();
+
+        m_Region.Build(World::ToBlockPosition(bounds.Min - s_Skin), World::ToBlockPosition(bounds.Max + s_Skin), m_Lookup);
+        m_Region.GatherSolidBlocks(m_Blocks, m_UnloadedSolid);
+    }
+
+    F32 VoxelCollider::Clip(const CollisionBox& box, U32 axis, F32 distance) const {
+
+        if (distance == 0.0f)
+            return 0.0f;
+
+        U32 a = (axis + 1) % 3;
+        U32 b = (axis + 2) % 3;
+
+        for (const glm::ivec3& block : m_Blocks) {
+
+            glm::vec3 min = glm::vec3(block) - 0.5f;
+            glm::vec3 max = glm::vec3(block) + 0.5f;
+
+            // Only blocks the box overlaps on the other two axes are in the way.
+            if (box.Max[a] <= min[a] + s_Skin || box.Min[a] >= max[a] - s_Skin)
+                continue;
+
+            if (box.Max[b] <= min[b] + s_Skin || box.Min[b] >= max[b] - s_Skin)
+                continue;
+
+            // Blocks the box already intersects don't stop it, so a box inside terrain can still get out.
+            if (distance > 0.0f && box.Max[axis] <= min[axis] + s_Skin)
+                distance = std::min(distance, std::max(min[axis] - box.Max[axis], 0.0f));
+            else if (distance < 0.0f && box.Min[axis] >= max[axis] - s_Skin)
+                distance = std::max(distance, std::min(max[axis] - box.Min[axis], 0.0f));
+        }
+
+        return distance;
+    }
+
+    glm::vec3 VoxelCollider::Sweep(CollisionBox& box, const glm::vec3& displacement, glm::bvec3& collided) const {
+
+        static const U32 s_Axes[3] = { 1, 0, 2 };
+
+        glm::vec3 moved(0.0f);
+
+        for (U32 axis : s_Axes) {
+
+            moved[axis] = Clip(box, axis, displacement[axis]);
+            collided[axis] = moved[axis] != displacement[axis];
+
+            box.Min[axis] += moved[axis];
+            box.Max[axis] += moved[axis];
+        }
+
+        return moved;
+    }
+
+    bool VoxelCollider::IsOnBlock(const CollisionBox& box) const {
+
+        return Clip(box, 1, -s_GroundProbe) > -s_GroundProbe;
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Engine.h>
+
+#include "BlockRegion.h"
+
+namespace MC {
+
+    class World;
+
+    // Axis aligned box in world space, block b covers [b - 0.5, b + 0.5].
+    struct CollisionBox {
+
+        glm::vec3 Min;
+        glm::vec3 Max;
+
+        CollisionBox Offset(const glm::vec3& offset) const { return { Min + offset, Max + offset }; }
+
+        // Boxes that only touch don't intersect.
+        bool Intersects(const CollisionBox& other) const;
+
+        // Box of width and height around an eye at eyeHeight above its bottom.
+        static CollisionBox FromEye(const glm::vec3& eye, F32 width, F32 height, F32 eyeHeight);
+        static CollisionBox FromBlock(const glm::ivec3& block) { return { glm::vec3(block) - 0.5f, glm::vec3(block) + 0.5f }; }
+    };
+
+    struct CollisionResult {
+
+        // What is left of the requested displacement, to be added to the position.
+        glm::vec3  Displacement;
+        // Axes the movement was stopped on.
+        glm::bvec3 Collided;
+        // A block lies right under the box after the move.
+        bool       Grounded;
+        bool       SteppedUp;
+    };
+
+    // Swept box collision against the block grid. Movement is resolved one axis at a time, Y first, each axis clipped
+    // against the solid blocks of the box swept over the whole displacement. Blocks come from a BlockRegion, so a move
+    // costs one chunk lookup per overlapped chunk and none per block. Keeps its buffers between calls, use one collider
+    // per thread.
+    class VoxelCollider {
+
+    private:
+        ChunkLookupFunction     m_Lookup;
+        BlockRegion             m_Region;
+        std::vector<glm::ivec3> m_Blocks;
+        bool                    m_UnloadedSolid;
+
+    public:
+        explicit VoxelCollider(const World& world);
+        explicit VoxelCollider(const ChunkLookupFunction& lookup);
+        ~VoxelCollider() = default;
+
+        // Unloaded chunks are empty by default, like World::GetBlock. Solid ones keep entities from falling into terrain
+        // that has not streamed in yet.
+        void SetUnloadedSolid(bool solid) { m_UnloadedSolid = solid; }
+
+        // Moves box by displacement as far as the blocks allow. With a step height, a box on the ground that is stopped
+        // horizontally tries the move again lifted by up to stepHeight and keeps that when it gets further.
+        CollisionResult Move(const CollisionBox& box, const glm::vec3& displacement, F32 stepHeight = 0.0f);
+
+        bool IsGrounded(const CollisionBox& box);
+        // Any solid block intersects box, e.g. before spawning an entity or placing a block into it.
+        bool Overlaps(const CollisionBox& box);
+
+    private:
+        // Collects the solid blocks touching bounds into m_Blocks.
+        void GatherBlocks(const CollisionBox& bounds);
+
+        // How far box can move along axis towards distance before hitting one of m_Blocks.
+        F32 Clip(const CollisionBox& box, U32 axis, F32 distance) const;
+        // Moves box along Y, X and Z in turn, returns the displacement it got.
+        glm::vec3 Sweep(CollisionBox& box, const glm::vec3& displacement, glm::bvec3& collided) const;
+
+        bool IsOnBlock(const CollisionBox& box) const;
+    };
+}
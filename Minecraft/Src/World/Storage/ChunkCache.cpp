@@ -0,0 +1,344 @@
+#include "ChunkCache.h"
+
+#include "RegionStorage.h"
+
+namespace MC {
+
+    enum class SectionEncoding : BYTE {
+
+        Uniform = 0,    // One block type.
+        Runs,           // (type, U16 length) runs in BlockStorage::ToIndex order.
+    };
+
+    ChunkCache::ChunkCache()
+        : m_Storage(nullptr), m_Budget(0), m_DecodedSections(CHUNK_CACHE_DECODED), m_ReadTick(0) {
+
+        for (DecodedSection& decoded : m_DecodedSections)
+            decoded.LastUse = 0;
+    }
+
+    void ChunkCache::Init(RegionStorage* storage, U64 budget) {
+
+        Clear();
+
+        m_Storage = storage;
+        m_Budget = budget;
+    }
+
+    void ChunkCache::Clear() {
+
+        m_Entries.clear();
+        m_Index.clear();
+        m_Statistics = {};
+
+        for (DecodedSection& decoded : m_DecodedSections)
+            decoded.LastUse = 0;
+    }
+
+    void ChunkCache::SetBudget(U64 budget) {
+
+        m_Budget = budget;
+
+        Evict();
+    }
+
+    void ChunkCache::Insert(const Chunk& chunk) {
+
+        auto it = m_Index.find(chunk.GetCoordinate());
+
+        if (it != m_Index.end())
+            Erase(it);
+
+        Entry entry;
+        entry.Coordinate = chunk.GetCoordinate();
+        entry.UncompressedSize = chunk.GetMemoryUsage();
+        entry.Modified = chunk.IsModified();
+        entry.Populated = chunk.IsPopulated();
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            EncodeSection(chunk.GetSection(section), m_Encoded, m_Compressed);
+
+            entry.Offsets[section] = (U32)entry.Data.size();
+            entry.EncodedSizes[section] = (U32)m_Encoded.size();
+            entry.Data.insert(entry.Data.end(), m_Compressed.begin(), m_Compressed.end());
+        }
+
+        entry.Offsets[SECTION_COUNT] = (U32)entry.Data.size();
+        entry.Data.shrink_to_fit();
+
+        std::memset(entry.DecodedSlots, 0xFF, sizeof(entry.DecodedSlots));
+
+        m_Statistics.ChunkCount++;
+        m_Statistics.CompressedSize += entry.Data.size();
+        m_Statistics.UncompressedSize += entry.UncompressedSize;
+
+        m_Entries.push_front(std::move(entry));
+        m_Index[chunk.GetCoordinate()] = m_Entries.begin();
+
+        Evict();
+    }
+
+    bool ChunkCache::Take(Chunk& chunk) {
+
+        auto it = m_Index.find(chunk.GetCoordinate());
+
+        if (it == m_Index.end()) {
+
+            m_Statistics.Misses++;
+            return false;
+        }
+
+        const Entry& entry = *it->second;
+
+        std::vector<BlockType> blocks(CHUNK_SIZE);
+
+        if (!Decode(entry, blocks.data())) {
+
+            BRQ_ERROR("Corrupt cached chunk {} {}", entry.Coordinate.X, entry.Coordinate.Z);
+
+            Erase(it);
+            m_Statistics.Misses++;
+
+            return false;
+        }
+
+        chunk.LoadBlocks(blocks.data());
+        chunk.SetPopulated(entry.Populated);
+
+        if (!entry.Modified)
+            chunk.MarkSaved();
+
+        Erase(it);
+        m_Statistics.Hits++;
+
+        return true;
+    }
+
+    bool ChunkCache::GetBlock(const ChunkCoordinate& coordinate, U32 x, U32 y, U32 z, BlockType& type) {
+
+        auto it = m_Index.find(coordinate);
+
+        if (it == m_Index.end())
+            return false;
+
+        Touch(it);
+
+        const DecodedSection* decoded = GetDecodedSection(*it->second, y / SECTION_HEIGHT);
+
+        if (!decoded)
+            return false;
+
+        type = decoded->Blocks[BlockStorage::ToIndex(x, y % SECTION_HEIGHT, z)];
+
+        return true;
+    }
+
+    void ChunkCache::Save() {
+
+        for (Entry& entry : m_Entries) {
+
+            if (entry.Modified)
+                SaveEntry(entry);
+        }
+    }
+
+    void ChunkCache::EncodeSection(const BlockStorage& storage, std::vector<BYTE>& encoded, std::vector<BYTE>& output) {
+
+        encoded.clear();
+
+        if (storage.IsUniform()) {
+
+            encoded.push_back((BYTE)SectionEncoding::Uniform);
+            encoded.push_back((BYTE)storage.GetPalette()[0]);
+        }
+        else {
+
+            encoded.push_back((BYTE)SectionEncoding::Runs);
+
+            U32 start = 0;
+
+            while (start < SECTION_SIZE) {
+
+                BlockType type = storage.Get(start);
+                U32 end = start + 1;
+
+                while (end < SECTION_SIZE && storage.Get(end) == type)
+                    end++;
+
+                U32 length = end - start;
+
+                encoded.push_back((BYTE)type);
+                encoded.push_back((BYTE)(length & 0xFF));
+                encoded.push_back((BYTE)(length >> 8));
+
+                start = end;
+            }
+        }
+
+        output.clear();
+        BRQ::Utilities::Compression::Compress(encoded.data(), encoded.size(), output);
+    }
+
+    bool ChunkCache::DecodeSection(const BYTE* data, U64 size, U32 encodedSize, std::vector<BYTE>& encoded, BlockType* blocks) {
+
+        encoded.resize(encodedSize);
+
+        if (!encodedSize || !BRQ::Utilities::Compression::Decompress(data, size, encoded.data(), encodedSize))
+            return false;
+
+        U64 offset = 0;
+        SectionEncoding encoding = (SectionEncoding)encoded[offset++];
+
+        if (encoding == SectionEncoding::Uniform) {
+
+            if (encodedSize != 2)
+                return false;
+
+            std::fill(blocks, blocks + SECTION_SIZE, (BlockType)encoded[offset]);
+
+            return true;
+        }
+
+        if (encoding != SectionEncoding::Runs)
+            return false;
+
+        U32 index = 0;
+
+        while (index < SECTION_SIZE) {
+
+            if (offset + 3 > encodedSize)
+                return false;
+
+            BlockType type = (BlockType)encoded[offset];
+            U32 length = encoded[offset + 1] | ((U32)encoded[offset + 2] << 8);
+            offset += 3;
+
+            if (length == 0 || index + length > SECTION_SIZE)
+                return false;
+
+            std::fill(blocks + index, blocks + index + length, type);
+            index += length;
+        }
+
+        return offset == encodedSize;
+    }
+
+    bool ChunkCache::Decode(const Entry& entry, BlockType* blocks) {
+
+        for (U32 section = 0; section < SECTION_COUNT; section++) {
+
+            if (!DecodeSection(entry, section, blocks + section * SECTION_SIZE))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool ChunkCache::DecodeSection(const Entry& entry, U32 section, BlockType* blocks) {
+
+        U32 offset = entry.Offsets[section];
+
+        return DecodeSection(entry.Data.data() + offset, entry.Offsets[section + 1] - offset, entry.EncodedSizes[section], m_Encoded, blocks);
+    }
+
+    const ChunkCache::DecodedSection* ChunkCache::GetDecodedSection(Entry& entry, U32 section) {
+
+        U8 slot = entry.DecodedSlots[section];
+
+        if (slot < m_DecodedSections.size()) {
+
+            DecodedSection& decoded = m_DecodedSections[slot];
+
+            if (decoded.LastUse && decoded.Section == section && decoded.Coordinate == entry.Coordinate) {
+
+                decoded.LastUse = ++m_ReadTick;
+                return &decoded;
+            }
+        }
+
+        DecodedSection* oldest = &m_DecodedSections[0];
+
+        for (DecodedSection& decoded : m_DecodedSections) {
+
+            if (decoded.LastUse < oldest->LastUse)
+                oldest = &decoded;
+        }
+
+        m_Statistics.SectionDecodes++;
+
+        if (!DecodeSection(entry, section, oldest->Blocks)) {
+
+            oldest->LastUse = 0;
+            return nullptr;
+        }
+
+        oldest->Coordinate = entry.Coordinate;
+        oldest->Section = section;
+        oldest->LastUse = ++m_ReadTick;
+
+        entry.DecodedSlots[section] = (U8)(oldest - m_DecodedSections.data());
+
+        return oldest;
+    }
+
+    void ChunkCache::Touch(EntryMap::iterator it) {
+
+        m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+    }
+
+    void ChunkCache::Erase(EntryMap::iterator it) {
+
+        const Entry& entry = *it->second;
+
+        for (DecodedSection& decoded : m_DecodedSections) {
+
+            if (decoded.Coordinate == entry.Coordinate)
+                decoded.LastUse = 0;
+        }
+
+        m_Statistics.ChunkCount--;
+        m_Statistics.CompressedSize -= entry.Data.size();
+        m_Statistics.UncompressedSize -= entry.UncompressedSize;
+
+        m_Entries.erase(it->second);
+        m_Index.erase(it);
+    }
+
+    void ChunkCache::Evict() {
+
+        while (!m_Entries.empty() && m_Statistics.CompressedSize > m_Budget) {
+
+            Entry& entry = m_Entries.back();
+
+            if (entry.Modified)
+                SaveEntry(entry);
+
+            Erase(m_Index.find(entry.Coordinate));
+            m_Statistics.Evictions++;
+        }
+    }
+
+    void ChunkCache::SaveEntry(Entry& entry) {
+
+        if (!m_Storage)
+            return;
+
+        Chunk chunk;
+        chunk.SetCoordinate(entry.Coordinate);
+
+        std::vector<BlockType> blocks(CHUNK_SIZE);
+
+        if (!Decode(entry, blocks.data())) {
+
+            BRQ_ERROR("Corrupt cached chunk {} {}", entry.Coordinate.X, entry.Coordinate.Z);
+            return;
+        }
+
+        chunk.LoadBlocks(blocks.data());
+        chunk.SetPopulated(entry.Populated);
+        m_Storage->SaveChunk(chunk);
+
+        entry.Modified = false;
+    }
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <list>
+#include <unordered_map>
+
+#include "../Chunks/Chunk.h"
+
+namespace MC {
+
+    class RegionStorage;
+
+    struct ChunkCacheStatistics {
+
+        U64 ChunkCount        = 0;
+        // Bytes held by compressed blocks.
+        U64 CompressedSize    = 0;
+        // Bytes the same chunks used as palette storage before they were compressed.
+        U64 UncompressedSize  = 0;
+        U64 Hits              = 0;
+        U64 Misses            = 0;
+        U64 Evictions         = 0;
+        // Sections GetBlock decompressed because they weren't among the recently read ones.
+        U64 SectionDecodes    = 0;
+    };
+
+    // Warm tier between loaded chunks and the region files. Unloaded chunks keep their blocks here, every section run
+    // length encoded and LZ compressed on its own, so they come back without disk reads or regeneration and a block
+    // read only decompresses the section it falls in. Chunks are kept in least recently used order, once the
+    // compressed size passes the budget the oldest are dropped and the modified ones among them go to the region
+    // storage. Light is not kept, chunks are relit when they load again like chunks read from disk. Not thread safe,
+    // meant for the main thread.
+    class ChunkCache {
+
+    private:
+        struct Entry {
+
+            ChunkCoordinate   Coordinate;
+            // Compressed sections back to back, section i is Data[Offsets[i], Offsets[i + 1]).
+            std::vector<BYTE> Data;
+            U32               Offsets[SECTION_COUNT + 1];
+            U32               EncodedSizes[SECTION_COUNT];
+            // Where GetBlock last decoded each section, only valid while the slot still holds that section.
+            U8                DecodedSlots[SECTION_COUNT];
+            U64               UncompressedSize;
+            bool              Modified;
+            bool              Populated;
+        };
+
+        struct DecodedSection {
+
+            ChunkCoordinate   Coordinate;
+            U32               Section;
+            // Read tick of the last use, the lowest is replaced first and zero means empty.
+            U64               LastUse;
+            BlockType         Blocks[SECTION_SIZE];
+        };
+
+        using EntryList = std::list<Entry>;
+        using EntryMap  = std::unordered_map<ChunkCoordinate, EntryList::iterator, ChunkCoordinateHash>;
+
+        // Most recently used first.
+        EntryList                   m_Entries;
+        EntryMap                    m_Index;
+        RegionStorage*              m_Storage;
+        U64                         m_Budget;
+
+        ChunkCacheStatistics        m_Statistics;
+
+        // Sections last read through GetBlock, so reads that go back and forth between a few chunks, like along a
+        // chunk border, decompress each section once.
+        std::vector<DecodedSection> m_DecodedSections;
+        U64                         m_ReadTick;
+
+        // Scratch space for the run length encoded and the compressed blocks of a section.
+        std::vector<BYTE>           m_Encoded;
+        std::vector<BYTE>           m_Compressed;
+
+    public:
+        ChunkCache();
+        ~ChunkCache() = default;
+
+        // Evicted chunks that were modified are saved to storage, without one they are lost.
+        void Init(RegionStorage* storage, U64 budget);
+        void Clear();
+
+        void SetBudget(U64 budget);
+        U64 GetBudget() const { return m_Budget; }
+
+        // Compresses the chunk's blocks as the most recently used entry, replacing an older entry of the same chunk.
+        void Insert(const Chunk& chunk);
+        // Moves the cached blocks back into chunk, which has to be at the same coordinate, and drops the entry.
+        // The chunk is marked modified when its cached blocks were never saved and keeps its populated state.
+        // Returns false on a miss.
+        bool Take(Chunk& chunk);
+
+        bool Contains(const ChunkCoordinate& coordinate) const { return m_Index.find(coordinate) != m_Index.end(); }
+        // Reads a block of a cached chunk, y spans the whole column. Returns false when the chunk isn't cached.
+        bool GetBlock(const ChunkCoordinate& coordinate, U32 x, U32 y, U32 z, BlockType& type);
+
+        // Saves modified entries to the region storage, they stay cached.
+        void Save();
+
+        const ChunkCacheStatistics& GetStatistics() const { return m_Statistics; }
+
+        // Run length encodes a section and LZ compresses the result. encoded is scratch space, its size afterwards is
+        // what DecodeSection needs.
+        static void EncodeSection(const BlockStorage& storage, std::vector<BYTE>& encoded, std::vector<BYTE>& output);
+        // Decodes into SECTION_SIZE blocks laid out by BlockStorage::ToIndex.
+        static bool DecodeSection(const BYTE* data, U64 size, U32 encodedSize, std::vector<BYTE>& encoded, BlockType* blocks);
+
+    private:
+        // Decodes into CHUNK_SIZE blocks laid out like Chunk::LoadBlocks wants them.
+        bool Decode(const Entry& entry, BlockType* blocks);
+        bool DecodeSection(const Entry& entry, U32 section, BlockType* blocks);
+        // Returns the decoded section, decompressing it into the least recently read slot when it isn't decoded yet.
+        const DecodedSection* GetDecodedSection(Entry& entry, U32 section);
+        void Touch(EntryMap::iterator it);
+        void Erase(EntryMap::iterator it);
+        void Evict();
+        void SaveEntry(Entry& entry);
+    };
+}
@@ -0,0 +1,223 @@
+#include "RegionFile.h"
+
+#include <filesystem>
+
+namespace MC {
+
+    RegionFile::RegionFile() {
+
+        std::memset(m_Entries, 0, sizeof(m_Entries));
+    }
+
+    RegionFile::~RegionFile() {
+
+        Close();
+    }
+
+    bool RegionFile::Open(const std::string& path) {
+
+        m_Path = path;
+
+        if (!std::filesystem::exists(m_Path)) {
+
+            std::ofstream file(m_Path, std::ios::binary);
+
+            if (!file) {
+
+                BRQ_WARN("Can't create region file: {}", m_Path.c_str());
+                return false;
+            }
+
+            std::vector<BYTE> header(REGION_HEADER_SECTORS * REGION_SECTOR_SIZE, 0);
+
+            RegionHeader* fields = (RegionHeader*)header.data();
+            fields->Magic = REGION_MAGIC;
+            fields->Version = REGION_VERSION;
+            fields->SectorSize = REGION_SECTOR_SIZE;
+            fields->ChunkCount = REGION_CHUNK_COUNT;
+
+            file.write((const char*)header.data(), header.size());
+        }
+
+        if (!m_Mapping.Open(m_Path) || m_Mapping.GetSize() < sizeof(RegionHeader)) {
+
+            BRQ_WARN("Can't read region file: {}", m_Path.c_str());
+            return false;
+        }
+
+        const RegionHeader* header = (const RegionHeader*)m_Mapping.GetData();
+
+        if (header->Magic != REGION_MAGIC || header->Version != REGION_VERSION ||
+            header->SectorSize != REGION_SECTOR_SIZE || header->ChunkCount != REGION_CHUNK_COUNT) {
+
+            BRQ_WARN("Region file has an unsupported format: {}", m_Path.c_str());
+            m_Mapping.Close();
+            return false;
+        }
+
+        std::memcpy(m_Entries, header->Entries, sizeof(m_Entries));
+
+        m_UsedSectors.assign(m_Mapping.GetSize() / REGION_SECTOR_SIZE, false);
+        MarkSectors(0, REGION_HEADER_SECTORS, true);
+
+        U32 corrupt = 0;
+
+        for (RegionEntry& entry : m_Entries) {
+
+            if (!entry.Sector)
+                continue;
+
+            // Drop entries pointing into the header, past the end of a truncated file or at sectors of another
+            // entry. Keeping them would hand out the header or another chunk's payload once the chunk is rewritten.
+            if (entry.Sector < REGION_HEADER_SECTORS || (U64)entry.Sector * REGION_SECTOR_SIZE + entry.Size > m_Mapping.GetSize() ||
+                !AreSectorsFree(entry.Sector, GetSectorCount(entry.Size))) {
+
+                entry = {};
+                corrupt++;
+                continue;
+            }
+
+            MarkSectors(entry.Sector, GetSectorCount(entry.Size), true);
+        }
+
+        if (corrupt)
+            BRQ_WARN("Dropped {} corrupt chunk entries of region file: {}", corrupt, m_Path.c_str());
+
+        m_Stream.open(m_Path, std::ios::in | std::ios::out | std::ios::binary);
+
+        return true;
+    }
+
+    void RegionFile::Close() {
+
+        m_Mapping.Close();
+
+        if (m_Stream.is_open())
+            m_Stream.close();
+    }
+
+    bool RegionFile::Read(U32 index, std::vector<BYTE>& payload) {
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        const RegionEntry& entry = m_Entries[index];
+
+        if (!entry.Sector)
+            return false;
+
+        U64 offset = (U64)entry.Sector * REGION_SECTOR_SIZE;
+
+        if (offset + entry.Size > m_Mapping.GetSize())
+            m_Mapping.Remap();
+
+        if (offset + entry.Size > m_Mapping.GetSize())
+            return false;
+
+        payload.assign(m_Mapping.GetData() + offset, m_Mapping.GetData() + offset + entry.Size);
+
+        return true;
+    }
+
+    void RegionFile::Write(const std::vector<std::pair<U32, std::vector<BYTE>>>& payloads) {
+
+        std::vector<U32> sectors(payloads.size());
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            for (U64 i = 0; i < payloads.size(); i++)
+                sectors[i] = AllocateSectors(GetSectorCount((U32)payloads[i].second.size()));
+        }
+
+        // The new sectors are not referenced by the header yet, so readers can't observe them while they are written.
+        for (U64 i = 0; i < payloads.size(); i++) {
+
+            const std::vector<BYTE>& payload = payloads[i].second;
+
+            std::vector<BYTE> padded(GetSectorCount((U32)payload.size()) * REGION_SECTOR_SIZE, 0);
+            std::memcpy(padded.data(), payload.data(), payload.size());
+
+            m_Stream.seekp((U64)sectors[i] * REGION_SECTOR_SIZE);
+            m_Stream.write((const char*)padded.data(), padded.size());
+        }
+
+        m_Stream.flush();
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        for (U64 i = 0; i < payloads.size(); i++) {
+
+            RegionEntry& entry = m_Entries[payloads[i].first];
+
+            if (entry.Sector)
+                MarkSectors(entry.Sector, GetSectorCount(entry.Size), false);
+
+            entry.Sector = sectors[i];
+            entry.Size = (U32)payloads[i].second.size();
+        }
+
+        m_Stream.seekp(offsetof(RegionHeader, Entries));
+        m_Stream.write((const char*)m_Entries, sizeof(m_Entries));
+        m_Stream.flush();
+
+        if (!m_Stream)
+            BRQ_ERROR("Failed to write region file: {}", m_Path.c_str());
+
+        m_Mapping.Remap();
+    }
+
+    ChunkCoordinate RegionFile::ToRegionCoordinate(const ChunkCoordinate& chunk) {
+
+        return { FloorDivide(chunk.X, REGION_SIZE), FloorDivide(chunk.Z, REGION_SIZE) };
+    }
+
+    U32 RegionFile::ToIndex(const ChunkCoordinate& chunk) {
+
+        U32 x = (U32)(chunk.X - FloorDivide(chunk.X, REGION_SIZE) * REGION_SIZE);
+        U32 z = (U32)(chunk.Z - FloorDivide(chunk.Z, REGION_SIZE) * REGION_SIZE);
+
+        return x + z * REGION_SIZE;
+    }
+
+    U32 RegionFile::AllocateSectors(U32 count) {
+
+        U32 run = 0;
+
+        for (U32 sector = REGION_HEADER_SECTORS; sector < (U32)m_UsedSectors.size(); sector++) {
+
+            run = m_UsedSectors[sector] ? 0 : run + 1;
+
+            if (run == count) {
+
+                MarkSectors(sector + 1 - count, count, true);
+                return sector + 1 - count;
+            }
+        }
+
+        // Grow the file, reusing a free run that ends at the current end.
+        U32 sector = (U32)m_UsedSectors.size() - run;
+        MarkSectors(sector, count, true);
+
+        return sector;
+    }
+
+    bool RegionFile::AreSectorsFree(U32 sector, U32 count) const {
+
+        for (U32 i = 0; i < count; i++) {
+
+            if ((U64)sector + i < m_UsedSectors.size() && m_UsedSectors[sector + i])
+                return false;
+        }
+
+        return true;
+    }
+
+    void RegionFile::MarkSectors(U32 sector, U32 count, bool used) {
+
+        if (m_UsedSectors.size() < (U64)sector + count)
+            m_UsedSectors.resize((U64)sector + count, false);
+
+        for (U32 i = 0; i < count; i++)
+            m_UsedSectors[sector + i] = used;
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <mutex>
+#include <fstream>
+
+#include "../WorldConfig.h"
+#include "../Chunks/ChunkCoordinate.h"
+
+namespace MC {
+
+    constexpr U32 REGION_MAGIC        = 0x52515242;   // "BRQR"
+    constexpr U32 REGION_VERSION      = 1;
+    constexpr U32 REGION_SECTOR_SIZE  = 4096;
+    constexpr U32 REGION_CHUNK_COUNT  = REGION_SIZE * REGION_SIZE;
+
+    struct RegionEntry {
+
+        U32 Sector;     // 0 when the chunk was never saved
+        U32 Size;       // bytes
+    };
+
+    struct RegionHeader {
+
+        U32         Magic;
+        U32         Version;
+        U32         SectorSize;
+        U32         ChunkCount;
+        RegionEntry Entries[REGION_CHUNK_COUNT];
+    };
+
+    constexpr U32 REGION_HEADER_SECTORS = (sizeof(RegionHeader) + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE;
+
+    // REGION_SIZE x REGION_SIZE chunks in one file. The header maps every chunk to a run of
+    // 4KB sectors holding its payload, sectors are allocated first fit and a rewritten chunk
+    // always moves to new sectors so readers never see a half written payload.
+    // Reads go through a memory mapping, writes through a stream owned by the writer thread.
+    class RegionFile {
+
+    private:
+        std::string                m_Path;
+        BRQ::Utilities::MappedFile m_Mapping;
+        std::fstream               m_Stream;
+
+        RegionEntry                m_Entries[REGION_CHUNK_COUNT];
+        std::vector<bool>          m_UsedSectors;
+        std::mutex                 m_Mutex;
+
+    public:
+        RegionFile();
+        ~RegionFile();
+
+        RegionFile(const RegionFile&) = delete;
+        RegionFile& operator=(const RegionFile&) = delete;
+
+        // Creates the file when it does not exist yet.
+        bool Open(const std::string& path);
+        void Close();
+
+        // Copies the stored payload of the chunk at local index, false if it was never saved.
+        bool Read(U32 index, std::vector<BYTE>& payload);
+
+        // Stores every (local index, payload) pair with a single header update. Only one thread may write.
+        void Write(const std::vector<std::pair<U32, std::vector<BYTE>>>& payloads);
+
+        static ChunkCoordinate ToRegionCoordinate(const ChunkCoordinate& chunk);
+        static U32 ToIndex(const ChunkCoordinate& chunk);
+
+    private:
+        U32 AllocateSectors(U32 count);
+        bool AreSectorsFree(U32 sector, U32 count) const;
+        void MarkSectors(U32 sector, U32 count, bool used);
+
+        static U32 GetSectorCount(U32 size) { return (size + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE; }
+    };
+}
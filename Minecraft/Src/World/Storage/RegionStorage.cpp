@@ -0,0 +1,235 @@
+#include "RegionStorage.h"
+
+#include <filesystem>
+
+namespace MC {
+
+    RegionStorage::RegionStorage()
+        : m_FlushRequested(false), m_Running(false), m_BatchSize(0) { }
+
+    RegionStorage::~RegionStorage() {
+
+        Shutdown();
+    }
+
+    void RegionStorage::Init(const std::string& directory, U32 batchSize) {
+
+        BRQ_ASSERT(!m_Running);
+
+        m_Directory = directory;
+        m_BatchSize = batchSize;
+
+        std::error_code error;
+        std::filesystem::create_directories(m_Directory, error);
+
+        if (error)
+            BRQ_WARN("Can't create save directory: {}", m_Directory.c_str());
+
+        m_Running = true;
+        m_Writer = std::thread(&RegionStorage::WriterLoop, this);
+    }
+
+    void RegionStorage::Shutdown() {
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            if (!m_Running)
+                return;
+
+            m_Running = false;
+        }
+
+        m_WriteRequested.notify_one();
+        m_Writer.join();
+
+        m_Regions.clear();
+    }
+
+    bool RegionStorage::LoadChunk(Chunk& chunk) {
+
+        const ChunkCoordinate& coordinate = chunk.GetCoordinate();
+
+        std::vector<BYTE> data;
+        RegionFile* region = nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            // Chunks that are queued or being written are newer than anything on disk.
+            auto pending = m_Pending.find(coordinate);
+            auto writing = m_Writing.find(coordinate);
+
+            if (pending != m_Pending.end())
+                data = pending->second;
+            else if (writing != m_Writing.end())
+                data = writing->second;
+            else
+                region = GetRegion(RegionFile::ToRegionCoordinate(coordinate), false);
+        }
+
+        if (region) {
+
+            std::vector<BYTE> payload;
+
+            if (!region->Read(RegionFile::ToIndex(coordinate), payload))
+                return false;
+
+            U32 size = 0;
+
+            if (payload.size() >= sizeof(size))
+                std::memcpy(&size, payload.data(), sizeof(size));
+
+            // Checked before allocating, a corrupt size must not ask for gigabytes.
+            if (size > Chunk::GetMaxSerializedSize())
+                size = 0;
+
+            data.resize(size);
+
+            if (!size || !BRQ::Utilities::Compression::Decompress(payload.data() + sizeof(size), payload.size() - sizeof(size), data.data(), size)) {
+
+                BRQ_WARN("Corrupt chunk {} {} in region file", coordinate.X, coordinate.Z);
+                return false;
+            }
+        }
+
+        if (data.empty())
+            return false;
+
+        if (!chunk.Deserialize(data.data(), data.size())) {
+
+            BRQ_WARN("Can't deserialize chunk {} {}", coordinate.X, coordinate.Z);
+            return false;
+        }
+
+        return true;
+    }
+
+    void RegionStorage::SaveChunk(const Chunk& chunk) {
+
+        std::vector<BYTE> data;
+        chunk.Serialize(data);
+
+        bool flush = false;
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            m_Pending[chunk.GetCoordinate()] = std::move(data);
+
+            if (m_Pending.size() >= m_BatchSize)
+                flush = m_FlushRequested = true;
+        }
+
+        if (flush)
+            m_WriteRequested.notify_one();
+    }
+
+    void RegionStorage::Flush() {
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_FlushRequested = true;
+        }
+
+        m_WriteRequested.notify_one();
+    }
+
+    U64 RegionStorage::GetPendingCount() {
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        return m_Pending.size() + m_Writing.size();
+    }
+
+    RegionFile* RegionStorage::GetRegion(const ChunkCoordinate& region, bool create) {
+
+        auto it = m_Regions.find(region);
+
+        if (it != m_Regions.end() && (it->second || !create))
+            return it->second.get();
+
+        std::string path = m_Directory + "r." + std::to_string(region.X) + "." + std::to_string(region.Z) + ".region";
+
+        std::unique_ptr<RegionFile> file;
+
+        if (create || std::filesystem::exists(path)) {
+
+            file = std::make_unique<RegionFile>();
+
+            if (!file->Open(path))
+                file.reset();
+        }
+
+        RegionFile* result = file.get();
+        m_Regions[region] = std::move(file);
+
+        return result;
+    }
+
+    void RegionStorage::WriterLoop() {
+
+        while (true) {
+
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_WriteRequested.wait(lock, [this]() { return m_FlushRequested || !m_Running; });
+
+                if (m_Pending.empty()) {
+
+                    m_FlushRequested = false;
+
+                    if (!m_Running)
+                        return;
+
+                    continue;
+                }
+
+                m_FlushRequested = false;
+                m_Writing = std::move(m_Pending);
+                m_Pending.clear();
+            }
+
+            // Readers only look at m_Writing under the lock and never modify it, so it is safe to read here.
+            WriteBatch(m_Writing);
+
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Writing.clear();
+        }
+    }
+
+    void RegionStorage::WriteBatch(const ChunkDataMap& batch) {
+
+        std::unordered_map<ChunkCoordinate, std::vector<std::pair<U32, std::vector<BYTE>>>, ChunkCoordinateHash> regions;
+
+        std::vector<BYTE> compressed;
+
+        for (const auto& [coordinate, data] : batch) {
+
+            BRQ::Utilities::Compression::Compress(data.data(), data.size(), compressed);
+
+            U32 size = (U32)data.size();
+
+            std::vector<BYTE> payload(sizeof(size) + compressed.size());
+            std::memcpy(payload.data(), &size, sizeof(size));
+            std::memcpy(payload.data() + sizeof(size), compressed.data(), compressed.size());
+
+            regions[RegionFile::ToRegionCoordinate(coordinate)].push_back({ RegionFile::ToIndex(coordinate), std::move(payload) });
+        }
+
+        for (const auto& [coordinate, payloads] : regions) {
+
+            RegionFile* region = nullptr;
+
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                region = GetRegion(coordinate, true);
+            }
+
+            if (region)
+                region->Write(payloads);
+            else
+                BRQ_ERROR("Dropped {} chunks, region {} {} can't be opened", (U64)payloads.size(), coordinate.X, coordinate.Z);
+        }
+    }
+}
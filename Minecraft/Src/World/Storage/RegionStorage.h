@@ -0,0 +1,63 @@
+#pragma once
+
+#include <thread>
+#include <condition_variable>
+#include <unordered_map>
+
+#include "RegionFile.h"
+#include "../Chunks/Chunk.h"
+
+namespace MC {
+
+    // Saves and loads chunks through region files in one directory. SaveChunk only queues the
+    // serialized chunk, a background thread compresses and writes queued chunks in batches
+    // grouped by region whenever Flush is called or the queue grows past m_BatchSize.
+    class RegionStorage {
+
+    private:
+        using ChunkDataMap = std::unordered_map<ChunkCoordinate, std::vector<BYTE>, ChunkCoordinateHash>;
+        using RegionMap    = std::unordered_map<ChunkCoordinate, std::unique_ptr<RegionFile>, ChunkCoordinateHash>;
+
+        std::string             m_Directory;
+
+        // Null entries remember regions that have no file yet.
+        RegionMap               m_Regions;
+
+        // Serialized, uncompressed chunks waiting for the writer and the batch it is writing right now.
+        ChunkDataMap            m_Pending;
+        ChunkDataMap            m_Writing;
+
+        std::thread             m_Writer;
+        std::mutex              m_Mutex;
+        std::condition_variable m_WriteRequested;
+        bool                    m_FlushRequested;
+        bool                    m_Running;
+        U32                     m_BatchSize;
+
+    public:
+        RegionStorage();
+        ~RegionStorage();
+
+        RegionStorage(const RegionStorage&) = delete;
+        RegionStorage& operator=(const RegionStorage&) = delete;
+
+        void Init(const std::string& directory, U32 batchSize = 256);
+        // Writes everything still queued before returning.
+        void Shutdown();
+
+        // Fills the chunk at its coordinate with saved blocks, false if it was never saved.
+        bool LoadChunk(Chunk& chunk);
+        void SaveChunk(const Chunk& chunk);
+
+        // Wakes the writer without waiting for it.
+        void Flush();
+
+        U64 GetPendingCount();
+
+    private:
+        RegionFile* GetRegion(const ChunkCoordinate& region, bool create);
+
+        void WriterLoop();
+        void WriteBatch(const ChunkDataMap& batch);
+    };
+}
@@ -0,0 +1,1059 @@
+#include "World.h"
+
+namespace MC {
+
+    static const I32 s_NeighbourOffsets[6][2] = {
+
+        {  0,  1 },     // Front
+        {  0, -1 },     // Back
+        { -1,  0 },     // Left
+        {  1,  0 },     // Right
+        {  0,  0 },     // Top
+        {  0,  0 },     // Bottom
+    };
+
+    // Same order as ChunkNeighbours::Corners.
+    static const I32 s_CornerOffsets[4][2] = {
+
+        { -1, -1 },
+        {  1, -1 },
+        { -1,  1 },
+        {  1,  1 },
+    };
+
+    static I32 DistanceSquared(const ChunkCoordinate& a, const ChunkCoordinate& b) {
+
+        I32 dx = a.X - b.X;
+        I32 dz = a.Z - b.Z;
+
+        return dx * dx + dz * dz;
+    }
+
+    // Squared distance from b to the nearest chunk of the WORLD_TERRAIN_MARGIN square around a. Populating, lighting
+    // and meshing a chunk each wait for the 3x3 chunks around it, so a chunk is meshed only once the whole square
+    // around it is loaded. Loading by this distance keeps the meshed disc as large as the load radius.
+    static I32 TerrainDistanceSquared(const ChunkCoordinate& a, const ChunkCoordinate& b) {
+
+        I32 dx = std::max(std::abs(a.X - b.X) - WORLD_TERRAIN_MARGIN, 0);
+        I32 dz = std::max(std::abs(a.Z - b.Z) - WORLD_TERRAIN_MARGIN, 0);
+
+        return dx * dx + dz * dz;
+    }
+
+    World::World()
+        : m_MeshingJobsInFlight(0), m_CameraPosition(0.0f), m_CameraDirection(0.0f, 1.0f), m_LoadQueueDirty(true), m_LightingJobInFlight(false), m_Frame(0) { }
+
+    void World::Init(const StreamingSettings& settings, const std::string& saveDirectory) {
+
+        m_Settings = settings;
+
+        m_Storage.Init(saveDirectory + "Regions/");
+        m_ChunkCache.Init(&m_Storage, m_Settings.ChunkCacheBudget);
+        m_GenerationPool.Init(&m_Generator);
+        m_MeshingPool.Init();
+        m_LightingWorker.Init();
+        m_AutosaveTimer.Reset();
+
+        BRQ_INFO("World: load radius {} chunks, generation and meshing on {} and {} worker threads", m_Settings.LoadRadius,
+                 m_GenerationPool.GetThreadCount(), m_MeshingPool.GetThreadCount());
+    }
+
+    void World::Shutdown() {
+
+        m_GenerationPool.Shutdown();
+        m_Generating.clear();
+        m_GeneratedChunks.clear();
+        m_PendingEdits.clear();
+
+        m_MeshingPool.Shutdown();
+        m_ReadyMeshes.clear();
+        m_MeshingJobsInFlight = 0;
+
+        m_LightingWorker.Shutdown();
+        m_LightQueue.clear();
+        m_LightEdits.clear();
+        m_LightingJobInFlight = false;
+
+        Save();
+        m_ChunkCache.Clear();
+        m_Storage.Shutdown();
+
+        BRQ::Renderer::GetInstance()->WaitIdle();
+
+        for (auto& [coordinate, chunk] : m_Chunks)
+            chunk->DestroyMeshes();
+
+        m_Chunks.clear();
+        m_LoadQueue.clear();
+        m_RemeshScheduler.Clear();
+
+        DestroyRetiredMeshes(true);
+    }
+
+    void World::Update(const BRQ::Camera& camera) {
+
+        m_Frame++;
+
+        UpdateCamera(camera);
+        GenerateChunks();
+        UpdateLighting();
+        UploadMeshes();
+        RemeshUrgentChunks();
+        ScheduleMeshing();
+        DestroyRetiredMeshes(false);
+
+        if (m_AutosaveTimer.GetTime() > WORLD_AUTOSAVE_INTERVAL * 1000.0f) {
+
+            m_AutosaveTimer.Reset();
+            Save();
+        }
+    }
+
+    void World::Save() {
+
+        for (auto& [coordinate, chunk] : m_Chunks) {
+
+            if (!chunk->IsModified())
+                continue;
+
+            m_Storage.SaveChunk(*chunk);
+            chunk->MarkSaved();
+        }
+
+        m_ChunkCache.Save();
+        m_Storage.Flush();
+    }
+
+    void World::Render(BRQ::Renderer* renderer) const {
+
+        m_OcclusionCuller.Begin(m_CameraChunk, m_Settings.UnloadRadius + WORLD_TERRAIN_MARGIN);
+
+        for (const auto& [coordinate, chunk] : m_Chunks)
+            m_OcclusionCuller.AddChunk(*chunk);
+
+        m_VisibleSections.clear();
+        m_OcclusionCuller.Cull(m_CameraPosition, renderer->GetFrustum(), m_VisibleSections);
+
+        m_DrawList.Clear();
+
+        for (const VisibleSection& visible : m_VisibleSections) {
+
+            const Chunk& chunk = *visible.Column;
+            m_DrawList.Add(chunk.GetSectionMesh(visible.Section), chunk.GetSectionPosition(visible.Section), chunk.GetLod());
+        }
+
+        renderer->SubmitVoxelMeshes(m_DrawList);
+    }
+
+    Chunk* World::GetChunk(const ChunkCoordinate& coordinate) {
+
+        auto it = m_Chunks.find(coordinate);
+
+        return it != m_Chunks.end() ? it->second.get() : nullptr;
+    }
+
+    const Chunk* World::GetChunk(const ChunkCoordinate& coordinate) const {
+
+        auto it = m_Chunks.find(coordinate);
+
+        return it != m_Chunks.end() ? it->second.get() : nullptr;
+    }
+
+    void World::SetStreamingSettings(const StreamingSettings& settings) {
+
+        BRQ_ASSERT(settings.UnloadRadius >= settings.LoadRadius);
+
+        m_Settings = settings;
+        m_LoadQueueDirty = true;
+
+        m_ChunkCache.SetBudget(m_Settings.ChunkCacheBudget);
+
+        UnloadChunks();
+        UpdateLods();
+    }
+
+    BlockType World::GetBlock(const glm::ivec3& position) const {
+
+        if (position.y < 0 || position.y >= CHUNK_HEIGHT)
+            return BlockType::Air;
+
+        ChunkCoordinate coordinate = ChunkCoordinate::FromBlock(position.x, position.z);
+        const Chunk* chunk = GetChunk(coordinate);
+
+        U32 x = (U32)(position.x - coordinate.X * CHUNK_WIDTH);
+        U32 z = (U32)(position.z - coordinate.Z * CHUNK_LENGTH);
+
+        if (!chunk) {
+
+            BlockType type = BlockType::Air;
+            m_ChunkCache.GetBlock(coordinate, x, (U32)position.y, z, type);
+
+            return type;
+        }
+
+        return chunk->GetBlockType(x, (U32)position.y, z);
+    }
+
+    bool World::SetBlock(const glm::ivec3& position, BlockType type) {
+
+        if (position.y < 0 || position.y >= CHUNK_HEIGHT)
+            return false;
+
+        ChunkCoordinate coordinate = ChunkCoordinate::FromBlock(position.x, position.z);
+        Chunk* chunk = GetChunk(coordinate);
+
+        if (!chunk)
+            return false;
+
+        I32 x = position.x - coordinate.X * CHUNK_WIDTH;
+        I32 z = position.z - coordinate.Z * CHUNK_LENGTH;
+
+        if (chunk->GetBlockType((U32)x, (U32)position.y, (U32)z) == type)
+            return true;
+
+        m_LightEdits.push_back({ position, chunk->GetBlockType((U32)x, (U32)position.y, (U32)z) });
+
+        chunk->SetBlock(type, glm::vec3(x, position.y, z));
+
+        ScheduleRemesh(coordinate, true);
+
+        // Faces and ambient occlusion of the neighbouring chunks along a border depend on this block too,
+        // in the same section and in the one next to it when the block is on a section boundary.
+        U32 sectionMask = 1u << ((U32)position.y / SECTION_HEIGHT);
+
+        if (position.y % SECTION_HEIGHT == 0)
+            sectionMask |= (sectionMask >> 1);
+        else if (position.y % SECTION_HEIGHT == SECTION_HEIGHT - 1)
+            sectionMask |= (sectionMask << 1) & SECTION_MASK;
+
+        I32 dx = x == 0 ? -1 : x == CHUNK_WIDTH - 1 ? 1 : 0;
+        I32 dz = z == 0 ? -1 : z == CHUNK_LENGTH - 1 ? 1 : 0;
+
+        if (dx)
+            MarkNeighbourSectionsDirty(coordinate, dx < 0 ? BlockFace::Left : BlockFace::Right, sectionMask, true);
+
+        if (dz)
+            MarkNeighbourSectionsDirty(coordinate, dz < 0 ? BlockFace::Back : BlockFace::Front, sectionMask, true);
+
+        if (dx && dz)
+            MarkCornerSectionsDirty(coordinate, dx, dz, sectionMask, true);
+
+        return true;
+    }
+
+    bool World::PlaceBlock(const glm::ivec3& position, BlockType type) {
+
+        if (GetBlock(position) != BlockType::Air)
+            return false;
+
+        return SetBlock(position, type);
+    }
+
+    bool World::Raycast(const glm::vec3& origin, const glm::vec3& direction, F32 maxDistance, RaycastHit& hit) const {
+
+        if (glm::dot(direction, direction) == 0.0f)
+            return false;
+
+        glm::vec3 ray = glm::normalize(direction);
+
+        // Work in block space where block b covers [b, b + 1).
+        glm::vec3 start = origin + 0.5f;
+        glm::ivec3 block = glm::ivec3(glm::floor(start));
+
+        glm::ivec3 step;
+        glm::vec3 next;
+        glm::vec3 delta;
+
+        for (U32 axis = 0; axis < 3; axis++) {
+
+            if (ray[axis] > 0.0f) {
+
+                step[axis] = 1;
+                delta[axis] = 1.0f / ray[axis];
+                next[axis] = ((F32)block[axis] + 1.0f - start[axis]) * delta[axis];
+            }
+            else if (ray[axis] < 0.0f) {
+
+                step[axis] = -1;
+                delta[axis] = -1.0f / ray[axis];
+                next[axis] = (start[axis] - (F32)block[axis]) * delta[axis];
+            }
+            else {
+
+                step[axis] = 0;
+                delta[axis] = std::numeric_limits<F32>::infinity();
+                next[axis] = std::numeric_limits<F32>::infinity();
+            }
+        }
+
+        // Entering a block through +X means its -X face was hit, and so on.
+        static const BlockFace entryFaces[3][2] = {
+
+            { BlockFace::Right,  BlockFace::Left   },
+            { BlockFace::Top,    BlockFace::Bottom },
+            { BlockFace::Front,  BlockFace::Back   },
+        };
+
+        ChunkCoordinate cachedCoordinate = ChunkCoordinate::FromBlock(block.x, block.z);
+        const Chunk* cachedChunk = GetChunk(cachedCoordinate);
+
+        while (true) {
+
+            U32 axis = next.x < next.y ? (next.x < next.z ? 0 : 2) : (next.y < next.z ? 1 : 2);
+            F32 distance = next[axis];
+
+            if (distance > maxDistance)
+                return false;
+
+            block[axis] += step[axis];
+            next[axis] += delta[axis];
+
+            // Nothing to hit once the ray has left the world vertically.
+            if ((block.y < 0 && step.y <= 0) || (block.y >= CHUNK_HEIGHT && step.y >= 0))
+                return false;
+
+            if (block.y < 0 || block.y >= CHUNK_HEIGHT)
+                continue;
+
+            ChunkCoordinate coordinate = ChunkCoordinate::FromBlock(block.x, block.z);
+
+            if (coordinate != cachedCoordinate) {
+
+                cachedCoordinate = coordinate;
+                cachedChunk = GetChunk(coordinate);
+            }
+
+            if (!cachedChunk)
+                continue;
+
+            U32 x = (U32)(block.x - coordinate.X * CHUNK_WIDTH);
+            U32 z = (U32)(block.z - coordinate.Z * CHUNK_LENGTH);
+
+            BlockType type = cachedChunk->GetBlockType(x, (U32)block.y, z);
+
+            if (type == BlockType::Air)
+                continue;
+
+            hit.Block = block;
+            hit.Adjacent = block;
+            hit.Adjacent[axis] -= step[axis];
+            hit.Face = entryFaces[axis][step[axis] > 0 ? 1 : 0];
+            hit.Type = type;
+            hit.Distance = distance;
+
+            return true;
+        }
+    }
+
+    glm::ivec3 World::ToBlockPosition(const glm::vec3& position) {
+
+        return glm::ivec3(glm::floor(position + 0.5f));
+    }
+
+    ChunkCoordinate World::ToChunkCoordinate(const glm::vec3& position) {
+
+        glm::ivec3 block = ToBlockPosition(position);
+
+        return ChunkCoordinate::FromBlock(block.x, block.z);
+    }
+
+    void World::UpdateCamera(const BRQ::Camera& camera) {
+
+        ChunkCoordinate cameraChunk = ToChunkCoordinate(camera.GetPosition());
+        m_CameraPosition = camera.GetPosition();
+
+        glm::vec2 direction(camera.GetFront().x, camera.GetFront().z);
+
+        // Looking straight up or down keeps the last horizontal direction.
+        if (glm::dot(direction, direction) > 0.0001f) {
+
+            direction = glm::normalize(direction);
+
+            if (glm::dot(direction, m_CameraDirection) < 0.9f) {
+
+                m_CameraDirection = direction;
+                m_LoadQueueDirty = true;
+            }
+        }
+
+        if (cameraChunk != m_CameraChunk) {
+
+            m_CameraChunk = cameraChunk;
+            m_LoadQueueDirty = true;
+
+            UnloadChunks();
+            UpdateLods();
+        }
+    }
+
+    void World::UnloadChunks() {
+
+        I32 unloadRadiusSquared = m_Settings.UnloadRadius * m_Settings.UnloadRadius;
+
+        for (auto it = m_Chunks.begin(); it != m_Chunks.end();) {
+
+            if (TerrainDistanceSquared(it->first, m_CameraChunk) <= unloadRadiusSquared) {
+
+                it++;
+                continue;
+            }
+
+            m_ChunkCache.Insert(*it->second);
+
+            m_RemeshScheduler.Remove(it->first);
+
+            RetireMeshes(*it->second);
+
+            it = m_Chunks.erase(it);
+        }
+    }
+
+    void World::UpdateLods() {
+
+        for (auto& [coordinate, chunk] : m_Chunks) {
+
+            // Ready chunks of the outer ring were skipped while it was outside the load radius.
+            if (!chunk->GetMeshRevision() && !chunk->IsMeshPending() && IsReadyToMesh(coordinate))
+                ScheduleRemesh(coordinate, false);
+
+            U32 lod = GetLod(coordinate);
+
+            if (lod == chunk->GetLod())
+                continue;
+
+            // The mesh of the old level stays until the new one is uploaded.
+            chunk->SetLod(lod);
+            chunk->MarkSectionsDirty(SECTION_MASK);
+
+            ScheduleRemesh(coordinate, false);
+        }
+    }
+
+    void World::GenerateChunks() {
+
+        ApplyGeneratedChunks();
+
+        if (m_LoadQueueDirty)
+            RebuildLoadQueue();
+
+        U32 maxInFlight = m_GenerationPool.GetThreadCount() * 2;
+
+        // Stops while the workers are busy instead of reading the same missing chunk from disk every frame.
+        for (U32 i = 0; i < m_Settings.GenerationsPerFrame && !m_LoadQueue.empty() && m_Generating.size() < maxInFlight; i++) {
+
+            ChunkCoordinate coordinate = m_LoadQueue.back();
+            m_LoadQueue.pop_back();
+
+            std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>();
+            chunk->SetCoordinate(coordinate);
+
+            // Chunks back from the cache keep their modified state, they may never have been saved.
+            if (m_ChunkCache.Take(*chunk)) {
+
+                AddChunk(std::move(chunk));
+            }
+            else if (m_Storage.LoadChunk(*chunk)) {
+
+                chunk->MarkSaved();
+                AddChunk(std::move(chunk));
+            }
+            else {
+
+                m_GenerationPool.Submit(coordinate);
+                m_Generating.insert(coordinate);
+            }
+        }
+    }
+
+    void World::ApplyGeneratedChunks() {
+
+        m_GenerationPool.PollCompleted(m_GeneratedChunks);
+
+        I32 unloadRadiusSquared = m_Settings.UnloadRadius * m_Settings.UnloadRadius;
+
+        for (GenerationResult& result : m_GeneratedChunks) {
+
+            m_Generating.erase(result.Coordinate);
+
+            // The camera moved away while the chunk was generated, keep it for when it comes back.
+            if (TerrainDistanceSquared(result.Coordinate, m_CameraChunk) > unloadRadiusSquared)
+                m_ChunkCache.Insert(*result.Generated);
+            else
+                AddChunk(std::move(result.Generated));
+        }
+
+        m_GeneratedChunks.clear();
+    }
+
+    void World::AddChunk(std::shared_ptr<Chunk>&& chunk) {
+
+        ChunkCoordinate coordinate = chunk->GetCoordinate();
+
+        chunk->SetLod(GetLod(coordinate));
+
+        m_Chunks.emplace(coordinate, std::move(chunk));
+
+        auto pending = m_PendingEdits.find(coordinate);
+
+        if (pending != m_PendingEdits.end()) {
+
+            std::vector<PopulationEdit> edits = std::move(pending->second);
+            m_PendingEdits.erase(pending);
+
+            for (const PopulationEdit& edit : edits)
+                ApplyPopulationEdit(edit);
+        }
+
+        PopulateAround(coordinate);
+
+        // Neighbours waiting on this chunk become meshable, meshed ones need their shared border redone.
+        ScheduleRemesh(coordinate, false);
+
+        for (U32 face = 0; face < 4; face++)
+            MarkNeighbourBorderDirty(coordinate, (BlockFace)face);
+    }
+
+    void World::PopulateAround(const ChunkCoordinate& coordinate) {
+
+        for (I32 z = -1; z <= 1; z++) {
+            for (I32 x = -1; x <= 1; x++) {
+
+                ChunkCoordinate neighbour = { coordinate.X + x, coordinate.Z + z };
+
+                if (IsReadyToPopulate(neighbour))
+                    Populate(*GetChunk(neighbour));
+            }
+        }
+
+        // Populating a chunk can complete the populated neighbourhood of every chunk around it.
+        for (I32 z = -2; z <= 2; z++) {
+            for (I32 x = -2; x <= 2; x++) {
+
+                ChunkCoordinate neighbour = { coordinate.X + x, coordinate.Z + z };
+
+                if (IsReadyToLight(neighbour) && std::find(m_LightQueue.begin(), m_LightQueue.end(), neighbour) == m_LightQueue.end())
+                    m_LightQueue.push_back(neighbour);
+            }
+        }
+    }
+
+    void World::Populate(Chunk& chunk) {
+
+        m_PopulationEdits.clear();
+        m_Populator.Populate(chunk, m_PopulationEdits);
+
+        chunk.MarkPopulated();
+
+        for (const PopulationEdit& edit : m_PopulationEdits)
+            ApplyPopulationEdit(edit);
+    }
+
+    void World::ApplyPopulationEdit(const PopulationEdit& edit) {
+
+        if (edit.Position.y < 0 || edit.Position.y >= CHUNK_HEIGHT)
+            return;
+
+        ChunkCoordinate coordinate = ChunkCoordinate::FromBlock(edit.Position.x, edit.Position.z);
+        Chunk* chunk = GetChunk(coordinate);
+
+        if (!chunk) {
+
+            m_PendingEdits[coordinate].push_back(edit);
+            return;
+        }
+
+        U32 x = (U32)(edit.Position.x - coordinate.X * CHUNK_WIDTH);
+        U32 z = (U32)(edit.Position.z - coordinate.Z * CHUNK_LENGTH);
+
+        if (!ChunkPopulator::CanReplace(chunk->GetBlockType(x, (U32)edit.Position.y, z), edit.Type))
+            return;
+
+        // Only features reaching further than one chunk can hit a lit chunk, those need relighting and remeshing like player edits.
+        if (chunk->IsLit())
+            SetBlock(edit.Position, edit.Type);
+        else
+            chunk->SetBlock(edit.Type, glm::vec3(x, edit.Position.y, z));
+    }
+
+    void World::ScheduleMeshing() {
+
+        U32 maxInFlight = m_MeshingPool.GetThreadCount() * 2;
+
+        if (m_MeshingJobsInFlight >= maxInFlight)
+            return;
+
+        U32 budget = std::min(m_Settings.MeshingJobsPerFrame, maxInFlight - m_MeshingJobsInFlight);
+
+        std::vector<ChunkCoordinate> coordinates;
+        m_RemeshScheduler.Take(m_CameraChunk, budget, coordinates);
+
+        for (const ChunkCoordinate& coordinate : coordinates) {
+
+            auto it = m_Chunks.find(coordinate);
+
+            // The last neighbour to load or be lit schedules waiting chunks again.
+            if (it == m_Chunks.end() || !IsReadyToMesh(coordinate))
+                continue;
+
+            // Changes made while a job is in flight are rescheduled when it completes.
+            if (it->second->IsMeshPending())
+                continue;
+
+            SubmitMeshing(it->second);
+        }
+    }
+
+    void World::UploadMeshes() {
+
+        U64 polled = m_ReadyMeshes.size();
+        m_MeshingPool.PollCompleted(m_ReadyMeshes);
+        m_MeshingJobsInFlight -= (U32)(m_ReadyMeshes.size() - polled);
+
+        U32 uploads = 0;
+        U64 consumed = 0;
+
+        for (; consumed < m_ReadyMeshes.size() && uploads < m_Settings.UploadsPerFrame; consumed++) {
+
+            MeshingResult& result = m_ReadyMeshes[consumed];
+            std::shared_ptr<Chunk> chunk = result.Owner.lock();
+
+            if (!chunk)
+                continue;
+
+            chunk->SetMeshPending(false);
+
+            if (chunk->IsDirty())
+                ScheduleRemesh(chunk->GetCoordinate(), false);
+
+            // Newer meshes of some sections may already be uploaded, SetMeshes only replaces older ones.
+            chunk->SetMeshes(result.SectionMeshes, result.Visibility, result.SectionMask, result.Revision, m_ReplacedMeshes);
+            RetireReplacedMeshes();
+
+            uploads++;
+        }
+
+        m_ReadyMeshes.erase(m_ReadyMeshes.begin(), m_ReadyMeshes.begin() + consumed);
+    }
+
+    void World::DestroyRetiredMeshes(bool all) {
+
+        U64 kept = 0;
+
+        for (RetiredMesh& retired : m_RetiredMeshes) {
+
+            if (all || m_Frame - retired.Frame > FRAME_LAG)
+                retired.Mesh.DestroyMesh();
+            else
+                m_RetiredMeshes[kept++] = retired;
+        }
+
+        m_RetiredMeshes.resize(kept);
+    }
+
+    void World::RemeshUrgentChunks() {
+
+        std::vector<ChunkCoordinate> coordinates;
+        m_RemeshScheduler.TakeUrgent(m_CameraChunk, m_Settings.SyncRemeshesPerFrame, coordinates);
+
+        for (const ChunkCoordinate& coordinate : coordinates) {
+
+            Chunk* chunk = GetChunk(coordinate);
+
+            if (!chunk || !IsReadyToMesh(coordinate))
+                continue;
+
+            // Chunks without a mesh yet are picked up by the meshing workers as usual, distant ones are always remeshed whole there.
+            if (!chunk->GetMeshRevision() || chunk->GetLod()) {
+
+                ScheduleRemesh(coordinate, false);
+                continue;
+            }
+
+            U32 revision = chunk->GetRevision();
+            U32 sectionMask = chunk->GetDirtySections();
+
+            chunk->Optimize(sectionMask);
+            chunk->ClearDirty();
+
+            // Meshing the few sections an edit touches takes well under a millisecond, doing it here keeps edits visible
+            // in the same frame. Sections a job still in flight covers carry an older revision and are dropped on completion.
+            BRQ::VoxelMeshData sectionMeshes[SECTION_COUNT];
+            ChunkMesher::Mesh(*chunk, sectionMask, MeshingMode::Greedy, GetNeighbours(coordinate), sectionMeshes);
+
+            U16 visibility[SECTION_COUNT];
+            SectionVisibility::Compute(*chunk, sectionMask, visibility);
+
+            chunk->SetMeshes(sectionMeshes, visibility, sectionMask, revision, m_ReplacedMeshes);
+            RetireReplacedMeshes();
+        }
+    }
+
+    void World::UpdateLighting() {
+
+        std::vector<LightingJob> completed;
+        m_LightingWorker.PollCompleted(completed);
+
+        for (LightingJob& job : completed) {
+
+            ApplyLighting(job);
+            m_LightingJobInFlight = false;
+        }
+
+        if (!m_LightingJobInFlight)
+            SubmitLighting();
+    }
+
+    void World::ApplyLighting(LightingJob& job) {
+
+        // Light from edits is remeshed right away like the edits themselves.
+        bool urgent = !job.Edits.empty();
+
+        for (LightChunk& lightChunk : job.Chunks) {
+
+            std::shared_ptr<Chunk> chunk = lightChunk.Owner.lock();
+
+            if (!chunk)
+                continue;
+
+            const ChunkCoordinate& coordinate = chunk->GetCoordinate();
+
+            chunk->CopyLight(lightChunk.Snapshot, lightChunk.ChangedSections);
+
+            // Chunks around a new chunk wait for it to be lit before they are meshed, the face neighbours are scheduled
+            // below through its border sections.
+            if (lightChunk.Initialize) {
+
+                chunk->SetLit(true);
+
+                for (U32 corner = 0; corner < 4; corner++)
+                    MarkCornerSectionsDirty(coordinate, s_CornerOffsets[corner][0], s_CornerOffsets[corner][1], SECTION_MASK, false);
+            }
+
+            if (lightChunk.RemeshSections) {
+
+                chunk->MarkSectionsDirty(lightChunk.RemeshSections);
+                ScheduleRemesh(coordinate, urgent);
+            }
+
+            for (U32 face = 0; face < 4; face++) {
+
+                if (lightChunk.BorderSections[face])
+                    MarkNeighbourSectionsDirty(coordinate, (BlockFace)face, lightChunk.BorderSections[face], urgent);
+            }
+        }
+    }
+
+    void World::SubmitLighting() {
+
+        if (m_LightQueue.empty() && m_LightEdits.empty())
+            return;
+
+        LightingJob job;
+        std::unordered_map<ChunkCoordinate, U64, ChunkCoordinateHash> indices;
+
+        auto addChunk = [&](const ChunkCoordinate& coordinate, bool initialize) {
+
+            auto it = m_Chunks.find(coordinate);
+
+            if (it == m_Chunks.end() || indices.count(coordinate) || (!initialize && !it->second->IsLit()))
+                return;
+
+            indices.emplace(coordinate, job.Chunks.size());
+
+            LightChunk& lightChunk = job.Chunks.emplace_back();
+            lightChunk.Owner = it->second;
+            lightChunk.Snapshot = *it->second;
+            lightChunk.Initialize = initialize;
+        };
+
+        // Light travels less than a chunk, lit chunks all around are enough for a new chunk or an edit to spread into.
+        auto addNeighbours = [&](const ChunkCoordinate& coordinate) {
+
+            for (I32 z = -1; z <= 1; z++)
+                for (I32 x = -1; x <= 1; x++)
+                    addChunk({ coordinate.X + x, coordinate.Z + z }, false);
+        };
+
+        // Nearest chunks are lit first, chunks unloaded while waiting are dropped.
+        std::erase_if(m_LightQueue, [this](const ChunkCoordinate& coordinate) {
+
+            const Chunk* chunk = GetChunk(coordinate);
+
+            return !chunk || chunk->IsLit();
+        });
+
+        U64 count = std::min<U64>(m_LightQueue.size(), m_Settings.LightingChunksPerJob);
+
+        std::partial_sort(m_LightQueue.begin(), m_LightQueue.begin() + count, m_LightQueue.end(), [this](const ChunkCoordinate& a, const ChunkCoordinate& b) {
+
+            return DistanceSquared(a, m_CameraChunk) < DistanceSquared(b, m_CameraChunk);
+        });
+
+        for (U64 i = 0; i < count; i++)
+            addChunk(m_LightQueue[i], true);
+
+        for (U64 i = 0; i < count; i++)
+            addNeighbours(m_LightQueue[i]);
+
+        m_LightQueue.erase(m_LightQueue.begin(), m_LightQueue.begin() + count);
+
+        job.Edits = std::move(m_LightEdits);
+        m_LightEdits.clear();
+
+        for (const LightEdit& edit : job.Edits)
+            addNeighbours(ChunkCoordinate::FromBlock(edit.Position.x, edit.Position.z));
+
+        if (job.Chunks.empty())
+            return;
+
+        m_LightingWorker.Submit(std::move(job));
+        m_LightingJobInFlight = true;
+    }
+
+    void World::ScheduleRemesh(const ChunkCoordinate& coordinate, bool urgent) {
+
+        m_RemeshScheduler.Schedule(coordinate, urgent);
+    }
+
+    void World::MarkNeighbourBorderDirty(const ChunkCoordinate& coordinate, BlockFace face) {
+
+        ChunkCoordinate neighbourCoordinate = { coordinate.X + s_NeighbourOffsets[(U32)face][0], coordinate.Z + s_NeighbourOffsets[(U32)face][1] };
+        Chunk* neighbour = GetChunk(neighbourCoordinate);
+
+        if (!neighbour)
+            return;
+
+        // Faces come in pairs, the neighbour sees this chunk across the opposite one.
+        if (neighbour->GetMeshRevision() || neighbour->IsMeshPending())
+            neighbour->MarkBorderDirty((BlockFace)((U32)face ^ 1));
+
+        ScheduleRemesh(neighbourCoordinate, false);
+    }
+
+    void World::MarkNeighbourSectionsDirty(const ChunkCoordinate& coordinate, BlockFace face, U32 sectionMask, bool urgent) {
+
+        ChunkCoordinate neighbourCoordinate = { coordinate.X + s_NeighbourOffsets[(U32)face][0], coordinate.Z + s_NeighbourOffsets[(U32)face][1] };
+        Chunk* neighbour = GetChunk(neighbourCoordinate);
+
+        if (!neighbour)
+            return;
+
+        neighbour->MarkSectionsDirty(sectionMask);
+
+        ScheduleRemesh(neighbourCoordinate, urgent);
+    }
+
+    void World::MarkCornerSectionsDirty(const ChunkCoordinate& coordinate, I32 dx, I32 dz, U32 sectionMask, bool urgent) {
+
+        ChunkCoordinate cornerCoordinate = { coordinate.X + dx, coordinate.Z + dz };
+        Chunk* corner = GetChunk(cornerCoordinate);
+
+        if (!corner)
+            return;
+
+        corner->MarkSectionsDirty(sectionMask);
+
+        ScheduleRemesh(cornerCoordinate, urgent);
+    }
+
+    void World::RetireMeshes(Chunk& chunk) {
+
+        chunk.ReleaseMeshes(m_ReplacedMeshes);
+        RetireReplacedMeshes();
+    }
+
+    void World::RetireReplacedMeshes() {
+
+        for (const BRQ::Mesh& mesh : m_ReplacedMeshes)
+            m_RetiredMeshes.push_back({ mesh, m_Frame });
+
+        m_ReplacedMeshes.clear();
+    }
+
+    void World::RebuildLoadQueue() {
+
+        m_LoadQueue.clear();
+        m_LoadQueueDirty = false;
+
+        I32 radius = m_Settings.LoadRadius;
+        I32 extent = radius + WORLD_TERRAIN_MARGIN;
+
+        for (I32 x = -extent; x <= extent; x++) {
+            for (I32 z = -extent; z <= extent; z++) {
+
+                ChunkCoordinate coordinate = { m_CameraChunk.X + x, m_CameraChunk.Z + z };
+
+                if (TerrainDistanceSquared(coordinate, m_CameraChunk) > radius * radius || m_Chunks.count(coordinate) || m_Generating.count(coordinate))
+                    continue;
+
+                m_LoadQueue.push_back(coordinate);
+            }
+        }
+
+        std::sort(m_LoadQueue.begin(), m_LoadQueue.end(), [this](const ChunkCoordinate& a, const ChunkCoordinate& b) {
+
+            return GetPriority(a) > GetPriority(b);
+        });
+    }
+
+    F32 World::GetPriority(const ChunkCoordinate& coordinate) const {
+
+        glm::vec2 offset((F32)(coordinate.X - m_CameraChunk.X), (F32)(coordinate.Z - m_CameraChunk.Z));
+        F32 distance = glm::length(offset);
+
+        if (distance < 1.0f)
+            return 0.0f;
+
+        // Lower is sooner, chunks behind the camera count as up to twice as far away.
+        F32 facing = glm::dot(offset / distance, m_CameraDirection);
+
+        return distance * (1.5f - 0.5f * facing);
+    }
+
+    U32 World::GetLod(const ChunkCoordinate& coordinate) const {
+
+        I32 distanceSquared = DistanceSquared(coordinate, m_CameraChunk);
+        U32 lod = 0;
+
+        while (lod < LOD_COUNT - 1 && distanceSquared > m_Settings.LodDistances[lod] * m_Settings.LodDistances[lod])
+            lod++;
+
+        return lod;
+    }
+
+    bool World::IsReadyToPopulate(const ChunkCoordinate& coordinate) const {
+
+        const Chunk* chunk = GetChunk(coordinate);
+
+        if (!chunk || chunk->IsPopulated())
+            return false;
+
+        for (I32 z = -1; z <= 1; z++) {
+            for (I32 x = -1; x <= 1; x++) {
+
+                if (!GetChunk({ coordinate.X + x, coordinate.Z + z }))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool World::IsReadyToLight(const ChunkCoordinate& coordinate) const {
+
+        const Chunk* chunk = GetChunk(coordinate);
+
+        if (!chunk || chunk->IsLit())
+            return false;
+
+        for (I32 z = -1; z <= 1; z++) {
+            for (I32 x = -1; x <= 1; x++) {
+
+                const Chunk* neighbour = GetChunk({ coordinate.X + x, coordinate.Z + z });
+
+                if (!neighbour || !neighbour->IsPopulated())
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool World::IsReadyToMesh(const ChunkCoordinate& coordinate) const {
+
+        const Chunk* chunk = GetChunk(coordinate);
+
+        if (!chunk || !chunk->IsLit())
+            return false;
+
+        // The outer ring only holds terrain for the chunks inside, chunks meshed before the camera moved away keep remeshing.
+        if (!chunk->GetMeshRevision() && DistanceSquared(coordinate, m_CameraChunk) > m_Settings.LoadRadius * m_Settings.LoadRadius)
+            return false;
+
+        for (U32 face = 0; face < 6; face++) {
+
+            if (!s_NeighbourOffsets[face][0] && !s_NeighbourOffsets[face][1])
+                continue;
+
+            const Chunk* neighbour = GetChunk({ coordinate.X + s_NeighbourOffsets[face][0], coordinate.Z + s_NeighbourOffsets[face][1] });
+
+            if (!neighbour || !neighbour->IsLit())
+                return false;
+        }
+
+        for (U32 corner = 0; corner < 4; corner++) {
+
+            const Chunk* neighbour = GetChunk({ coordinate.X + s_CornerOffsets[corner][0], coordinate.Z + s_CornerOffsets[corner][1] });
+
+            if (!neighbour || !neighbour->IsLit())
+                return false;
+        }
+
+        return true;
+    }
+
+    ChunkNeighbours World::GetNeighbours(const ChunkCoordinate& coordinate) const {
+
+        ChunkNeighbours neighbours;
+
+        for (U32 face = 0; face < 6; face++) {
+
+            if (s_NeighbourOffsets[face][0] || s_NeighbourOffsets[face][1])
+                neighbours.Chunks[face] = GetChunk({ coordinate.X + s_NeighbourOffsets[face][0], coordinate.Z + s_NeighbourOffsets[face][1] });
+        }
+
+        for (U32 corner = 0; corner < 4; corner++)
+            neighbours.Corners[corner] = GetChunk({ coordinate.X + s_CornerOffsets[corner][0], coordinate.Z + s_CornerOffsets[corner][1] });
+
+        return neighbours;
+    }
+
+    void World::SubmitMeshing(const std::shared_ptr<Chunk>& chunk) {
+
+        MeshingJob job;
+        job.Owner = chunk;
+        job.Coordinate = chunk->GetCoordinate();
+        job.Revision = chunk->GetRevision();
+        job.SectionMask = chunk->GetDirtySections();
+        job.Lod = chunk->GetLod();
+
+        // Downsampled cells and skirts span sections, a coarse mesh is rebuilt whole.
+        if (job.Lod)
+            job.SectionMask = SECTION_MASK;
+
+        chunk->Optimize(job.SectionMask);
+        chunk->ClearDirty();
+
+        job.Center = *chunk;
+
+        for (U32 face = 0; face < 6; face++) {
+
+            if (!s_NeighbourOffsets[face][0] && !s_NeighbourOffsets[face][1])
+                continue;
+
+            const Chunk* neighbour = GetChunk({ job.Coordinate.X + s_NeighbourOffsets[face][0], job.Coordinate.Z + s_NeighbourOffsets[face][1] });
+
+            if (neighbour) {
+
+                job.Neighbours[face] = *neighbour;
+                job.HasNeighbour[face] = true;
+            }
+        }
+
+        for (U32 corner = 0; corner < 4; corner++) {
+
+            const Chunk* neighbour = GetChunk({ job.Coordinate.X + s_CornerOffsets[corner][0], job.Coordinate.Z + s_CornerOffsets[corner][1] });
+
+            if (neighbour) {
+
+                job.Corners[corner] = *neighbour;
+                job.HasCorner[corner] = true;
+            }
+        }
+
+        chunk->SetMeshPending(true);
+        m_MeshingJobsInFlight++;
+
+        m_MeshingPool.Submit(std::move(job));
+    }
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "WorldConfig.h"
+#include "Chunks/Chunk.h"
+#include "Meshing/MeshingWorkerPool.h"
+#include "Meshing/RemeshScheduler.h"
+#include "Culling/OcclusionCuller.h"
+#include "Lighting/LightingWorker.h"
+#include "Generation/TerrainGenerator.h"
+#include "Generation/GenerationWorkerPool.h"
+#include "Generation/ChunkPopulator.h"
+#include "Storage/RegionStorage.h"
+#include "Storage/ChunkCache.h"
+
+namespace MC {
+
+    struct StreamingSettings {
+
+        // Chunks within LoadRadius of the camera chunk are meshed and stay until they leave UnloadRadius. Terrain loads
+        // WORLD_TERRAIN_MARGIN chunks further on both axes, see TerrainDistanceSquared.
+        I32 LoadRadius           = WORLD_LOAD_RADIUS;
+        I32 UnloadRadius         = WORLD_UNLOAD_RADIUS;
+
+        // Chunks taken from the load queue per frame, cached and saved chunks load right away, the rest go to the
+        // generation workers.
+        U32 GenerationsPerFrame  = 16;
+        U32 MeshingJobsPerFrame  = 8;
+        U32 UploadsPerFrame      = 8;
+        // Edited chunks meshed on the main thread so the edit shows up in the same frame.
+        U32 SyncRemeshesPerFrame = 8;
+        // New chunks lit from scratch by one lighting job, edits are always taken all at once.
+        U32 LightingChunksPerJob = 16;
+        // Chunks further than LodDistances[i] are meshed at level i + 1. Each level halves the resolution as the distance
+        // doubles, so every ring costs about as many triangles as the full detail disc.
+        I32 LodDistances[LOD_COUNT - 1] = { LOD_DISTANCE, LOD_DISTANCE * 2, LOD_DISTANCE * 4 };
+        // Bytes of compressed blocks kept for chunks past UnloadRadius, see ChunkCache.
+        U64 ChunkCacheBudget     = CHUNK_CACHE_BUDGET;
+    };
+
+    struct RaycastHit {
+
+        glm::ivec3 Block;
+        // Empty cell in front of the hit face, where a placed block goes.
+        glm::ivec3 Adjacent;
+        BlockFace  Face;
+        BlockType  Type;
+        F32        Distance;
+    };
+
+    class World {
+
+    private:
+        using ChunkMap = std::unordered_map<ChunkCoordinate, std::shared_ptr<Chunk>, ChunkCoordinateHash>;
+        using ChunkSet = std::unordered_set<ChunkCoordinate, ChunkCoordinateHash>;
+        using EditMap  = std::unordered_map<ChunkCoordinate, std::vector<PopulationEdit>, ChunkCoordinateHash>;
+
+        struct RetiredMesh {
+
+            BRQ::Mesh Mesh;
+            U64       Frame;
+        };
+
+        ChunkMap                     m_Chunks;
+        TerrainGenerator             m_Generator;
+        GenerationWorkerPool         m_GenerationPool;
+        // Chunks handed to the generation workers and not applied yet.
+        ChunkSet                     m_Generating;
+        std::vector<GenerationResult> m_GeneratedChunks;
+
+        // Chunks are populated once their 8 neighbours are loaded and lit once their 8 neighbours are populated,
+        // so features never land in lit or meshed chunks.
+        ChunkPopulator               m_Populator;
+        std::vector<PopulationEdit>  m_PopulationEdits;
+        // Feature blocks for chunks that weren't loaded when their neighbour was populated, placed when they load.
+        EditMap                      m_PendingEdits;
+
+        StreamingSettings            m_Settings;
+
+        RegionStorage                m_Storage;
+        // Unloaded chunks, compressed, before they go to m_Storage. Reads through GetBlock keep them warm.
+        mutable ChunkCache           m_ChunkCache;
+        BRQ::Timer                   m_AutosaveTimer;
+
+        MeshingWorkerPool            m_MeshingPool;
+        std::vector<MeshingResult>   m_ReadyMeshes;
+        U32                          m_MeshingJobsInFlight;
+
+        // Missing chunks inside the load radius, best candidate last.
+        std::vector<ChunkCoordinate> m_LoadQueue;
+        ChunkCoordinate              m_CameraChunk;
+        glm::vec3                    m_CameraPosition;
+        glm::vec2                    m_CameraDirection;
+        bool                         m_LoadQueueDirty;
+
+        // Dirty chunks, coalesced so each is remeshed at most once per frame.
+        RemeshScheduler              m_RemeshScheduler;
+
+        // Chunks waiting for their first light and block edits since the last lighting job was built.
+        // Chunks are meshed once they and their horizontal neighbours are lit.
+        LightingWorker               m_LightingWorker;
+        std::vector<ChunkCoordinate> m_LightQueue;
+        std::vector<LightEdit>       m_LightEdits;
+        bool                         m_LightingJobInFlight;
+
+        // Meshes of unloaded chunks may still be read by frames in flight.
+        std::vector<RetiredMesh>     m_RetiredMeshes;
+        std::vector<BRQ::Mesh>       m_ReplacedMeshes;
+        U64                          m_Frame;
+
+        // Sections reachable from the camera and their meshes handed to the renderer for frustum culling,
+        // rebuilt every frame without reallocating.
+        mutable OcclusionCuller             m_OcclusionCuller;
+        mutable std::vector<VisibleSection> m_VisibleSections;
+        mutable BRQ::VoxelDrawList          m_DrawList;
+
+    public:
+        World();
+        ~World() = default;
+
+        void Init(const StreamingSettings& settings = StreamingSettings(), const std::string& saveDirectory = WORLD_SAVE_DIRECTORY);
+        // Saves every modified chunk before releasing the world.
+        void Shutdown();
+
+        // Queues every modified chunk for the background writer.
+        void Save();
+
+        // Streams chunks around the camera, each stage limited by its per-frame budget in StreamingSettings.
+        void Update(const BRQ::Camera& camera);
+        void Render(BRQ::Renderer* renderer) const;
+
+        Chunk* GetChunk(const ChunkCoordinate& coordinate);
+        const Chunk* GetChunk(const ChunkCoordinate& coordinate) const;
+
+        U64 GetLoadedChunkCount() const { return m_Chunks.size(); }
+
+        // Block positions are in world blocks, block b covers [b - 0.5, b + 0.5] in world space.
+        // Unloaded chunks and heights outside the world read as air.
+        BlockType GetBlock(const glm::ivec3& position) const;
+        // Returns false when the chunk is not loaded or the position is outside the world.
+        bool SetBlock(const glm::ivec3& position, BlockType type);
+
+        bool BreakBlock(const glm::ivec3& position) { return SetBlock(position, BlockType::Air); }
+        bool PlaceBlock(const glm::ivec3& position, BlockType type);
+
+        // Walks the block grid along the ray (Amanatides & Woo) and reports the first solid block
+        // within maxDistance. The block containing the origin is skipped.
+        bool Raycast(const glm::vec3& origin, const glm::vec3& direction, F32 maxDistance, RaycastHit& hit) const;
+
+        void SetStreamingSettings(const StreamingSettings& settings);
+        const StreamingSettings& GetStreamingSettings() const { return m_Settings; }
+
+        static glm::ivec3 ToBlockPosition(const glm::vec3& position);
+        static ChunkCoordinate ToChunkCoordinate(const glm::vec3& position);
+
+    private:
+        void UpdateCamera(const BRQ::Camera& camera);
+        void UnloadChunks();
+        // Remeshes chunks whose level of detail changed with the camera chunk and meshes the ones that came within the load radius.
+        void UpdateLods();
+        void GenerateChunks();
+        void ApplyGeneratedChunks();
+        // Adds a chunk that just finished loading or generating and wakes its neighbours.
+        void AddChunk(std::shared_ptr<Chunk>&& chunk);
+        // Populates the chunks around coordinate that just got all their neighbours and queues the ones around
+        // them that became ready to light.
+        void PopulateAround(const ChunkCoordinate& coordinate);
+        void Populate(Chunk& chunk);
+        void ApplyPopulationEdit(const PopulationEdit& edit);
+        bool IsReadyToPopulate(const ChunkCoordinate& coordinate) const;
+        bool IsReadyToLight(const ChunkCoordinate& coordinate) const;
+        void ScheduleMeshing();
+        void UploadMeshes();
+        void DestroyRetiredMeshes(bool all);
+        void RemeshUrgentChunks();
+        void UpdateLighting();
+
+        void ApplyLighting(LightingJob& job);
+        void SubmitLighting();
+
+        void ScheduleRemesh(const ChunkCoordinate& coordinate, bool urgent);
+        // Tells the neighbour across face of coordinate that their whole shared border changed.
+        void MarkNeighbourBorderDirty(const ChunkCoordinate& coordinate, BlockFace face);
+        // An edit or new light on the border changed some sections of the neighbour across face.
+        void MarkNeighbourSectionsDirty(const ChunkCoordinate& coordinate, BlockFace face, U32 sectionMask, bool urgent);
+
+        // Edits on a chunk corner change the ambient occlusion of the diagonal chunk's corner column.
+        void MarkCornerSectionsDirty(const ChunkCoordinate& coordinate, I32 dx, I32 dz, U32 sectionMask, bool urgent);
+
+        // Meshes leave the chunks right away but are destroyed only once no frame in flight can read them.
+        void RetireMeshes(Chunk& chunk);
+        void RetireReplacedMeshes();
+
+        void RebuildLoadQueue();
+        F32 GetPriority(const ChunkCoordinate& coordinate) const;
+        U32 GetLod(const ChunkCoordinate& coordinate) const;
+        // The chunk and the 8 chunks around it are loaded and lit, so its borders are meshed once against final data.
+        // Chunks past the load radius are never meshed for the first time.
+        bool IsReadyToMesh(const ChunkCoordinate& coordinate) const;
+
+        ChunkNeighbours GetNeighbours(const ChunkCoordinate& coordinate) const;
+        void SubmitMeshing(const std::shared_ptr<Chunk>& chunk);
+    };
+}
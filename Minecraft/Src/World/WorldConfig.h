@@ -2,11 +2,32 @@
 
 #define CHUNK_WIDTH     16      // X axis
 #define CHUNK_LENGTH    16      // Z axis
-#define CHUNK_HEIGHT    16      // Y axis
+#define CHUNK_HEIGHT    256     // Y axis
 
 #define CHUNK_SIZE      CHUNK_WIDTH * CHUNK_LENGTH * CHUNK_HEIGHT
 
-#define WORLD_LENGTH    5       // CHUNKS
-#define WORLD_WIDTH     5       // CHUNKS
+// Chunks are columns of independently stored and meshed sections.
+#define SECTION_HEIGHT  16      // Y axis
+#define SECTION_COUNT   (CHUNK_HEIGHT / SECTION_HEIGHT)
+#define SECTION_SIZE    (CHUNK_WIDTH * CHUNK_LENGTH * SECTION_HEIGHT)
+#define SECTION_MASK    (U32)((1ULL << SECTION_COUNT) - 1)   // Every section of a chunk
+
+#define LIGHT_MAX       15      // Brightest sky or block light, light fades one level per block
+
+#define WORLD_LOAD_RADIUS   12  // CHUNKS
+#define WORLD_UNLOAD_RADIUS 14  // CHUNKS
+#define WORLD_TERRAIN_MARGIN 3  // CHUNKS loaded around meshed ones, populating, lighting and meshing each wait for the 3x3 chunks around
+#define CHUNK_CACHE_BUDGET  (64ULL << 20)   // BYTES of compressed unloaded chunks kept in memory
+#define CHUNK_CACHE_DECODED 32              // SECTIONS of cached chunks kept decompressed for block reads, two whole chunks
+
+#define LOD_COUNT       4       // Full detail and meshes from 2x, 4x and 8x downsampled blocks
+#define LOD_DISTANCE    6       // CHUNKS of full detail, every further level starts twice as far as the last
+
+#define WORLD_SEED      1337
+
+#define WORLD_SAVE_DIRECTORY        "Saves/World/"
+#define WORLD_AUTOSAVE_INTERVAL     30.0f   // SECONDS
+
+#define REGION_SIZE     32      // CHUNKS per side of a region file
 
 #define BLOCK_SIZE      0.5f